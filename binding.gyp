@@ -9,12 +9,16 @@
 				"src/utils/typed_array.cpp",
 				"src/utils/string_list.cpp",
 				"src/utils/number_list.cpp",
+				"src/utils/flat_coordinates.cpp",
+				"src/utils/strtree.cpp",
 				"src/utils/warp_options.cpp",
 				"src/utils/ptr_manager.cpp",
 				"src/node_gdal.cpp",
 				"src/async.cpp",
 				"src/gdal_common.cpp",
 				"src/gdal_dataset.cpp",
+				"src/gdal_dataset_cache.cpp",
+				"src/gdal_block_cache.cpp",
 				"src/gdal_driver.cpp",
 				"src/gdal_rasterband.cpp",
 				"src/gdal_group.cpp",
@@ -23,6 +27,7 @@
 				"src/gdal_attribute.cpp",
 				"src/gdal_majorobject.cpp",
 				"src/gdal_feature.cpp",
+				"src/gdal_feature_cursor.cpp",
 				"src/gdal_feature_defn.cpp",
 				"src/gdal_field_defn.cpp",
 				"src/geometry/gdal_geometry.cpp",
@@ -38,12 +43,18 @@
 				"src/geometry/gdal_multilinestring.cpp",
 				"src/geometry/gdal_multicurve.cpp",
 				"src/geometry/gdal_multipolygon.cpp",
+				"src/geometry/gdal_prepared_geometry.cpp",
 				"src/gdal_layer.cpp",
 				"src/gdal_coordinate_transformation.cpp",
+				"src/gdal_spatial_index.cpp",
 				"src/gdal_spatial_reference.cpp",
+				"src/gdal_srs_cache.cpp",
 				"src/gdal_warper.cpp",
+				"src/gdal_utils.cpp",
 				"src/gdal_algorithms.cpp",
 				"src/gdal_memfile.cpp",
+				"src/gdal_vsinode.cpp",
+				"src/gdal_vsistats.cpp",
 				"src/collections/dataset_bands.cpp",
 				"src/collections/dataset_layers.cpp",
 				"src/collections/layer_features.cpp",
@@ -13,6 +13,7 @@
 				"./gdal/apps/gdalbuildvrt_lib.cpp",
         "./gdal/apps/gdal_translate_lib.cpp",
         "./gdal/apps/gdalwarp_lib.cpp",
+				"./gdal/apps/gdaldem_lib.cpp",
 				"./gdal/apps/commonutils.cpp",
 				"./gdal/frmts/gdalallregister.cpp",
 				"./gdal/frmts/derived/deriveddataset.cpp",
@@ -1,5 +1,6 @@
 const path = require('path')
 const fs = require('fs')
+const { Readable } = require('stream')
 const binary = require('@mapbox/node-pre-gyp')
 
 const binding_path = binary.find(path.join(__dirname, '../package.json'))
@@ -336,6 +337,84 @@ gdal.LayerFeatures.prototype[Symbol.iterator] = function defaultIterator() {
   }
 }
 
+/**
+ * @typedef SQLStreamOptions { dialect?: string, batchSize?: number }
+ */
+
+/**
+ * Executes an SQL statement against the data store and streams the results.
+ *
+ * The features are read in batches of `batchSize` in a background thread.
+ * The result set is released as soon as the stream ends or is destroyed,
+ * without waiting for the garbage collector.
+ *
+ * Returns a `stream.Readable` in object mode that can also be used as an async iterator.
+ *
+ * @example
+ * ```
+ * for await (const feature of ds.executeSQLStream('SELECT name FROM layer')) {
+ *   console.log(feature.fields.get('name'));
+ * }```
+ *
+ * @for gdal.Dataset
+ * @method executeSQLStream
+ * @param {string} statement SQL statement to execute.
+ * @param {SQLStreamOptions} [options] options
+ * @param {string} [options.dialect=null] SQL dialect, see `executeSQL()`
+ * @param {number} [options.batchSize=1024] number of features to read at once
+ * @return {NodeJS.ReadableStream}
+ */
+gdal.Dataset.prototype.executeSQLStream = function (statement, options) {
+  const ds = this
+  const dialect = options && options.dialect ? options.dialect : null
+  const batchSize = options && options.batchSize ? options.batchSize : 1024
+  let layer = null
+  let pending = Promise.resolve()
+
+  return new Readable({
+    objectMode: true,
+    highWaterMark: batchSize,
+    autoDestroy: true,
+    read() {
+      pending = (layer ? Promise.resolve(layer) : ds.executeSQLAsync(statement, null, dialect).then((r) => (layer = r)))
+        .then((l) => l.features._nextBatchAsync(batchSize))
+        .then((features) => {
+          if (features.length === 0) {
+            this.push(null)
+            return
+          }
+          for (const f of features) this.push(f)
+        })
+        .catch((e) => this.destroy(e))
+    },
+    destroy(err, cb) {
+      // The result set cannot be released while a batch is being read
+      pending.catch(() => undefined).then(() => {
+        if (!layer) return
+        const l = layer
+        layer = null
+        // The result set is already gone if the dataset has been closed
+        return ds.releaseResultSetAsync(l).catch(() => undefined)
+      }).then(() => cb(err))
+    }
+  })
+}
+
+// Explicit resource management, `using ds = gdal.open(...)` closes ds at the end of the block
+// and `await using` closes it with closeAsync(), nothing happens if it is already closed
+// (not documented with yuidoc as the TypeScript version of the project does not know these symbols)
+if (Symbol.dispose) {
+  gdal.Dataset.prototype[Symbol.dispose] = function () {
+    if (this._alive) this.close()
+  }
+}
+
+if (Symbol.asyncDispose) {
+  gdal.Dataset.prototype[Symbol.asyncDispose] = function () {
+    return this._alive ? this.closeAsync() : Promise.resolve()
+  }
+}
+
 /**
  * Iterates through all fields using a callback function.
  *
@@ -1523,11 +1602,22 @@ const promisifiables = {
   },
   Dataset: {
     flushAsync: 0,
+    dropCacheAsync: 0,
+    closeAsync: 0,
     buildOverviewsAsync: 4,
-    executeSQLAsync: 3
+    executeSQLAsync: 3,
+    releaseResultSetAsync: 1
   },
   Layer: {
-    flushAsync: 0
+    flushAsync: 0,
+    intersectionAsync: 4,
+    unionAsync: 4,
+    symDifferenceAsync: 4,
+    identityAsync: 4,
+    updateAsync: 4,
+    clipAsync: 4,
+    eraseAsync: 4,
+    dissolveAsync: 1
   },
   RasterBand: {
     flushAsync: 0,
@@ -1540,7 +1630,8 @@ const promisifiables = {
     readBlockAsync: 3,
     writeBlockAsync: 3,
     getAsync: 2,
-    setAsync: 3
+    setAsync: 3,
+    adviseReadAsync: 5
   },
   DatasetLayers: {
     getAsync: 1,
@@ -1551,23 +1642,31 @@ const promisifiables = {
   },
   LayerFeatures: {
     getAsync: 1,
+    getManyAsync: 1,
+    pageAsync: 2,
     setAsync: 2,
     firstAsync: 0,
     nextAsync: 0,
+    _nextBatchAsync: 1,
     addAsync: 1,
     countAsync: 1,
     removeAsync: 1
   },
+  FeatureCursor: {
+    advanceAsync: 0
+  },
   DatasetBands: {
     getAsync: 1,
     createAsync: 2,
-    countAsync: 0
+    countAsync: 0,
+    adviseReadAsync: 1
   },
   Geometry: {
     $fromWKTAsync: 2,
     $fromWKBAsync: 2,
     $fromGeoJsonAsync: 1,
     $fromGeoJsonBufferAsync: 1,
+    $batchAsync: 4,
     toKMLAsync: 0,
     toGMLAsync: 0,
     toWKTAsync: 0,
@@ -1606,6 +1705,23 @@ const promisifiables = {
     transformAsync: 1,
     transformToAsync: 1
   },
+  PreparedGeometry: {
+    intersectsManyAsync: 2,
+    containsManyAsync: 2,
+    containsProperlyManyAsync: 2,
+    coversManyAsync: 2,
+    withinManyAsync: 2
+  },
+  CoordinateTransformation: {
+    transformPointsAsync: 4,
+    transformPointsInterleavedAsync: 2
+  },
+  SpatialIndex: {
+    $fromGeometriesAsync: 1,
+    $fromLayerAsync: 1,
+    intersectingAsync: 1,
+    nearestAsync: 2
+  },
   MDArray: {
     readAsync: 1
   },
@@ -1621,8 +1737,17 @@ const promisifiables = {
     $sieveFilterAsync: 1,
     $checksumImageAsync: 5,
     $polygonizeAsync: 1,
+    $rasterizeAsync: 1,
+    $spatialJoinAsync: 3,
     $reprojectImageAsync: 1,
     $suggestedWarpOutputAsync: 1,
+    $renderTileAsync: 2,
+    $translateAsync: 4,
+    $vectorTranslateAsync: 4,
+    $warpAsync: 5,
+    $buildVRTAsync: 4,
+    $demProcessingAsync: 5,
+    $openCachedAsync: 3,
     $_acquireLocksAsync: 3
   }
 }
@@ -19,9 +19,8 @@ int ProgressTrampoline(double dfComplete, const char *pszMessage, void *pProgres
   GDALExecutionProgress *context = (GDALExecutionProgress *)pProgressArg;
   // The dispatcher in async.hpp will delete it
   GDALProgressInfo *info = new GDALProgressInfo(dfComplete, pszMessage);
-  // Go to the dispatcher
-  context->Send(info);
-  return 1;
+  // Go to the dispatcher, it returns false when the JS callback requested an interruption
+  return context->Send(info) ? 1 : 0;
 }
 
 // From async.hpp:
@@ -29,9 +28,12 @@ int ProgressTrampoline(double dfComplete, const char *pszMessage, void *pProgres
 // typedef GDALAsyncProgressWorker::ExecutionProgress GDALAsyncExecutionProgress;
 // GDALAsyncExecutionProgress is an instance of a NAN templated class, in this case
 // the AsyncWorker is the final owner of the progress_callback
-GDALExecutionProgress::GDALExecutionProgress(const GDALAsyncExecutionProgress *async) : async(async), sync(nullptr) {
+GDALExecutionProgress::GDALExecutionProgress(
+  const GDALAsyncExecutionProgress *async, const std::atomic<bool> *cancelled)
+  : async(async), sync(nullptr), cancelled(cancelled) {
 }
-GDALExecutionProgress::GDALExecutionProgress(const GDALSyncExecutionProgress *sync) : async(nullptr), sync(sync) {
+GDALExecutionProgress::GDALExecutionProgress(const GDALSyncExecutionProgress *sync)
+  : async(nullptr), sync(sync), cancelled(nullptr) {
 }
 
 GDALExecutionProgress::~GDALExecutionProgress() {
@@ -40,16 +42,22 @@ GDALExecutionProgress::~GDALExecutionProgress() {
 }
 
 // sync/async dispatcher
-void GDALExecutionProgress::Send(GDALProgressInfo *info) const {
+bool GDALExecutionProgress::Send(GDALProgressInfo *info) const {
+  bool r = true;
   // async mode -> we are in an aux thread, we can't go back to JS
   // we must enqueue a job on the event loop and wait for the JS world to stop
   // the enqueuing is in Nan::AsyncWorker, then once the JS world is not running
   // AsyncWorker::HandleProgressCallback will get invoked on the main thread
-  if (async) async->Send(info, 1);
+  // the JS callback runs later, so its verdict applies to the next call
+  if (async) {
+    async->Send(info, 1);
+    if (cancelled != nullptr && *cancelled) r = false;
+  }
   // sync mode -> the JS world is not running, we can go back directly
   // this code is below
-  if (sync) sync->Send(info);
+  if (sync) r = sync->Send(info);
   delete info;
+  return r;
 }
 
 // This is the sync execution context, it is the final owner of the progress_callback
@@ -59,10 +67,12 @@ GDALSyncExecutionProgress::~GDALSyncExecutionProgress() {
 };
 
 // Going back to JS in sync mode
-void GDALSyncExecutionProgress::Send(GDALProgressInfo *info) const {
+bool GDALSyncExecutionProgress::Send(GDALProgressInfo *info) const {
   Nan::HandleScope scope;
   v8::Local<v8::Value> argv[] = {Nan::New<Number>(info->complete), SafeString::New(info->message)};
-  Nan::Call(progress_callback->GetFunction(), Nan::GetCurrentContext()->Global(), 2, argv);
+  Nan::MaybeLocal<v8::Value> r =
+    Nan::Call(progress_callback->GetFunction(), Nan::GetCurrentContext()->Global(), 2, argv);
+  return r.IsEmpty() || !r.ToLocalChecked()->IsFalse();
 }
 
 } // namespace node_gdal
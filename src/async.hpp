@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <chrono>
+#include <atomic>
 #include "nan-wrapper.h"
 #include "gdal_common.hpp"
 
@@ -77,11 +78,21 @@ namespace node_gdal {
     return;                                                                                                            \
   }
 
+// Same for a Dataset, with the event loop warning
+#define GDAL_LOCK_DATASET(ds)                                                                                          \
+  AsyncGuard lock;                                                                                                     \
+  try {                                                                                                                \
+    lock.acquire({(ds)->uid}, eventLoopWarn);                                                                          \
+  } catch (const char *err) {                                                                                          \
+    Nan::ThrowError(err);                                                                                              \
+    return;                                                                                                            \
+  }
+
 static const char eventLoopWarning[] =
   "Synchronous method called while an asynchronous operation is running in the background, check node_modules/gdal-async/ASYNCIO.md, event loop blocked for ";
 // These constructors throw
-// Only one use case never throws: on the main thread
-// and after checking that the Dataset is alive
+// On the main thread, they throw when the Dataset is not alive
+// or when waiting for it could deadlock with a /vsinode/ callback
 class AsyncGuard {
     public:
   inline AsyncGuard() : lock(nullptr), locks(nullptr) {
@@ -96,6 +107,14 @@ class AsyncGuard {
       locks = make_shared<vector<AsyncLock>>(object_store.lockDatasets(uids));
   }
   inline AsyncGuard(vector<long> uids, bool warning) : lock(nullptr), locks(nullptr) {
+    acquire(uids, warning);
+  }
+  inline void acquire(long uid) {
+    if (lock != nullptr) throw "Trying to acquire multiple locks";
+    lock = object_store.lockDataset(uid);
+  }
+  inline void acquire(vector<long> uids, bool warning) {
+    if (lock != nullptr || locks != nullptr) throw "Trying to acquire multiple locks";
     if (uids.size() == 1) {
       if (uids[0] == 0) return;
       lock = warning ? object_store.tryLockDataset(uids[0]) : object_store.lockDataset(uids[0]);
@@ -115,6 +134,7 @@ class AsyncGuard {
       if (locks->size() == 0) {
         auto start = std::chrono::high_resolution_clock::now();
         fprintf(stderr, eventLoopWarning);
+        locks = make_shared<vector<AsyncLock>>(object_store.lockDatasets(uids));
         auto elapsed = std::chrono::high_resolution_clock::now() - start;
         fprintf(
           stderr,
@@ -123,10 +143,6 @@ class AsyncGuard {
       }
     }
   }
-  inline void acquire(long uid) {
-    if (lock != nullptr) throw "Trying to acquire multiple locks";
-    lock = object_store.lockDataset(uid);
-  }
   inline ~AsyncGuard() {
     if (lock != nullptr) object_store.unlockDataset(lock);
     if (locks != nullptr) object_store.unlockDatasets(*locks);
@@ -155,7 +171,7 @@ class GDALSyncExecutionProgress {
     public:
   GDALSyncExecutionProgress(Nan::Callback *);
   ~GDALSyncExecutionProgress();
-  void Send(GDALProgressInfo *) const;
+  bool Send(GDALProgressInfo *) const;
 };
 
 typedef std::function<v8::Local<v8::Value>(const char *)> GetFromPersistentFunc;
@@ -168,14 +184,17 @@ class GDALExecutionProgress {
   // Only one of these is active at any given moment
   const GDALAsyncExecutionProgress *async;
   const GDALSyncExecutionProgress *sync;
+  // Set by the main thread when the progress callback returns false
+  const std::atomic<bool> *cancelled;
 
   GDALExecutionProgress() = delete;
 
     public:
-  GDALExecutionProgress(const GDALAsyncExecutionProgress *);
+  GDALExecutionProgress(const GDALAsyncExecutionProgress *, const std::atomic<bool> *cancelled = nullptr);
   GDALExecutionProgress(const GDALSyncExecutionProgress *);
   ~GDALExecutionProgress();
-  void Send(GDALProgressInfo *info) const;
+  // Returns false if the operation should be interrupted
+  bool Send(GDALProgressInfo *info) const;
 };
 
 /**
@@ -183,7 +202,11 @@ class GDALExecutionProgress {
  */
 
 /**
- * @typedef ProgressCb ( complete: number, msg: string ) => void
+ * Returning `false` from the progress callback interrupts the operation
+ * on methods that support it, in async mode the interruption takes
+ * effect at the next progress update after the callback has run
+ *
+ * @typedef ProgressCb ( complete: number, msg: string ) => boolean|void
  */
 
 // This is the progress callback trampoline
@@ -214,6 +237,7 @@ template <class GDALType> class GDALAsyncWorker : public GDALAsyncProgressWorker
   const GDALRValFunc rval;
   const std::vector<long> ds_uids;
   GDALType raw;
+  std::atomic<bool> cancelled;
 
     public:
   explicit GDALAsyncWorker(
@@ -245,7 +269,8 @@ GDALAsyncWorker<GDALType>::GDALAsyncWorker(
     // as they will be executed in async context!
     doit(doit),
     rval(rval),
-    ds_uids(ds_uids) {
+    ds_uids(ds_uids),
+    cancelled(false) {
   // Main thread with the JS world is not running
   // Get persistent handles
   for (auto i = objects.begin(); i != objects.end(); i++) SaveToPersistent(i->first.c_str(), i->second);
@@ -261,7 +286,7 @@ template <class GDALType> void GDALAsyncWorker<GDALType>::Execute(const Executio
   // Aux thread with the JS world running
   // V8 objects are not acessible here
   try {
-    GDALExecutionProgress executionProgress(&progress);
+    GDALExecutionProgress executionProgress(&progress, &cancelled);
     AsyncGuard lock(ds_uids);
     raw = doit(executionProgress);
   } catch (const char *err) { this->SetErrorMessage(err); }
@@ -284,7 +309,8 @@ void GDALAsyncWorker<GDALType>::HandleProgressCallback(const GDALProgressInfo *d
   const GDALProgressInfo *to_send = data + (count - 1);
   if (data != nullptr && count > 0) {
     v8::Local<v8::Value> argv[] = {Nan::New<Number>(to_send->complete), SafeString::New(to_send->message)};
-    progressCallback->Call(2, argv, this->async_resource);
+    Nan::MaybeLocal<v8::Value> r = progressCallback->Call(2, argv, this->async_resource);
+    if (!r.IsEmpty() && r.ToLocalChecked()->IsFalse()) cancelled = true;
   }
 }
 
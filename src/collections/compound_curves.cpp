@@ -149,6 +149,7 @@ NAN_METHOD(CompoundCurveCurves::add) {
   Local<Object> parent =
     Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
   CompoundCurve *geom = Nan::ObjectWrap::Unwrap<CompoundCurve>(parent);
+  geom->promote();
 
   SimpleCurve *ring;
 
@@ -1,4 +1,5 @@
 #include <memory>
+#include <vector>
 #include "dataset_bands.hpp"
 #include "../gdal_common.hpp"
 #include "../gdal_dataset.hpp"
@@ -20,6 +21,7 @@ void DatasetBands::Initialize(Local<Object> target) {
   Nan__SetPrototypeAsyncableMethod(lcons, "count", count);
   Nan__SetPrototypeAsyncableMethod(lcons, "create", create);
   Nan__SetPrototypeAsyncableMethod(lcons, "get", get);
+  Nan__SetPrototypeAsyncableMethod(lcons, "adviseRead", adviseRead);
 
   ATTR_DONT_ENUM(lcons, "ds", dsGetter, READ_ONLY_SETTER);
 
@@ -186,15 +188,21 @@ GDAL_ASYNCABLE_DEFINE(DatasetBands::create) {
     return; // error parsing creation options, options->parse does the throwing
   }
 
+  long uid = ds->uid;
+  std::shared_ptr<int64_t> size(new int64_t(0));
   GDALAsyncableJob<GDALRasterBand *> job(ds->uid);
   job.persist(parent);
-  job.main = [raw, type, options](const GDALExecutionProgress &) {
+  job.main = [raw, type, options, size](const GDALExecutionProgress &) {
     CPLErrorReset();
     CPLErr err = raw->AddBand(type, options->get());
     if (err != CE_None) { throw CPLGetLastErrorMsg(); }
+    *size = Dataset::estimateSize(raw);
     return raw->GetRasterBand(raw->GetRasterCount());
   };
-  job.rval = [raw](GDALRasterBand *r, GetFromPersistentFunc) { return RasterBand::New(r, raw); };
+  job.rval = [raw, uid, size](GDALRasterBand *r, GetFromPersistentFunc) {
+    object_store.setSize<GDALDataset *>(uid, *size);
+    return RasterBand::New(r, raw);
+  };
   job.run(info, async, 2);
 }
 
@@ -238,6 +246,156 @@ GDAL_ASYNCABLE_DEFINE(DatasetBands::count) {
   job.run(info, async, 0);
 }
 
+/**
+ * @typedef AdviseReadWindow { x: number, y: number, width: number, height: number, buffer_width?: number, buffer_height?: number, type?: string, bands?: number[] }
+ */
+
+struct AdviseReadWindow {
+  int x, y, w, h;
+  int buffer_w, buffer_h;
+  GDALDataType type;
+  std::vector<int> bands;
+};
+
+/**
+ * Advises the driver that a list of windows is about to be read.
+ *
+ * Drivers reading from slow or remote storage (`/vsicurl/`, `/vsis3/`...)
+ * may use it to prefetch the data or to merge range requests, others
+ * simply ignore it.
+ *
+ * @method adviseRead
+ * @throws Error
+ * @param {AdviseReadWindow[]} windows
+ * @param {number} windows.x
+ * @param {number} windows.y
+ * @param {number} windows.width
+ * @param {number} windows.height
+ * @param {number} [windows.buffer_width=width]
+ * @param {number} [windows.buffer_height=height]
+ * @param {string} [windows.type] See {{#crossLink "Constants (GDT)"}}GDT constants{{/crossLink}}, defaults to the type of the first band
+ * @param {number[]} [windows.bands] Band ids, all bands if not given
+ */
+
+/**
+ * Advises the driver that a list of windows is about to be read.
+ * {{{async}}}
+ *
+ * @method adviseReadAsync
+ * @throws Error
+ * @param {AdviseReadWindow[]} windows
+ * @param {number} windows.x
+ * @param {number} windows.y
+ * @param {number} windows.width
+ * @param {number} windows.height
+ * @param {number} [windows.buffer_width=width]
+ * @param {number} [windows.buffer_height=height]
+ * @param {string} [windows.type] See {{#crossLink "Constants (GDT)"}}GDT constants{{/crossLink}}, defaults to the type of the first band
+ * @param {number[]} [windows.bands] Band ids, all bands if not given
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(DatasetBands::adviseRead) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(parent);
+
+  if (!ds->isAlive()) {
+    Nan::ThrowError("Dataset object has already been destroyed");
+    return;
+  }
+
+  GDALDataset *raw = ds->get();
+  int count = raw->GetRasterCount();
+  if (count == 0) {
+    Nan::ThrowError("Dataset does not have any raster bands");
+    return;
+  }
+
+  Local<Array> windows;
+  NODE_ARG_ARRAY(0, "windows", windows);
+
+  std::shared_ptr<std::vector<AdviseReadWindow>> list(new std::vector<AdviseReadWindow>);
+  for (unsigned i = 0; i < windows->Length(); i++) {
+    Local<Value> val = Nan::Get(windows, i).ToLocalChecked();
+    if (!val->IsObject()) {
+      Nan::ThrowTypeError("windows must contain only objects");
+      return;
+    }
+    Local<Object> window = val.As<Object>();
+    AdviseReadWindow w;
+    NODE_INT_FROM_OBJ(window, "x", w.x);
+    NODE_INT_FROM_OBJ(window, "y", w.y);
+    NODE_INT_FROM_OBJ(window, "width", w.w);
+    NODE_INT_FROM_OBJ(window, "height", w.h);
+    if (
+      w.x < 0 || w.y < 0 || w.w <= 0 || w.h <= 0 || w.x + w.w > raw->GetRasterXSize() ||
+      w.y + w.h > raw->GetRasterYSize()) {
+      Nan::ThrowRangeError("Window is outside of the raster");
+      return;
+    }
+    w.buffer_w = w.w;
+    w.buffer_h = w.h;
+    NODE_INT_FROM_OBJ_OPT(window, "buffer_width", w.buffer_w);
+    NODE_INT_FROM_OBJ_OPT(window, "buffer_height", w.buffer_h);
+
+    std::string type_name;
+    NODE_STR_FROM_OBJ_OPT(window, "type", type_name);
+    w.type = raw->GetRasterBand(1)->GetRasterDataType();
+    if (!type_name.empty()) {
+      w.type = GDALGetDataTypeByName(type_name.c_str());
+      if (w.type == GDT_Unknown) {
+        Nan::ThrowError("Invalid data type");
+        return;
+      }
+    }
+
+    Local<Array> bands;
+    NODE_ARRAY_FROM_OBJ_OPT(window, "bands", bands);
+    if (!bands.IsEmpty()) {
+      for (unsigned j = 0; j < bands->Length(); j++) {
+        Local<Value> id = Nan::Get(bands, j).ToLocalChecked();
+        if (!id->IsNumber()) {
+          Nan::ThrowTypeError("bands must contain only numbers");
+          return;
+        }
+        int band_id = Nan::To<int32_t>(id).ToChecked();
+        if (band_id < 1 || band_id > count) {
+          Nan::ThrowRangeError("Invalid band id");
+          return;
+        }
+        w.bands.push_back(band_id);
+      }
+    }
+    list->push_back(w);
+  }
+
+  GDALAsyncableJob<CPLErr> job(ds->uid);
+  job.persist(parent);
+  job.main = [raw, list](const GDALExecutionProgress &) {
+    CPLErrorReset();
+    for (AdviseReadWindow &w : *list) {
+      CPLErr err = raw->AdviseRead(
+        w.x,
+        w.y,
+        w.w,
+        w.h,
+        w.buffer_w,
+        w.buffer_h,
+        w.type,
+        w.bands.empty() ? raw->GetRasterCount() : static_cast<int>(w.bands.size()),
+        w.bands.empty() ? nullptr : w.bands.data(),
+        nullptr);
+      if (err != CE_None) throw CPLGetLastErrorMsg();
+    }
+    return CE_None;
+  };
+  job.rval = [](CPLErr, GetFromPersistentFunc) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 1);
+}
+
 /**
  * Parent dataset
  *
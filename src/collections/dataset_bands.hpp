@@ -30,6 +30,7 @@ class DatasetBands : public Nan::ObjectWrap {
   GDAL_ASYNCABLE_DECLARE(get);
   GDAL_ASYNCABLE_DECLARE(count);
   GDAL_ASYNCABLE_DECLARE(create);
+  GDAL_ASYNCABLE_DECLARE(adviseRead);
 
   static NAN_GETTER(dsGetter);
 
@@ -150,6 +150,7 @@ NAN_METHOD(FeatureFields::set) {
         }
       }
 
+      f->updateSize();
       info.GetReturnValue().Set(Nan::New<Integer>(n));
       return;
     } else if (info[0]->IsObject()) {
@@ -184,6 +185,7 @@ NAN_METHOD(FeatureFields::set) {
         n_fields_set++;
       }
 
+      f->updateSize();
       info.GetReturnValue().Set(Nan::New<Integer>(n_fields_set));
       return;
     } else {
@@ -201,6 +203,7 @@ NAN_METHOD(FeatureFields::set) {
       return;
     }
 
+    f->updateSize();
     info.GetReturnValue().Set(Nan::New<Integer>(1));
     return;
   } else {
@@ -238,6 +241,7 @@ NAN_METHOD(FeatureFields::reset) {
 
   if (info.Length() == 0) {
     for (i = 0; i < n; i++) { f->get()->UnsetField(i); }
+    f->updateSize();
     info.GetReturnValue().Set(Nan::New<Integer>(n));
     return;
   }
@@ -267,6 +271,7 @@ NAN_METHOD(FeatureFields::reset) {
     }
   }
 
+  f->updateSize();
   info.GetReturnValue().Set(Nan::New<Integer>(n));
 }
 
@@ -130,6 +130,7 @@ NAN_METHOD(GeometryCollectionChildren::remove) {
   Local<Object> parent =
     Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
   GeometryCollection *geom = Nan::ObjectWrap::Unwrap<GeometryCollection>(parent);
+  geom->promote();
 
   int i;
   NODE_ARG_INT(0, "index", i);
@@ -166,6 +167,7 @@ NAN_METHOD(GeometryCollectionChildren::add) {
   Local<Object> parent =
     Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
   GeometryCollection *geom = Nan::ObjectWrap::Unwrap<GeometryCollection>(parent);
+  geom->promote();
 
   Geometry *child;
 
@@ -1,8 +1,13 @@
 #include "layer_features.hpp"
 #include "../gdal_common.hpp"
 #include "../gdal_feature.hpp"
+#include "../gdal_feature_cursor.hpp"
 #include "../gdal_layer.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 namespace node_gdal {
 
 Nan::Persistent<FunctionTemplate> LayerFeatures::constructor;
@@ -18,10 +23,14 @@ void LayerFeatures::Initialize(Local<Object> target) {
   Nan__SetPrototypeAsyncableMethod(lcons, "count", count);
   Nan__SetPrototypeAsyncableMethod(lcons, "add", add);
   Nan__SetPrototypeAsyncableMethod(lcons, "get", get);
+  Nan__SetPrototypeAsyncableMethod(lcons, "getMany", getMany);
+  Nan__SetPrototypeAsyncableMethod(lcons, "page", page);
   Nan__SetPrototypeAsyncableMethod(lcons, "set", set);
   Nan__SetPrototypeAsyncableMethod(lcons, "first", first);
   Nan__SetPrototypeAsyncableMethod(lcons, "next", next);
+  Nan__SetPrototypeAsyncableMethod(lcons, "_nextBatch", nextBatch); // not a public API
   Nan__SetPrototypeAsyncableMethod(lcons, "remove", remove);
+  Nan::SetPrototypeMethod(lcons, "cursor", cursor);
 
   ATTR_DONT_ENUM(lcons, "layer", layerGetter, READ_ONLY_SETTER);
 
@@ -133,6 +142,233 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::get) {
   job.run(info, async, 1);
 }
 
+// Integers that can be converted to a GIntBig without overflowing
+static inline bool isFID(double v) {
+  return std::isfinite(v) && v == std::trunc(v) && v >= -9223372036854775808.0 && v < 9223372036854775808.0;
+}
+
+/**
+ * Fetch a list of features by their identifiers.
+ *
+ * All features are read in one operation while holding the dataset lock.
+ * The identifiers are read in ascending order to improve the locality of
+ * the accesses, the results are returned in the requested order.
+ * Missing features are returned as `null`.
+ *
+ * @method getMany
+ * @param {number[]|Float64Array} ids The feature IDs of the features to read.
+ * @throws Error
+ * @return {(gdal.Feature|null)[]}
+ */
+
+/**
+ * Fetch a list of features by their identifiers.
+ *
+ * All features are read in one operation while holding the dataset lock.
+ * The identifiers are read in ascending order to improve the locality of
+ * the accesses, the results are returned in the requested order.
+ * Missing features are returned as `null`.
+ * {{{async}}}
+ *
+ * @method getManyAsync
+ * @param {number[]|Float64Array} ids The feature IDs of the features to read.
+ * @param {callback<(gdal.Feature|null)[]>} [callback=undefined] {{{cb}}}
+ * @throws Error
+ * @return {Promise<(gdal.Feature|null)[]>}
+ */
+GDAL_ASYNCABLE_DEFINE(LayerFeatures::getMany) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  if (info.Length() < 1) {
+    Nan::ThrowError("feature ids must be given");
+    return;
+  }
+  std::vector<GIntBig> fids;
+  if (info[0]->IsFloat64Array()) {
+    Nan::TypedArrayContents<double> contents(info[0]);
+    fids.reserve(contents.length());
+    for (size_t i = 0; i < contents.length(); i++) {
+      if (!isFID((*contents)[i])) {
+        Nan::ThrowTypeError("feature ids must be integers");
+        return;
+      }
+      fids.push_back(static_cast<GIntBig>((*contents)[i]));
+    }
+  } else if (info[0]->IsArray()) {
+    Local<Array> array = info[0].As<Array>();
+    fids.reserve(array->Length());
+    for (unsigned i = 0; i < array->Length(); i++) {
+      Local<Value> val = Nan::Get(array, i).ToLocalChecked();
+      if (!val->IsNumber() || !isFID(Nan::To<double>(val).ToChecked())) {
+        Nan::ThrowTypeError("feature ids must be integers");
+        return;
+      }
+      fids.push_back(static_cast<GIntBig>(Nan::To<double>(val).ToChecked()));
+    }
+  } else {
+    Nan::ThrowTypeError("feature ids must be an array or a Float64Array");
+    return;
+  }
+
+  OGRLayer *gdal_layer = layer->get();
+  GDALAsyncableJob<std::vector<OGRFeature *>> job(layer->parent_uid);
+  job.persist(layer->handle());
+  job.main = [gdal_layer, fids](const GDALExecutionProgress &) {
+    std::vector<OGRFeature *> features(fids.size(), nullptr);
+    std::vector<size_t> order(fids.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&fids](size_t a, size_t b) { return fids[a] < fids[b]; });
+
+    // A missing feature is not an error here
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    OGRFeature *last = nullptr;
+    for (size_t i = 0; i < order.size(); i++) {
+      size_t idx = order[i];
+      if (i > 0 && fids[idx] == fids[order[i - 1]])
+        features[idx] = last != nullptr ? last->Clone() : nullptr;
+      else
+        features[idx] = last = gdal_layer->GetFeature(fids[idx]);
+    }
+    CPLPopErrorHandler();
+    CPLErrorReset();
+    return features;
+  };
+  job.rval = [](std::vector<OGRFeature *> features, GetFromPersistentFunc) {
+    Nan::EscapableHandleScope scope;
+    Local<Array> results = Nan::New<Array>(features.size());
+    for (size_t i = 0; i < features.size(); i++) {
+      if (features[i] == nullptr)
+        Nan::Set(results, i, Nan::Null());
+      else
+        Nan::Set(results, i, Feature::New(features[i]));
+    }
+    return scope.Escape(results);
+  };
+  job.run(info, async, 1);
+}
+
+/**
+ * Returns a page of features starting at the `offset`-th feature
+ * of the layer in iteration order, honoring the current filters.
+ *
+ * When the driver supports fast random positioning (`gdal.OLCFastSetNextByIndex`)
+ * the page is read directly, otherwise an index of the feature ids is built on the
+ * first call and reused until the filters are changed or features are added or removed.
+ *
+ * Moves the feature pointer used by `next()`.
+ *
+ * @example
+ * ```
+ * const features = layer.features.page(1000, 50);```
+ *
+ * @method page
+ * @param {number} offset index of the first feature of the page
+ * @param {number} limit maximum number of features to return
+ * @throws Error
+ * @return {gdal.Feature[]}
+ */
+
+/**
+ * Returns a page of features starting at the `offset`-th feature
+ * of the layer in iteration order, honoring the current filters.
+ *
+ * When the driver supports fast random positioning (`gdal.OLCFastSetNextByIndex`)
+ * the page is read directly, otherwise an index of the feature ids is built on the
+ * first call and reused until the filters are changed or features are added or removed.
+ *
+ * Moves the feature pointer used by `next()`.
+ * {{{async}}}
+ *
+ * @method pageAsync
+ * @param {number} offset index of the first feature of the page
+ * @param {number} limit maximum number of features to return
+ * @param {callback<gdal.Feature[]>} [callback=undefined] {{{cb}}}
+ * @throws Error
+ * @return {Promise<gdal.Feature[]>}
+ */
+GDAL_ASYNCABLE_DEFINE(LayerFeatures::page) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  double offset, limit;
+  NODE_ARG_DOUBLE(0, "offset", offset);
+  NODE_ARG_DOUBLE(1, "limit", limit);
+  if (offset < 0 || limit < 0) {
+    Nan::ThrowRangeError("offset and limit must be positive");
+    return;
+  }
+
+  GIntBig start = static_cast<GIntBig>(offset);
+  size_t count = static_cast<size_t>(limit);
+  OGRLayer *gdal_layer = layer->get();
+  long uid = layer->uid;
+  std::shared_ptr<size_t> index_capacity(new size_t(0));
+  GDALAsyncableJob<std::vector<OGRFeature *>> job(layer->parent_uid);
+  job.persist(layer->handle());
+  // The Layer is protected from the GC by the persistent handle
+  job.main = [layer, gdal_layer, start, count, index_capacity](const GDALExecutionProgress &) {
+    std::vector<OGRFeature *> features;
+    if (count == 0) return features;
+
+    if (gdal_layer->TestCapability(OLCFastSetNextByIndex) || !gdal_layer->TestCapability(OLCRandomRead)) {
+      // Without random read, an index would not be any faster than the generic SetNextByIndex()
+      gdal_layer->ResetReading();
+      if (start > 0 && gdal_layer->SetNextByIndex(start) != OGRERR_NONE) return features;
+      OGRFeature *feature;
+      while (features.size() < count && (feature = gdal_layer->GetNextFeature()) != nullptr)
+        features.push_back(feature);
+      return features;
+    }
+
+    if (!layer->fid_index_valid) {
+      layer->fid_index.clear();
+      gdal_layer->ResetReading();
+      OGRFeature *feature;
+      while ((feature = gdal_layer->GetNextFeature()) != nullptr) {
+        layer->fid_index.push_back(feature->GetFID());
+        OGRFeature::DestroyFeature(feature);
+      }
+      layer->fid_index_valid = true;
+    }
+    *index_capacity = layer->fid_index.capacity();
+    GIntBig size = static_cast<GIntBig>(layer->fid_index.size());
+    for (GIntBig i = start; i < size && features.size() < count; i++) {
+      OGRFeature *feature = gdal_layer->GetFeature(layer->fid_index[i]);
+      if (feature == nullptr) {
+        // The layer has been modified behind our back
+        for (auto f : features) OGRFeature::DestroyFeature(f);
+        layer->invalidateFidIndex();
+        throw "Layer has been modified, feature index is not valid anymore";
+      }
+      features.push_back(feature);
+    }
+    return features;
+  };
+  job.rval = [uid, index_capacity](std::vector<OGRFeature *> features, GetFromPersistentFunc) {
+    Nan::EscapableHandleScope scope;
+    if (*index_capacity > 0) object_store.setSize<OGRLayer *>(uid, Layer::estimateSize(*index_capacity));
+    Local<Array> results = Nan::New<Array>(features.size());
+    for (size_t i = 0; i < features.size(); i++) Nan::Set(results, i, Feature::New(features[i]));
+    return scope.Escape(results);
+  };
+  job.run(info, async, 2);
+}
+
 /**
  * Resets the feature pointer used by `next()` and
  * returns the first feature in the layer.
@@ -218,6 +454,72 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::next) {
   job.run(info, async, 0);
 }
 
+/**
+ * Resets the feature pointer used by `next()` and returns
+ * a reusable {{#crossLink "gdal.FeatureCursor"}}FeatureCursor{{/crossLink}}
+ * positioned before the first feature of the layer.
+ *
+ * Iterating with a cursor avoids creating a new `gdal.Feature` object for every row.
+ *
+ * @example
+ * ```
+ * const cursor = layer.features.cursor();
+ * while (cursor.advance()) { ... }```
+ *
+ * @method cursor
+ * @return {gdal.FeatureCursor}
+ */
+NAN_METHOD(LayerFeatures::cursor) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  GDAL_LOCK_PARENT(layer);
+  layer->get()->ResetReading();
+  info.GetReturnValue().Set(FeatureCursor::New(parent));
+}
+
+// Returns up to count features following the current read position
+// Used by Dataset.executeSQLStream(), not a public API
+GDAL_ASYNCABLE_DEFINE(LayerFeatures::nextBatch) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  int count;
+  NODE_ARG_INT(0, "count", count);
+
+  OGRLayer *gdal_layer = layer->get();
+  GDALAsyncableJob<std::vector<OGRFeature *>> job(layer->parent_uid);
+  job.persist(layer->handle());
+  job.main = [gdal_layer, count](const GDALExecutionProgress &) {
+    std::vector<OGRFeature *> features;
+    OGRFeature *feature;
+    while (static_cast<int>(features.size()) < count && (feature = gdal_layer->GetNextFeature()) != nullptr)
+      features.push_back(feature);
+    return features;
+  };
+  job.rval = [](std::vector<OGRFeature *> features, GetFromPersistentFunc) {
+    Nan::EscapableHandleScope scope;
+    Local<Array> results = Nan::New<Array>(features.size());
+    for (size_t i = 0; i < features.size(); i++) Nan::Set(results, i, Feature::New(features[i]));
+    return scope.Escape(results);
+  };
+  job.run(info, async, 1);
+}
+
 /**
  * Adds a feature to the layer. The feature should be created using the current
  * layer as the definition.
@@ -271,7 +573,8 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::add) {
   OGRFeature *gdal_f = f->get();
   GDALAsyncableJob<int> job(layer->parent_uid);
   job.persist(layer->handle());
-  job.main = [gdal_layer, gdal_f](const GDALExecutionProgress &) {
+  job.main = [layer, gdal_layer, gdal_f](const GDALExecutionProgress &) {
+    layer->invalidateFidIndex();
     int err = gdal_layer->CreateFeature(gdal_f);
     if (err != CE_None) throw getOGRErrMsg(err);
     return err;
@@ -408,7 +711,8 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::set) {
   OGRFeature *gdal_feature = f->get();
   GDALAsyncableJob<OGRErr> job(layer->parent_uid);
   job.persist(layer->handle(), f->handle());
-  job.main = [gdal_layer, gdal_feature](const GDALExecutionProgress &) {
+  job.main = [layer, gdal_layer, gdal_feature](const GDALExecutionProgress &) {
+    layer->invalidateFidIndex();
     OGRErr err = gdal_layer->SetFeature(gdal_feature);
     if (err != CE_None) throw getOGRErrMsg(err);
     return err;
@@ -453,7 +757,8 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::remove) {
   OGRLayer *gdal_layer = layer->get();
   GDALAsyncableJob<int> job(layer->parent_uid);
   job.persist(layer->handle());
-  job.main = [gdal_layer, i](const GDALExecutionProgress &) {
+  job.main = [layer, gdal_layer, i](const GDALExecutionProgress &) {
+    layer->invalidateFidIndex();
     int err = gdal_layer->DeleteFeature(i);
     if (err) { throw getOGRErrMsg(err); }
     return err;
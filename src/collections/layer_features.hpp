@@ -28,12 +28,16 @@ class LayerFeatures : public Nan::ObjectWrap {
   static NAN_METHOD(toString);
 
   GDAL_ASYNCABLE_DECLARE(get);
+  GDAL_ASYNCABLE_DECLARE(getMany);
+  GDAL_ASYNCABLE_DECLARE(page);
   GDAL_ASYNCABLE_DECLARE(first);
   GDAL_ASYNCABLE_DECLARE(next);
+  GDAL_ASYNCABLE_DECLARE(nextBatch);
   GDAL_ASYNCABLE_DECLARE(count);
   GDAL_ASYNCABLE_DECLARE(add);
   GDAL_ASYNCABLE_DECLARE(set);
   GDAL_ASYNCABLE_DECLARE(remove);
+  static NAN_METHOD(cursor);
 
   static NAN_GETTER(layerGetter);
 
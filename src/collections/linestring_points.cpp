@@ -3,6 +3,8 @@
 #include "../geometry/gdal_geometry.hpp"
 #include "../geometry/gdal_linestring.hpp"
 #include "../geometry/gdal_point.hpp"
+#include "../utils/flat_coordinates.hpp"
+#include "../utils/typed_array.hpp"
 
 namespace node_gdal {
 
@@ -22,6 +24,8 @@ void LineStringPoints::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "add", add);
   Nan::SetPrototypeMethod(lcons, "reverse", reverse);
   Nan::SetPrototypeMethod(lcons, "resize", resize);
+  Nan::SetPrototypeMethod(lcons, "toTypedArray", toTypedArray);
+  Nan::SetPrototypeMethod(lcons, "setTypedArray", setTypedArray);
 
   Nan::Set(target, Nan::New("LineStringPoints").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
 
@@ -106,6 +110,7 @@ NAN_METHOD(LineStringPoints::reverse) {
   Local<Object> parent =
     Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
   LineString *geom = Nan::ObjectWrap::Unwrap<LineString>(parent);
+  geom->promote();
 
   geom->get()->reversePoints();
 
@@ -124,6 +129,7 @@ NAN_METHOD(LineStringPoints::resize) {
   Local<Object> parent =
     Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
   LineString *geom = Nan::ObjectWrap::Unwrap<LineString>(parent);
+  geom->promote();
 
   int count;
   NODE_ARG_INT(0, "point count", count)
@@ -189,6 +195,7 @@ NAN_METHOD(LineStringPoints::set) {
   Local<Object> parent =
     Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
   LineString *geom = Nan::ObjectWrap::Unwrap<LineString>(parent);
+  geom->promote();
 
   int i;
   NODE_ARG_INT(0, "index", i);
@@ -290,6 +297,7 @@ NAN_METHOD(LineStringPoints::add) {
   Local<Object> parent =
     Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
   LineString *geom = Nan::ObjectWrap::Unwrap<LineString>(parent);
+  geom->promote();
 
   int n = info.Length();
 
@@ -386,4 +394,99 @@ NAN_METHOD(LineStringPoints::add) {
   return;
 }
 
+/**
+ * @typedef FlatCoordinatesOptions { dims?: string }
+ */
+
+/**
+ * Returns all the points as a single interleaved `Float64Array`
+ * without creating a `gdal.Point` object per vertex.
+ *
+ * @example
+ * ```
+ * const xy = lineString.points.toTypedArray({ dims: 'xy' });
+ * // [ x0, y0, x1, y1, ... ]```
+ *
+ * @method toTypedArray
+ * @param {FlatCoordinatesOptions} [options]
+ * @param {string} [options.dims] `"xy"`, `"xyz"`, `"xym"` or `"xyzm"`, defaults to the dimensions of the geometry
+ * @throws Error
+ * @return {Float64Array}
+ */
+NAN_METHOD(LineStringPoints::toTypedArray) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  LineString *geom = Nan::ObjectWrap::Unwrap<LineString>(parent);
+
+  FlatCoordinates::Dims dims = FlatCoordinates::Of(geom->get());
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(0, "options", options);
+  if (!options.IsEmpty()) {
+    std::string dims_name = "";
+    NODE_STR_FROM_OBJ_OPT(options, "dims", dims_name);
+    if (!dims_name.empty() && !FlatCoordinates::Parse(dims_name, dims)) {
+      Nan::ThrowError("dims must be one of xy, xyz, xym or xyzm");
+      return;
+    }
+  }
+
+  int n = geom->get()->getNumPoints();
+  Local<Value> array = TypedArray::New(GDT_Float64, n * dims.stride());
+  if (array.IsEmpty() || !array->IsObject()) return; // TypedArray::New threw an error
+  Nan::TypedArrayContents<double> contents(array);
+  if (n > 0) FlatCoordinates::Export(geom->get(), dims, *contents);
+
+  info.GetReturnValue().Set(array);
+}
+
+/**
+ * Replaces all the points with the vertices from an interleaved `Float64Array`
+ * in a single operation.
+ *
+ * @example
+ * ```
+ * lineString.points.setTypedArray(new Float64Array([ 0, 0, 10, 0, 10, 10 ]), { dims: 'xy' });```
+ *
+ * @method setTypedArray
+ * @param {Float64Array} coordinates
+ * @param {FlatCoordinatesOptions} [options]
+ * @param {string} [options.dims] `"xy"`, `"xyz"`, `"xym"` or `"xyzm"`, defaults to the dimensions of the geometry
+ * @throws Error
+ */
+NAN_METHOD(LineStringPoints::setTypedArray) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  LineString *geom = Nan::ObjectWrap::Unwrap<LineString>(parent);
+  geom->promote();
+
+  if (info.Length() < 1 || !info[0]->IsFloat64Array()) {
+    Nan::ThrowTypeError("coordinates must be a Float64Array");
+    return;
+  }
+
+  FlatCoordinates::Dims dims = FlatCoordinates::Of(geom->get());
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  if (!options.IsEmpty()) {
+    std::string dims_name = "";
+    NODE_STR_FROM_OBJ_OPT(options, "dims", dims_name);
+    if (!dims_name.empty() && !FlatCoordinates::Parse(dims_name, dims)) {
+      Nan::ThrowError("dims must be one of xy, xyz, xym or xyzm");
+      return;
+    }
+  }
+
+  Nan::TypedArrayContents<double> contents(info[0]);
+  if (contents.length() % dims.stride() != 0) {
+    Nan::ThrowError("coordinates length must be a multiple of the number of dimensions");
+    return;
+  }
+
+  FlatCoordinates::Import(geom->get(), dims, *contents, contents.length() / dims.stride());
+}
+
 } // namespace node_gdal
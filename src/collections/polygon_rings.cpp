@@ -158,6 +158,7 @@ NAN_METHOD(PolygonRings::add) {
   Local<Object> parent =
     Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
   Polygon *geom = Nan::ObjectWrap::Unwrap<Polygon>(parent);
+  geom->promote();
 
   LinearRing *ring;
 
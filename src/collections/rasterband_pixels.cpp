@@ -2,6 +2,7 @@
 #include "../gdal_common.hpp"
 #include "../gdal_rasterband.hpp"
 #include "../async.hpp"
+#include "../gdal_block_cache.hpp"
 #include "../utils/typed_array.hpp"
 
 #include <sstream>
@@ -28,6 +29,7 @@ void RasterBandPixels::Initialize(Local<Object> target) {
   Nan__SetPrototypeAsyncableMethod(lcons, "write", write);
   Nan__SetPrototypeAsyncableMethod(lcons, "readBlock", readBlock);
   Nan__SetPrototypeAsyncableMethod(lcons, "writeBlock", writeBlock);
+  Nan__SetPrototypeAsyncableMethod(lcons, "adviseRead", adviseRead);
 
   ATTR_DONT_ENUM(lcons, "band", bandGetter, READ_ONLY_SETTER);
 
@@ -144,6 +146,7 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::get) {
 
   job.main = [raw, x, y](const GDALExecutionProgress &) {
     double val;
+    BlockCache::probe(raw, x, y, 1, 1);
     CPLErrorReset();
     CPLErr err = raw->RasterIO(GF_Read, x, y, 1, 1, &val, 1, 1, GDT_Float64, 0, 0);
     if (err) { throw CPLGetLastErrorMsg(); }
@@ -396,6 +399,8 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::read) {
       extra->pProgressData = (void *)&progress;
     }
 
+    // Decimated reads can be served from the overviews
+    if (buffer_w == w && buffer_h == h) BlockCache::probe(gdal_band, x, y, w, h);
     CPLErrorReset();
     CPLErr err =
       gdal_band->RasterIO(GF_Read, x, y, w, h, data, buffer_w, buffer_h, type, pixel_space, line_space, extra.get());
@@ -664,6 +669,94 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::writeBlock) {
   job.run(info, async, 3);
 }
 
+/**
+ * @typedef AdviseReadOptions { buffer_width?: number, buffer_height?: number, type?: string }
+ */
+
+/**
+ * Advises the driver that a region of pixels is about to be read.
+ *
+ * Drivers reading from slow or remote storage (`/vsicurl/`, `/vsis3/`...)
+ * may use it to prefetch the data or to merge range requests, others
+ * simply ignore it.
+ *
+ * @method adviseRead
+ * @throws Error
+ * @param {number} x
+ * @param {number} y
+ * @param {number} width
+ * @param {number} height
+ * @param {AdviseReadOptions} [options]
+ * @param {number} [options.buffer_width=width]
+ * @param {number} [options.buffer_height=height]
+ * @param {string} [options.type] See {{#crossLink "Constants (GDT)"}}GDT constants{{/crossLink}}.
+ */
+
+/**
+ * Advises the driver that a region of pixels is about to be read.
+ * {{{async}}}
+ *
+ * @method adviseReadAsync
+ * @throws Error
+ * @param {number} x
+ * @param {number} y
+ * @param {number} width
+ * @param {number} height
+ * @param {AdviseReadOptions} [options]
+ * @param {number} [options.buffer_width=width]
+ * @param {number} [options.buffer_height=height]
+ * @param {string} [options.type] See {{#crossLink "Constants (GDT)"}}GDT constants{{/crossLink}}.
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(RasterBandPixels::adviseRead) {
+  Nan::HandleScope scope;
+
+  RasterBand *band;
+  if ((band = parent(info)) == nullptr) return;
+
+  int x, y, w, h;
+  NODE_ARG_INT(0, "x_offset", x);
+  NODE_ARG_INT(1, "y_offset", y);
+  NODE_ARG_INT(2, "x_size", w);
+  NODE_ARG_INT(3, "y_size", h);
+
+  GDALRasterBand *gdal_band = band->get();
+  if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > gdal_band->GetXSize() || y + h > gdal_band->GetYSize()) {
+    Nan::ThrowRangeError("Window is outside of the raster");
+    return;
+  }
+
+  int buffer_w = w, buffer_h = h;
+  GDALDataType type = gdal_band->GetRasterDataType();
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(4, "options", options);
+  if (!options.IsEmpty()) {
+    std::string type_name;
+    NODE_INT_FROM_OBJ_OPT(options, "buffer_width", buffer_w);
+    NODE_INT_FROM_OBJ_OPT(options, "buffer_height", buffer_h);
+    NODE_STR_FROM_OBJ_OPT(options, "type", type_name);
+    if (!type_name.empty()) {
+      type = GDALGetDataTypeByName(type_name.c_str());
+      if (type == GDT_Unknown) {
+        Nan::ThrowError("Invalid data type");
+        return;
+      }
+    }
+  }
+
+  GDALAsyncableJob<CPLErr> job(band->parent_uid);
+  job.persist(band->handle());
+  job.main = [gdal_band, x, y, w, h, buffer_w, buffer_h, type](const GDALExecutionProgress &) {
+    CPLErrorReset();
+    CPLErr err = gdal_band->AdviseRead(x, y, w, h, buffer_w, buffer_h, type, nullptr);
+    if (err != CE_None) throw CPLGetLastErrorMsg();
+    return err;
+  };
+  job.rval = [](CPLErr, GetFromPersistentFunc) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 5);
+}
+
 /**
  * Parent raster band
  *
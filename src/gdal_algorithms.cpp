@@ -3,7 +3,16 @@
 #include "gdal_dataset.hpp"
 #include "gdal_layer.hpp"
 #include "gdal_rasterband.hpp"
+#include "geometry/gdal_geometry.hpp"
 #include "utils/number_list.hpp"
+#include "utils/strtree.hpp"
+#include "utils/typed_array.hpp"
+
+#include <ogr_api.h>
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
 
 namespace node_gdal {
 
@@ -13,6 +22,8 @@ void Algorithms::Initialize(Local<Object> target) {
   Nan__SetAsyncableMethod(target, "sieveFilter", sieveFilter);
   Nan__SetAsyncableMethod(target, "checksumImage", checksumImage);
   Nan__SetAsyncableMethod(target, "polygonize", polygonize);
+  Nan__SetAsyncableMethod(target, "rasterize", rasterize);
+  Nan__SetAsyncableMethod(target, "spatialJoin", spatialJoin);
   Nan__SetAsyncableMethod(target, "_acquireLocks", _acquireLocks);
 }
 
@@ -509,6 +520,235 @@ GDAL_ASYNCABLE_DEFINE(Algorithms::polygonize) {
   job.run(info, async, 1);
 }
 
+/**
+ * @typedef RasterizeOptions { src: gdal.Layer|gdal.Geometry[], dst: gdal.RasterBand, burnValues?: number|number[], attribute?: string, allTouched?: boolean, mergeAlg?: string, progress_cb?: ProgressCb }
+ */
+
+/**
+ * Burns vector geometries into a raster band, the inverse of `polygonize()`.
+ *
+ * The geometries of a layer are reprojected to the coordinate system of the
+ * raster when both have one, an array of geometries must already be in the
+ * coordinate system of the raster.
+ * Either `burnValues` or `attribute` must be given.
+ *
+ * @example
+ * ```
+ * await gdal.rasterizeAsync({ src: buildings, dst: mask.bands.get(1), burnValues: 1, allTouched: true });```
+ *
+ * @throws Error
+ * @method rasterize
+ * @static
+ * @for gdal
+ * @param {RasterizeOptions} options
+ * @param {gdal.Layer|gdal.Geometry[]} options.src
+ * @param {gdal.RasterBand} options.dst
+ * @param {number|number[]} [options.burnValues] The value to burn, either a single value or one value per geometry when `src` is an array of geometries.
+ * @param {string} [options.attribute] The name of the attribute field of the layer whose value is burnt, only when `src` is a layer.
+ * @param {boolean} [options.allTouched=false] Burn all the pixels touched by the geometries instead of only those whose center is inside them.
+ * @param {string} [options.mergeAlg="replace"] `replace` overwrites the existing value, `add` adds to it.
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ */
+
+/**
+ * Burns vector geometries into a raster band, the inverse of `polygonize()`.
+ * {{{async}}}
+ *
+ * The geometries of a layer are reprojected to the coordinate system of the
+ * raster when both have one, an array of geometries must already be in the
+ * coordinate system of the raster.
+ * Either `burnValues` or `attribute` must be given.
+ *
+ * @throws Error
+ * @method rasterizeAsync
+ * @static
+ * @for gdal
+ * @param {RasterizeOptions} options
+ * @param {gdal.Layer|gdal.Geometry[]} options.src
+ * @param {gdal.RasterBand} options.dst
+ * @param {number|number[]} [options.burnValues] The value to burn, either a single value or one value per geometry when `src` is an array of geometries.
+ * @param {string} [options.attribute] The name of the attribute field of the layer whose value is burnt, only when `src` is a layer.
+ * @param {boolean} [options.allTouched=false] Burn all the pixels touched by the geometries instead of only those whose center is inside them.
+ * @param {string} [options.mergeAlg="replace"] `replace` overwrites the existing value, `add` adds to it.
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Algorithms::rasterize) {
+  Nan::HandleScope scope;
+
+  Local<Object> obj;
+  RasterBand *dst;
+  Layer *layer = nullptr;
+  Local<Array> geometries;
+  std::vector<double> burn_values;
+  std::string attribute;
+  std::string merge_alg = "replace";
+  Nan::Callback *progress_cb = nullptr;
+
+  NODE_ARG_OBJECT(0, "options", obj);
+
+  Local<Value> src = Nan::Get(obj, Nan::New("src").ToLocalChecked()).ToLocalChecked();
+  if (IS_WRAPPED(src, Layer)) {
+    layer = Nan::ObjectWrap::Unwrap<Layer>(src.As<Object>());
+    if (!layer->isAlive()) {
+      Nan::ThrowError("Layer object has already been destroyed");
+      return;
+    }
+  } else if (src->IsArray()) {
+    geometries = src.As<Array>();
+  } else {
+    Nan::ThrowTypeError("Property \"src\" must be a Layer or an array of Geometry objects");
+    return;
+  }
+  NODE_WRAPPED_FROM_OBJ(obj, "dst", RasterBand, dst);
+  NODE_STR_FROM_OBJ_OPT(obj, "attribute", attribute);
+  NODE_STR_FROM_OBJ_OPT(obj, "mergeAlg", merge_alg);
+  NODE_CB_FROM_OBJ_OPT(obj, "progress_cb", progress_cb);
+
+  Local<String> burn_sym = Nan::New("burnValues").ToLocalChecked();
+  if (Nan::HasOwnProperty(obj, burn_sym).FromMaybe(false)) {
+    Local<Value> val = Nan::Get(obj, burn_sym).ToLocalChecked();
+    if (val->IsNumber()) {
+      burn_values.push_back(Nan::To<double>(val).ToChecked());
+    } else if (val->IsArray()) {
+      Local<Array> values = val.As<Array>();
+      for (unsigned i = 0; i < values->Length(); i++) {
+        Local<Value> value = Nan::Get(values, i).ToLocalChecked();
+        if (!value->IsNumber()) {
+          Nan::ThrowTypeError("Property \"burnValues\" must contain only numbers");
+          return;
+        }
+        burn_values.push_back(Nan::To<double>(value).ToChecked());
+      }
+    } else {
+      Nan::ThrowTypeError("Property \"burnValues\" must be a number or an array of numbers");
+      return;
+    }
+  }
+
+  if (burn_values.empty() == attribute.empty()) {
+    Nan::ThrowError("Either burnValues or attribute must be given");
+    return;
+  }
+  if (merge_alg != "replace" && merge_alg != "add") {
+    Nan::ThrowError("mergeAlg must be replace or add");
+    return;
+  }
+
+  std::vector<OGRGeometryH> gdal_geoms;
+  std::vector<uv_sem_t *> locks;
+  std::vector<Local<Object>> elements;
+  if (layer) {
+    if (burn_values.size() > 1) {
+      Nan::ThrowError("A layer accepts only one burn value");
+      return;
+    }
+  } else {
+    if (!attribute.empty()) {
+      Nan::ThrowError("attribute requires a Layer");
+      return;
+    }
+    for (unsigned i = 0; i < geometries->Length(); i++) {
+      Local<Value> element = Nan::Get(geometries, i).ToLocalChecked();
+      if (!IS_WRAPPED(element, Geometry)) {
+        Nan::ThrowTypeError("Property \"src\" must contain only Geometry objects");
+        return;
+      }
+      Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(element.As<Object>());
+      if (!geom->isAlive()) {
+        Nan::ThrowError("Geometry object has already been destroyed");
+        return;
+      }
+      gdal_geoms.push_back(OGRGeometry::ToHandle(geom->get()));
+      locks.push_back(geom->getAsyncLock());
+      elements.push_back(element.As<Object>());
+    }
+    // All geometries are locked at the same time, every lock must be taken only once
+    // and always in the same order to avoid deadlocks between concurrent jobs
+    std::sort(locks.begin(), locks.end());
+    locks.erase(std::unique(locks.begin(), locks.end()), locks.end());
+    if (burn_values.size() == 1) {
+      burn_values.resize(gdal_geoms.size(), burn_values[0]);
+    } else if (burn_values.size() != gdal_geoms.size()) {
+      Nan::ThrowError("burnValues must contain one value or one value per geometry");
+      return;
+    }
+  }
+
+  GDALRasterBand *gdal_dst = dst->get();
+  GDALDataset *gdal_ds = gdal_dst->GetDataset();
+  if (gdal_ds == nullptr) {
+    Nan::ThrowError("Destination band does not belong to a dataset");
+    return;
+  }
+  int band = gdal_dst->GetBand();
+  OGRLayer *gdal_layer = layer ? layer->get() : nullptr;
+
+  char **papszOptions = NULL;
+  if (!attribute.empty()) papszOptions = CSLSetNameValue(papszOptions, "ATTRIBUTE", attribute.c_str());
+  if (
+    Nan::HasOwnProperty(obj, Nan::New("allTouched").ToLocalChecked()).FromMaybe(false) &&
+    Nan::To<bool>(Nan::Get(obj, Nan::New("allTouched").ToLocalChecked()).ToLocalChecked()).ToChecked())
+    papszOptions = CSLSetNameValue(papszOptions, "ALL_TOUCHED", "TRUE");
+  if (merge_alg == "add") papszOptions = CSLSetNameValue(papszOptions, "MERGE_ALG", "ADD");
+
+  std::vector<long> ds_uids = {dst->parent_uid};
+  if (layer) ds_uids.push_back(layer->parent_uid);
+
+  GDALAsyncableJob<CPLErr> job(ds_uids);
+  job.progress = progress_cb;
+  job.persist(obj);
+  if (!layer) {
+    // The array can be modified while the job is running
+    job.persist(geometries);
+    job.persist(elements);
+  }
+  job.main = [gdal_ds, band, gdal_layer, gdal_geoms, locks, burn_values, papszOptions, progress_cb](
+               const GDALExecutionProgress &progress) {
+    std::vector<OGRGeometryH> geoms = gdal_geoms;
+    std::vector<double> values = burn_values;
+    int bands[] = {band};
+    CPLErrorReset();
+    CPLErr err;
+    if (gdal_layer) {
+      OGRLayerH layers[] = {reinterpret_cast<OGRLayerH>(gdal_layer)};
+      err = GDALRasterizeLayers(
+        GDALDataset::ToHandle(gdal_ds),
+        1,
+        bands,
+        1,
+        layers,
+        nullptr,
+        nullptr,
+        values.empty() ? nullptr : values.data(),
+        papszOptions,
+        progress_cb ? ProgressTrampoline : nullptr,
+        progress_cb ? (void *)&progress : nullptr);
+    } else {
+      for (uv_sem_t *lock : locks) uv_sem_wait(lock);
+      err = GDALRasterizeGeometries(
+        GDALDataset::ToHandle(gdal_ds),
+        1,
+        bands,
+        static_cast<int>(geoms.size()),
+        geoms.data(),
+        nullptr,
+        nullptr,
+        values.data(),
+        papszOptions,
+        progress_cb ? ProgressTrampoline : nullptr,
+        progress_cb ? (void *)&progress : nullptr);
+      for (uv_sem_t *lock : locks) uv_sem_post(lock);
+    }
+    if (papszOptions) CSLDestroy(papszOptions);
+    if (err) throw CPLGetLastErrorMsg();
+    return err;
+  };
+  job.rval = [](CPLErr r, GetFromPersistentFunc) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 1);
+}
+
 // This is used for stress-testing the locking mechanism
 // it doesn't do anything but sollicit locks
 GDAL_ASYNCABLE_DEFINE(Algorithms::_acquireLocks) {
@@ -530,4 +770,337 @@ GDAL_ASYNCABLE_DEFINE(Algorithms::_acquireLocks) {
   job.run(info, async, 3);
 }
 
+// Spatial join helpers
+
+enum SpatialJoinPredicate { JoinIntersects, JoinWithin, JoinContains };
+
+struct SpatialJoinResult {
+  std::vector<GIntBig> left;
+  std::vector<GIntBig> right;
+};
+
+// The indexed side of a spatial join
+struct SpatialJoinIndex {
+  std::vector<OGRFeature *> features;
+  std::vector<OGRPreparedGeometryH> prepared;
+  // GEOS prepared geometries cannot be queried concurrently
+  std::vector<std::mutex> locks;
+  STRtree tree;
+
+  SpatialJoinIndex(OGRLayer *layer) : features(), prepared(), locks(), tree() {
+    std::vector<OGREnvelope> envs;
+    OGRFeature *feature;
+    layer->ResetReading();
+    while ((feature = layer->GetNextFeature()) != nullptr) {
+      OGRGeometry *geom = feature->GetGeometryRef();
+      if (geom == nullptr || geom->IsEmpty()) {
+        OGRFeature::DestroyFeature(feature);
+        continue;
+      }
+      OGREnvelope env;
+      geom->getEnvelope(&env);
+      envs.push_back(env);
+      features.push_back(feature);
+      prepared.push_back(OGRCreatePreparedGeometry(OGRGeometry::ToHandle(geom)));
+    }
+    layer->ResetReading();
+    locks = std::vector<std::mutex>(features.size());
+    tree.build(envs);
+  }
+
+  ~SpatialJoinIndex() {
+    for (size_t i = 0; i < features.size(); i++) {
+      if (prepared[i] != nullptr) OGRDestroyPreparedGeometry(prepared[i]);
+      OGRFeature::DestroyFeature(features[i]);
+    }
+  }
+
+  // predicate(left, right), the prepared geometry is used whenever
+  // the indexed geometry is its first operand
+  bool test(SpatialJoinPredicate predicate, bool indexed_left, uint32_t i, OGRGeometry *other) {
+    OGRGeometry *geom = features[i]->GetGeometryRef();
+    OGRGeometryH h = OGRGeometry::ToHandle(other);
+    bool prepared_contains = indexed_left ? predicate == JoinContains : predicate == JoinWithin;
+    if (prepared[i] != nullptr && (predicate == JoinIntersects || prepared_contains)) {
+      std::lock_guard<std::mutex> lock(locks[i]);
+      return predicate == JoinIntersects ? OGRPreparedGeometryIntersects(prepared[i], h)
+                                         : OGRPreparedGeometryContains(prepared[i], h);
+    }
+    switch (predicate) {
+      case JoinIntersects: return geom->Intersects(other);
+      case JoinWithin: return indexed_left ? geom->Within(other) : other->Within(geom);
+      case JoinContains: return indexed_left ? geom->Contains(other) : other->Contains(geom);
+    }
+    return false;
+  }
+};
+
+/**
+ * @typedef SpatialJoinOptions { predicate?: string, fields?: string[], output?: gdal.Layer, threads?: number, progress_cb?: ProgressCb }
+ */
+
+/**
+ * @typedef SpatialJoinResult { left: Float64Array, right: Float64Array }
+ */
+
+/**
+ * Joins the features of two layers by their geometries.
+ *
+ * The smaller layer is loaded in a spatial index with prepared geometries while
+ * the other one is read in batches which are matched on multiple threads.
+ *
+ * Without an `output` layer, the matching pairs are returned as two arrays of FIDs
+ * of the same length, ordered by the FID of the left feature.
+ *
+ * With an `output` layer, a feature with the geometry of the left feature,
+ * all the fields of the left feature and the selected fields of the right
+ * feature is created for every matching pair. The missing fields are created
+ * in the output layer, right fields that have the same name as a left field overwrite it.
+ *
+ * The current spatial and attribute filters of both layers are respected.
+ * Requires GDAL with GEOS support.
+ *
+ * @example
+ * ```
+ * const pairs = await gdal.spatialJoinAsync(incidents, districts, { predicate: 'within' });
+ * for (let i = 0; i < pairs.left.length; i++)
+ *   console.log(`incident ${pairs.left[i]} is in district ${pairs.right[i]}`);```
+ *
+ * @throws Error
+ * @method spatialJoin
+ * @static
+ * @for gdal
+ * @param {gdal.Layer} left
+ * @param {gdal.Layer} right
+ * @param {SpatialJoinOptions} [options]
+ * @param {string} [options.predicate="intersects"] `intersects`, `within` (left within right)
+ * or `contains` (left contains right)
+ * @param {string[]} [options.fields] Fields of the right layer to copy in the output layer, all by default
+ * @param {gdal.Layer} [options.output] Output layer
+ * @param {number} [options.threads] Number of threads, the number of CPUs by default
+ * @param {ProgressCb} [options.progress_cb]
+ * @return {SpatialJoinResult|undefined}
+ */
+
+/**
+ * Joins the features of two layers by their geometries.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method spatialJoinAsync
+ * @static
+ * @for gdal
+ * @param {gdal.Layer} left
+ * @param {gdal.Layer} right
+ * @param {SpatialJoinOptions} [options]
+ * @param {string} [options.predicate="intersects"] `intersects`, `within` (left within right)
+ * or `contains` (left contains right)
+ * @param {string[]} [options.fields] Fields of the right layer to copy in the output layer, all by default
+ * @param {gdal.Layer} [options.output] Output layer
+ * @param {number} [options.threads] Number of threads, the number of CPUs by default
+ * @param {ProgressCb} [options.progress_cb]
+ * @param {callback<SpatialJoinResult|undefined>} [callback=undefined] {{{cb}}}
+ * @return {Promise<SpatialJoinResult|undefined>}
+ */
+GDAL_ASYNCABLE_DEFINE(Algorithms::spatialJoin) {
+  Nan::HandleScope scope;
+
+  Layer *left, *right, *output = nullptr;
+  Local<Object> obj = Nan::New<Object>();
+  std::string predicate_name = "intersects";
+  Local<Array> fields_array;
+  int threads = CPLGetNumCPUs();
+  Nan::Callback *progress_cb = nullptr;
+
+  NODE_ARG_WRAPPED(0, "left", Layer, left);
+  NODE_ARG_WRAPPED(1, "right", Layer, right);
+  NODE_ARG_OBJECT_OPT(2, "options", obj);
+  NODE_STR_FROM_OBJ_OPT(obj, "predicate", predicate_name);
+  NODE_ARRAY_FROM_OBJ_OPT(obj, "fields", fields_array);
+  NODE_WRAPPED_FROM_OBJ_OPT(obj, "output", Layer, output);
+  NODE_INT_FROM_OBJ_OPT(obj, "threads", threads);
+  NODE_CB_FROM_OBJ_OPT(obj, "progress_cb", progress_cb);
+
+  SpatialJoinPredicate predicate;
+  if (predicate_name == "intersects")
+    predicate = JoinIntersects;
+  else if (predicate_name == "within")
+    predicate = JoinWithin;
+  else if (predicate_name == "contains")
+    predicate = JoinContains;
+  else {
+    Nan::ThrowError("predicate must be one of intersects, within or contains");
+    return;
+  }
+  if (!OGRHasPreparedGeometrySupport()) {
+    Nan::ThrowError("spatialJoin requires GDAL with GEOS support");
+    return;
+  }
+
+  std::vector<std::string> fields;
+  bool all_fields = fields_array.IsEmpty();
+  if (!all_fields) {
+    for (unsigned i = 0; i < fields_array->Length(); i++) {
+      Local<Value> field = Nan::Get(fields_array, i).ToLocalChecked();
+      if (!field->IsString()) {
+        Nan::ThrowTypeError("fields must contain only strings");
+        return;
+      }
+      fields.push_back(*Nan::Utf8String(field));
+    }
+  }
+  threads = std::max(1, threads);
+
+  if (!left->isAlive() || !right->isAlive() || (output && !output->isAlive())) {
+    Nan::ThrowError("Layer object has already been destroyed");
+    return;
+  }
+  OGRLayer *gdal_left = left->get();
+  OGRLayer *gdal_right = right->get();
+  OGRLayer *gdal_output = output ? output->get() : nullptr;
+  // The streamed layer would grow while being read
+  if (gdal_output == gdal_left || gdal_output == gdal_right) {
+    Nan::ThrowError("output must be different from left and right");
+    return;
+  }
+  std::vector<long> ds_uids = {left->parent_uid, right->parent_uid};
+  if (output) ds_uids.push_back(output->parent_uid);
+
+  GDALAsyncableJob<SpatialJoinResult> job(ds_uids);
+  job.progress = progress_cb;
+  job.persist(info[0].As<Object>(), info[1].As<Object>());
+  job.persist(obj);
+  if (output) job.persist(output->handle());
+  job.main = [gdal_left, gdal_right, gdal_output, predicate, fields, all_fields, threads, progress_cb](
+               const GDALExecutionProgress &progress) {
+    SpatialJoinResult r;
+    OGRFeatureDefn *left_defn = gdal_left->GetLayerDefn();
+    OGRFeatureDefn *right_defn = gdal_right->GetLayerDefn();
+
+    // Output field indices of every left and right field, -1 for those not copied
+    std::vector<int> left_map, right_map;
+    if (gdal_output) {
+      OGRFeatureDefn *output_defn = gdal_output->GetLayerDefn();
+      auto map_field = [gdal_output, output_defn](OGRFieldDefn *field) {
+        int idx = output_defn->GetFieldIndex(field->GetNameRef());
+        if (idx < 0) {
+          if (gdal_output->CreateField(field) != OGRERR_NONE) throw CPLGetLastErrorMsg();
+          idx = output_defn->GetFieldIndex(field->GetNameRef());
+        }
+        return idx;
+      };
+      for (int i = 0; i < left_defn->GetFieldCount(); i++) left_map.push_back(map_field(left_defn->GetFieldDefn(i)));
+      for (int i = 0; i < right_defn->GetFieldCount(); i++) {
+        OGRFieldDefn *field = right_defn->GetFieldDefn(i);
+        if (all_fields || std::find(fields.begin(), fields.end(), field->GetNameRef()) != fields.end())
+          right_map.push_back(map_field(field));
+        else
+          right_map.push_back(-1);
+      }
+    }
+
+    // Only the drivers with a fast count are asked, the right layer is indexed by default
+    GIntBig left_count = gdal_left->GetFeatureCount(FALSE);
+    GIntBig right_count = gdal_right->GetFeatureCount(FALSE);
+    bool indexed_left = left_count >= 0 && right_count >= 0 && left_count < right_count;
+    OGRLayer *streamed = indexed_left ? gdal_right : gdal_left;
+    SpatialJoinIndex index(indexed_left ? gdal_left : gdal_right);
+
+    const size_t batch_size = 1024;
+    // No progress without a fast count
+    GIntBig total = progress_cb ? (indexed_left ? right_count : left_count) : -1;
+    GIntBig done = 0;
+    std::vector<std::pair<GIntBig, GIntBig>> pairs;
+    std::vector<OGRFeature *> batch;
+    streamed->ResetReading();
+    do {
+      batch.clear();
+      OGRFeature *feature;
+      while (batch.size() < batch_size && (feature = streamed->GetNextFeature()) != nullptr) batch.push_back(feature);
+
+      // (batch position, index position)
+      std::vector<std::vector<std::pair<size_t, uint32_t>>> matches(threads);
+      auto match = [&index, &batch, &matches, predicate, indexed_left](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          OGRGeometry *geom = batch[i]->GetGeometryRef();
+          if (geom == nullptr || geom->IsEmpty()) continue;
+          OGREnvelope env;
+          geom->getEnvelope(&env);
+          index.tree.query(env, [&](uint32_t j) {
+            if (index.test(predicate, indexed_left, j, geom)) matches[t].push_back({i, j});
+          });
+        }
+      };
+      size_t chunk = (batch.size() + threads - 1) / threads;
+      std::vector<std::thread> pool;
+      for (int t = 1; t < threads && (size_t)t * chunk < batch.size(); t++)
+        pool.push_back(std::thread(match, t, t * chunk, std::min(batch.size(), (t + 1) * chunk)));
+      match(0, 0, std::min(batch.size(), chunk));
+      for (auto &thread : pool) thread.join();
+
+      for (auto &thread_matches : matches) {
+        for (auto &m : thread_matches) {
+          OGRFeature *left_feature = indexed_left ? index.features[m.second] : batch[m.first];
+          OGRFeature *right_feature = indexed_left ? batch[m.first] : index.features[m.second];
+          if (gdal_output) {
+            OGRFeature *out = new OGRFeature(gdal_output->GetLayerDefn());
+            OGRErr err = out->SetFrom(left_feature, left_map.data(), TRUE);
+            if (err == OGRERR_NONE) err = out->SetFieldsFrom(right_feature, right_map.data(), TRUE);
+            if (err == OGRERR_NONE) err = gdal_output->CreateFeature(out);
+            OGRFeature::DestroyFeature(out);
+            if (err != OGRERR_NONE) {
+              for (OGRFeature *f : batch) OGRFeature::DestroyFeature(f);
+              throw getOGRErrMsg(err);
+            }
+          } else {
+            pairs.push_back({left_feature->GetFID(), right_feature->GetFID()});
+          }
+        }
+      }
+
+      done += batch.size();
+      for (OGRFeature *f : batch) OGRFeature::DestroyFeature(f);
+      if (progress_cb && total > 0 && !ProgressTrampoline((double)done / total, nullptr, (void *)&progress)) {
+        streamed->ResetReading();
+        throw "User terminated";
+      }
+    } while (batch.size() == batch_size);
+    streamed->ResetReading();
+
+    if (!gdal_output) {
+      std::sort(pairs.begin(), pairs.end());
+      for (auto &p : pairs) {
+        r.left.push_back(p.first);
+        r.right.push_back(p.second);
+      }
+    }
+    return r;
+  };
+  // The FID index is touched only on the main thread, the sync rval runs with the dataset still locked
+  job.rval = [output, async](SpatialJoinResult r, GetFromPersistentFunc) -> Local<Value> {
+    Nan::EscapableHandleScope scope;
+    if (output) {
+      if (async)
+        output->invalidateFidIndexUnlocked();
+      else
+        output->invalidateFidIndex();
+      return scope.Escape(Nan::Undefined());
+    }
+    Local<Object> result = Nan::New<Object>();
+    const std::vector<GIntBig> *columns[] = {&r.left, &r.right};
+    const char *names[] = {"left", "right"};
+    for (int c = 0; c < 2; c++) {
+      Local<Value> array = TypedArray::New(GDT_Float64, columns[c]->size());
+      if (array.IsEmpty() || !array->IsObject()) return scope.Escape(array);
+      Nan::TypedArrayContents<double> contents(array);
+      std::copy(columns[c]->begin(), columns[c]->end(), *contents);
+      Nan::Set(result, Nan::New(names[c]).ToLocalChecked(), array);
+    }
+    return scope.Escape(result);
+  };
+  // Features may have been added even if the operation fails and rval is not called
+  if (output) output->invalidateFidIndexUnlocked();
+  job.run(info, async, 3);
+}
+
 } // namespace node_gdal
@@ -0,0 +1,145 @@
+#include "gdal_block_cache.hpp"
+#include "gdal_common.hpp"
+
+namespace node_gdal {
+
+/**
+ * @for gdal
+ * @property cache
+ * @type {cache}
+ */
+
+/**
+ * Control and statistics of the GDAL raster block cache
+ *
+ * The block cache is shared by all the raster datasets of the process,
+ * its default size is 5% of the physical memory or the value of `GDAL_CACHEMAX`.
+ *
+ * The `hits` and `misses` counters are the number of blocks that were (or were not)
+ * already in the cache when they were read by `RasterBandPixels.read{Async}()` and
+ * `RasterBandPixels.get{Async}()` at full resolution.
+ *
+ * @example
+ * ```
+ * gdal.cache.setMax(256 * 1024 * 1024);
+ * const { used, max, hits, misses } = gdal.cache.stats();
+ * ```
+ *
+ * @class cache
+ */
+
+/**
+ * @typedef BlockCacheStats { used: number, max: number, hits: number, misses: number }
+ */
+
+std::atomic<uint64_t> BlockCache::hits(0);
+std::atomic<uint64_t> BlockCache::misses(0);
+
+void BlockCache::Initialize(Local<Object> target) {
+  Local<Object> cache = Nan::New<Object>();
+  Nan::Set(target, Nan::New("cache").ToLocalChecked(), cache);
+  Nan::SetMethod(cache, "setMax", setMax);
+  Nan::SetMethod(cache, "getMax", getMax);
+  Nan::SetMethod(cache, "used", used);
+  Nan::SetMethod(cache, "stats", stats);
+  Nan::SetMethod(cache, "resetStats", resetStats);
+}
+
+// TryGetLockedBlockRef() is protected, but a pointer to it can be taken from a derived class
+struct BlockCacheBandAccess : public GDALRasterBand {
+  static GDALRasterBlock *tryGet(GDALRasterBand *band, int x, int y) {
+    return (band->*(&BlockCacheBandAccess::TryGetLockedBlockRef))(x, y);
+  }
+};
+
+void BlockCache::probe(GDALRasterBand *band, int x, int y, int w, int h) {
+  int block_w = 0, block_h = 0;
+  band->GetBlockSize(&block_w, &block_h);
+  if (block_w <= 0 || block_h <= 0 || w <= 0 || h <= 0) return;
+  if (x < 0 || y < 0 || x + w > band->GetXSize() || y + h > band->GetYSize()) return;
+
+  uint64_t found = 0, total = 0;
+  for (int block_y = y / block_h; block_y <= (y + h - 1) / block_h; block_y++) {
+    for (int block_x = x / block_w; block_x <= (x + w - 1) / block_w; block_x++) {
+      GDALRasterBlock *block = BlockCacheBandAccess::tryGet(band, block_x, block_y);
+      if (block != nullptr) {
+        block->DropLock();
+        found++;
+      }
+      total++;
+    }
+  }
+  hits += found;
+  misses += total - found;
+}
+
+/**
+ * Sets the maximum size of the block cache in bytes, the least recently
+ * used blocks are flushed if it is already larger.
+ *
+ * @static
+ * @method setMax
+ * @param {number} bytes
+ * @return {void}
+ */
+NAN_METHOD(BlockCache::setMax) {
+  double bytes;
+  NODE_ARG_DOUBLE(0, "bytes", bytes);
+  if (bytes < 0) {
+    Nan::ThrowRangeError("bytes must be a positive number");
+    return;
+  }
+  GDALSetCacheMax64(static_cast<GIntBig>(bytes));
+}
+
+/**
+ * Returns the maximum size of the block cache in bytes.
+ *
+ * @static
+ * @method getMax
+ * @return {number}
+ */
+NAN_METHOD(BlockCache::getMax) {
+  info.GetReturnValue().Set(Nan::New<Number>(static_cast<double>(GDALGetCacheMax64())));
+}
+
+/**
+ * Returns the number of bytes currently used by the block cache.
+ *
+ * @static
+ * @method used
+ * @return {number}
+ */
+NAN_METHOD(BlockCache::used) {
+  info.GetReturnValue().Set(Nan::New<Number>(static_cast<double>(GDALGetCacheUsed64())));
+}
+
+/**
+ * Returns the block cache statistics, it is cheap enough to be polled by a metrics exporter.
+ *
+ * @static
+ * @method stats
+ * @return {BlockCacheStats}
+ */
+NAN_METHOD(BlockCache::stats) {
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("used").ToLocalChecked(), Nan::New<Number>(static_cast<double>(GDALGetCacheUsed64())));
+  Nan::Set(result, Nan::New("max").ToLocalChecked(), Nan::New<Number>(static_cast<double>(GDALGetCacheMax64())));
+  Nan::Set(result, Nan::New("hits").ToLocalChecked(), Nan::New<Number>(static_cast<double>(hits)));
+  Nan::Set(result, Nan::New("misses").ToLocalChecked(), Nan::New<Number>(static_cast<double>(misses)));
+  info.GetReturnValue().Set(result);
+}
+
+/**
+ * Resets the `hits` and `misses` counters.
+ *
+ * @static
+ * @method resetStats
+ * @return {void}
+ */
+NAN_METHOD(BlockCache::resetStats) {
+  hits = 0;
+  misses = 0;
+}
+
+} // namespace node_gdal
@@ -0,0 +1,39 @@
+#ifndef __NODE_GDAL_BLOCK_CACHE_H__
+#define __NODE_GDAL_BLOCK_CACHE_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// gdal
+#include <gdal_priv.h>
+
+#include <atomic>
+
+using namespace v8;
+
+namespace node_gdal {
+
+// Control and statistics of the GDAL raster block cache (GDAL_CACHEMAX)
+class BlockCache {
+    public:
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(setMax);
+  static NAN_METHOD(getMax);
+  static NAN_METHOD(used);
+  static NAN_METHOD(stats);
+  static NAN_METHOD(resetStats);
+
+  // Counts the blocks of a window that are already in the cache,
+  // must be called before reading them with the dataset lock held
+  static void probe(GDALRasterBand *band, int x, int y, int w, int h);
+
+    private:
+  static std::atomic<uint64_t> hits;
+  static std::atomic<uint64_t> misses;
+};
+
+} // namespace node_gdal
+#endif
@@ -3,6 +3,12 @@
 #include "gdal_common.hpp"
 #include "gdal_dataset.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "gdal_srs_cache.hpp"
+#include "utils/flat_coordinates.hpp"
+#include "utils/typed_array.hpp"
+
+#include <algorithm>
+#include <thread>
 
 namespace node_gdal {
 
@@ -17,6 +23,8 @@ void CoordinateTransformation::Initialize(Local<Object> target) {
 
   Nan::SetPrototypeMethod(lcons, "toString", toString);
   Nan::SetPrototypeMethod(lcons, "transformPoint", transformPoint);
+  Nan__SetPrototypeAsyncableMethod(lcons, "transformPoints", transformPoints);
+  Nan__SetPrototypeAsyncableMethod(lcons, "transformPointsInterleaved", transformPointsInterleaved);
 
   Nan::Set(target, Nan::New("CoordinateTransformation").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
 
@@ -80,7 +88,7 @@ NAN_METHOD(CoordinateTransformation::New) {
       // srs -> srs
       NODE_ARG_WRAPPED(1, "target", SpatialReference, target);
 
-      OGRCoordinateTransformation *transform = OGRCreateCoordinateTransformation(source->get(), target->get());
+      OGRCoordinateTransformation *transform = SRSCache::getCT(source->get(), target->get());
       if (!transform) {
         NODE_THROW_LAST_CPLERR;
         return;
@@ -203,4 +211,308 @@ NAN_METHOD(CoordinateTransformation::transformPoint) {
   info.GetReturnValue().Set(result);
 }
 
+// Points transformed by a single call of OGRCoordinateTransformation::Transform
+static const size_t transformBatchSize = 65536;
+
+// Minimum number of points that justifies a thread
+static const size_t transformThreadSize = 65536;
+
+// Transforms count points, z can be null
+static void transformBatch(OGRCoordinateTransformation *ct, size_t count, double *x, double *y, double *z, uint8_t *success) {
+  std::vector<int> flags(count);
+#if GDAL_VERSION_MAJOR >= 3
+  ct->Transform((int)count, x, y, z, nullptr, flags.data());
+#else
+  ct->TransformEx((int)count, x, y, z, flags.data());
+#endif
+  for (size_t i = 0; i < count; i++) success[i] = flags[i] ? 1 : 0;
+}
+
+// Splits [0, count) in chunks processed on a pool of threads
+// Coordinate transformations are not thread-safe, each thread gets its own copy
+// with its own PROJ context
+static void transformParallel(
+  OGRCoordinateTransformation *ct,
+  size_t count,
+  int threads,
+  const std::function<void(OGRCoordinateTransformation *, size_t, size_t)> &process) {
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
+  if (dynamic_cast<GeoTransformTransformer *>(ct) != nullptr) threads = 1;
+#else
+  threads = 1;
+#endif
+  threads = std::max(1, std::min(threads, (int)((count + transformThreadSize - 1) / transformThreadSize)));
+
+  size_t chunk = (count + threads - 1) / threads;
+  std::vector<std::thread> pool;
+  std::vector<OGRCoordinateTransformation *> cts;
+  for (int t = 1; t < threads; t++) {
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
+    OGRCoordinateTransformation *thread_ct = ct->Clone();
+    cts.push_back(thread_ct);
+    pool.push_back(std::thread(process, thread_ct, std::min(count, t * chunk), std::min(count, (t + 1) * chunk)));
+#endif
+  }
+  // The calling thread processes the first chunk
+  process(ct, 0, std::min(count, chunk));
+  for (auto &thread : pool) thread.join();
+  for (auto thread_ct : cts) OGRCoordinateTransformation::DestroyCT(thread_ct);
+}
+
+// Returns a Float64Array holding a copy of src
+static Local<Value> copyFloat64Array(Local<Value> src, size_t length) {
+  Nan::EscapableHandleScope scope;
+  Local<Value> dst = TypedArray::New(GDT_Float64, length);
+  if (dst.IsEmpty() || !dst->IsObject()) return scope.Escape(dst);
+  Nan::TypedArrayContents<double> src_contents(src);
+  Nan::TypedArrayContents<double> dst_contents(dst);
+  std::copy(*src_contents, *src_contents + length, *dst_contents);
+  return scope.Escape(dst);
+}
+
+/**
+ * @typedef TransformPointsOptions { inPlace?: boolean, threads?: number }
+ */
+
+/**
+ * @typedef TransformPointsResult { xs: Float64Array, ys: Float64Array, zs?: Float64Array, success: Uint8Array }
+ */
+
+/**
+ * Transform an array of points from source to destination space.
+ *
+ * The coordinates are transformed by a few calls of `OGRCoordinateTransformation::Transform`
+ * without creating a JS object per point, large arrays are split across threads.
+ * The points that cannot be transformed are signaled by a `0` in the `success` array,
+ * their coordinates are undefined.
+ *
+ * @example
+ * ```
+ * const r = transform.transformPoints(new Float64Array([ 2.35, 4.83 ]), new Float64Array([ 48.85, 52.37 ]));
+ * console.log(r.xs, r.ys, r.success);```
+ *
+ * @method transformPoints
+ * @param {Float64Array} xs
+ * @param {Float64Array} ys
+ * @param {Float64Array|null} [zs]
+ * @param {TransformPointsOptions} [options]
+ * @param {boolean} [options.inPlace=false] Transform the arrays in place instead of returning new arrays
+ * @param {number} [options.threads] Maximum number of threads, the number of CPUs by default
+ * @return {TransformPointsResult}
+ */
+
+/**
+ * Transform an array of points from source to destination space.
+ * {{{async}}}
+ *
+ * The arrays must not be modified before the operation completes.
+ *
+ * @method transformPointsAsync
+ * @param {Float64Array} xs
+ * @param {Float64Array} ys
+ * @param {Float64Array|null} [zs]
+ * @param {TransformPointsOptions} [options]
+ * @param {boolean} [options.inPlace=false] Transform the arrays in place instead of returning new arrays
+ * @param {number} [options.threads] Maximum number of threads, the number of CPUs by default
+ * @param {callback<TransformPointsResult>} [callback=undefined] {{{cb}}}
+ * @return {Promise<TransformPointsResult>}
+ */
+GDAL_ASYNCABLE_DEFINE(CoordinateTransformation::transformPoints) {
+  Nan::HandleScope scope;
+
+  CoordinateTransformation *transform = Nan::ObjectWrap::Unwrap<CoordinateTransformation>(info.This());
+  if (!transform->isAlive()) {
+    Nan::ThrowError("CoordinateTransformation object has already been destroyed");
+    return;
+  }
+
+  if (info.Length() < 2 || !info[0]->IsFloat64Array() || !info[1]->IsFloat64Array()) {
+    Nan::ThrowTypeError("xs and ys must be Float64Array");
+    return;
+  }
+  bool has_z = info.Length() > 2 && !info[2]->IsNull() && !info[2]->IsUndefined();
+  if (has_z && !info[2]->IsFloat64Array()) {
+    Nan::ThrowTypeError("zs must be a Float64Array");
+    return;
+  }
+  Local<Object> options = Nan::New<Object>();
+  bool in_place = false;
+  int threads = CPLGetNumCPUs();
+  NODE_ARG_OBJECT_OPT(3, "options", options);
+  NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+  Local<Value> in_place_val = Nan::Get(options, Nan::New("inPlace").ToLocalChecked()).ToLocalChecked();
+  if (!in_place_val->IsUndefined()) in_place = Nan::To<bool>(in_place_val).ToChecked();
+
+  size_t count = info[0].As<Float64Array>()->Length();
+  if (info[1].As<Float64Array>()->Length() != count || (has_z && info[2].As<Float64Array>()->Length() != count)) {
+    Nan::ThrowError("xs, ys and zs must have the same length");
+    return;
+  }
+
+  Local<Value> columns[3] = {info[0], info[1], has_z ? info[2] : Nan::Undefined().As<Value>()};
+  if (!in_place) {
+    for (int c = 0; c < (has_z ? 3 : 2); c++) {
+      columns[c] = copyFloat64Array(columns[c], count);
+      if (columns[c].IsEmpty() || !columns[c]->IsObject()) return; // TypedArray::New threw an error
+    }
+  }
+  Local<Value> success = TypedArray::New(GDT_Byte, count);
+  if (success.IsEmpty() || !success->IsObject()) return; // TypedArray::New threw an error
+
+  double *x = *Nan::TypedArrayContents<double>(columns[0]);
+  double *y = *Nan::TypedArrayContents<double>(columns[1]);
+  double *z = has_z ? *Nan::TypedArrayContents<double>(columns[2]) : nullptr;
+  uint8_t *flags = *Nan::TypedArrayContents<uint8_t>(success);
+
+  OGRCoordinateTransformation *ct = transform->get();
+  GDALAsyncableJob<int> job(0);
+  job.persist("xs", columns[0].As<Object>());
+  job.persist("ys", columns[1].As<Object>());
+  if (has_z) job.persist("zs", columns[2].As<Object>());
+  job.persist("success", success.As<Object>());
+  job.main = [ct, count, threads, x, y, z, flags](const GDALExecutionProgress &) {
+    transformParallel(ct, count, threads, [x, y, z, flags](OGRCoordinateTransformation *ct, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i += transformBatchSize) {
+        size_t n = std::min(transformBatchSize, end - i);
+        transformBatch(ct, n, x + i, y + i, z ? z + i : nullptr, flags + i);
+      }
+    });
+    return 0;
+  };
+  job.rval = [has_z](int, GetFromPersistentFunc getter) {
+    Nan::EscapableHandleScope scope;
+    Local<Object> result = Nan::New<Object>();
+    Nan::Set(result, Nan::New("xs").ToLocalChecked(), getter("xs"));
+    Nan::Set(result, Nan::New("ys").ToLocalChecked(), getter("ys"));
+    if (has_z) Nan::Set(result, Nan::New("zs").ToLocalChecked(), getter("zs"));
+    Nan::Set(result, Nan::New("success").ToLocalChecked(), getter("success"));
+    return scope.Escape(result);
+  };
+  job.run(info, async, 4);
+}
+
+/**
+ * @typedef TransformPointsInterleavedOptions { dims?: string, inPlace?: boolean, threads?: number }
+ */
+
+/**
+ * @typedef TransformPointsInterleavedResult { coords: Float64Array, success: Uint8Array }
+ */
+
+/**
+ * Transform an interleaved array of points from source to destination space.
+ *
+ * Same as {{#crossLink "gdal.CoordinateTransformation/transformPoints:method"}}{{/crossLink}}
+ * for a single `Float64Array` containing `x`, `y`, then optionally `z` and `m` for every point,
+ * `m` is left unchanged.
+ *
+ * @method transformPointsInterleaved
+ * @param {Float64Array} coords
+ * @param {TransformPointsInterleavedOptions} [options]
+ * @param {string} [options.dims="xy"] one of `xy`, `xyz`, `xym` or `xyzm`
+ * @param {boolean} [options.inPlace=false] Transform the array in place instead of returning a new array
+ * @param {number} [options.threads] Maximum number of threads, the number of CPUs by default
+ * @return {TransformPointsInterleavedResult}
+ */
+
+/**
+ * Transform an interleaved array of points from source to destination space.
+ * {{{async}}}
+ *
+ * The array must not be modified before the operation completes.
+ *
+ * @method transformPointsInterleavedAsync
+ * @param {Float64Array} coords
+ * @param {TransformPointsInterleavedOptions} [options]
+ * @param {string} [options.dims="xy"] one of `xy`, `xyz`, `xym` or `xyzm`
+ * @param {boolean} [options.inPlace=false] Transform the array in place instead of returning a new array
+ * @param {number} [options.threads] Maximum number of threads, the number of CPUs by default
+ * @param {callback<TransformPointsInterleavedResult>} [callback=undefined] {{{cb}}}
+ * @return {Promise<TransformPointsInterleavedResult>}
+ */
+GDAL_ASYNCABLE_DEFINE(CoordinateTransformation::transformPointsInterleaved) {
+  Nan::HandleScope scope;
+
+  CoordinateTransformation *transform = Nan::ObjectWrap::Unwrap<CoordinateTransformation>(info.This());
+  if (!transform->isAlive()) {
+    Nan::ThrowError("CoordinateTransformation object has already been destroyed");
+    return;
+  }
+
+  if (info.Length() < 1 || !info[0]->IsFloat64Array()) {
+    Nan::ThrowTypeError("coords must be a Float64Array");
+    return;
+  }
+  Local<Object> options = Nan::New<Object>();
+  bool in_place = false;
+  int threads = CPLGetNumCPUs();
+  std::string dims_name = "";
+  FlatCoordinates::Dims dims = {false, false};
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+  NODE_STR_FROM_OBJ_OPT(options, "dims", dims_name);
+  if (!dims_name.empty() && !FlatCoordinates::Parse(dims_name, dims)) {
+    Nan::ThrowError("dims must be one of xy, xyz, xym or xyzm");
+    return;
+  }
+  Local<Value> in_place_val = Nan::Get(options, Nan::New("inPlace").ToLocalChecked()).ToLocalChecked();
+  if (!in_place_val->IsUndefined()) in_place = Nan::To<bool>(in_place_val).ToChecked();
+
+  size_t length = info[0].As<Float64Array>()->Length();
+  int stride = dims.stride();
+  if (length % stride != 0) {
+    Nan::ThrowError("coordinates length must be a multiple of the number of dimensions");
+    return;
+  }
+  size_t count = length / stride;
+
+  Local<Value> coords = in_place ? info[0] : copyFloat64Array(info[0], length);
+  if (coords.IsEmpty() || !coords->IsObject()) return; // TypedArray::New threw an error
+  Local<Value> success = TypedArray::New(GDT_Byte, count);
+  if (success.IsEmpty() || !success->IsObject()) return; // TypedArray::New threw an error
+
+  double *data = *Nan::TypedArrayContents<double>(coords);
+  uint8_t *flags = *Nan::TypedArrayContents<uint8_t>(success);
+  bool has_z = dims.z;
+
+  OGRCoordinateTransformation *ct = transform->get();
+  GDALAsyncableJob<int> job(0);
+  job.persist("coords", coords.As<Object>());
+  job.persist("success", success.As<Object>());
+  job.main = [ct, count, threads, data, stride, has_z, flags](const GDALExecutionProgress &) {
+    transformParallel(
+      ct, count, threads, [data, stride, has_z, flags](OGRCoordinateTransformation *ct, size_t begin, size_t end) {
+        std::vector<double> x, y, z;
+        for (size_t i = begin; i < end; i += transformBatchSize) {
+          size_t n = std::min(transformBatchSize, end - i);
+          x.resize(n);
+          y.resize(n);
+          if (has_z) z.resize(n);
+          double *point = data + i * stride;
+          for (size_t j = 0; j < n; j++, point += stride) {
+            x[j] = point[0];
+            y[j] = point[1];
+            if (has_z) z[j] = point[2];
+          }
+          transformBatch(ct, n, x.data(), y.data(), has_z ? z.data() : nullptr, flags + i);
+          point = data + i * stride;
+          for (size_t j = 0; j < n; j++, point += stride) {
+            point[0] = x[j];
+            point[1] = y[j];
+            if (has_z) point[2] = z[j];
+          }
+        }
+      });
+    return 0;
+  };
+  job.rval = [](int, GetFromPersistentFunc getter) {
+    Nan::EscapableHandleScope scope;
+    Local<Object> result = Nan::New<Object>();
+    Nan::Set(result, Nan::New("coords").ToLocalChecked(), getter("coords"));
+    Nan::Set(result, Nan::New("success").ToLocalChecked(), getter("success"));
+    return scope.Escape(result);
+  };
+  job.run(info, async, 2);
+}
+
 } // namespace node_gdal
@@ -14,6 +14,8 @@
 // gdal
 #include <gdalwarper.h>
 
+#include "async.hpp"
+
 using namespace v8;
 using namespace node;
 
@@ -29,6 +31,8 @@ class CoordinateTransformation : public Nan::ObjectWrap {
   static Local<Value> New(OGRCoordinateTransformation *transform);
   static NAN_METHOD(toString);
   static NAN_METHOD(transformPoint);
+  GDAL_ASYNCABLE_DECLARE(transformPoints);
+  GDAL_ASYNCABLE_DECLARE(transformPointsInterleaved);
 
   CoordinateTransformation();
   CoordinateTransformation(OGRCoordinateTransformation *srs);
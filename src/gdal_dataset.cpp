@@ -9,6 +9,7 @@
 #include "gdal_majorobject.hpp"
 #include "gdal_rasterband.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "gdal_vsistats.hpp"
 
 namespace node_gdal {
 
@@ -26,14 +27,18 @@ void Dataset::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "getGCPs", getGCPs);
   Nan::SetPrototypeMethod(lcons, "getGCPProjection", getGCPProjection);
   Nan::SetPrototypeMethod(lcons, "getFileList", getFileList);
+  Nan::SetPrototypeMethod(lcons, "ioStats", ioStats);
   Nan__SetPrototypeAsyncableMethod(lcons, "flush", flush);
-  Nan::SetPrototypeMethod(lcons, "close", close);
+  Nan__SetPrototypeAsyncableMethod(lcons, "dropCache", dropCache);
+  Nan__SetPrototypeAsyncableMethod(lcons, "close", close);
   Nan::SetPrototypeMethod(lcons, "getMetadata", getMetadata);
   Nan::SetPrototypeMethod(lcons, "testCapability", testCapability);
   Nan__SetPrototypeAsyncableMethod(lcons, "executeSQL", executeSQL);
+  Nan__SetPrototypeAsyncableMethod(lcons, "releaseResultSet", releaseResultSet);
   Nan__SetPrototypeAsyncableMethod(lcons, "buildOverviews", buildOverviews);
 
   ATTR_DONT_ENUM(lcons, "_uid", uidGetter, READ_ONLY_SETTER);
+  ATTR_DONT_ENUM(lcons, "_alive", aliveGetter, READ_ONLY_SETTER);
   ATTR(lcons, "description", descriptionGetter, READ_ONLY_SETTER);
   ATTR(lcons, "bands", bandsGetter, READ_ONLY_SETTER);
   ATTR(lcons, "layers", layersGetter, READ_ONLY_SETTER);
@@ -145,10 +150,27 @@ Local<Value> Dataset::New(GDALDataset *raw, GDALDataset *parent) {
     Nan::NewInstance(Nan::GetFunction(Nan::New(Dataset::constructor)).ToLocalChecked(), 1, &ext).ToLocalChecked();
 
   wrapped->uid = object_store.add(raw, wrapped->persistent(), parent_uid);
+  object_store.setSize<GDALDataset *>(wrapped->uid, estimateSize(raw));
 
   return scope.Escape(obj);
 }
 
+// The pixels of the MEM driver live in the process heap,
+// the other drivers use the block cache which has its own limit
+int64_t Dataset::estimateSize(GDALDataset *raw) {
+  GDALDriver *driver = raw->GetDriver();
+  bool in_memory = driver != nullptr && !strcmp(driver->GetDescription(), "MEM");
+  int64_t size = sizeof(GDALDataset);
+  for (int i = 1; i <= raw->GetRasterCount(); i++) {
+    GDALRasterBand *band = raw->GetRasterBand(i);
+    size += sizeof(GDALRasterBand);
+    if (in_memory)
+      size += static_cast<int64_t>(band->GetXSize()) * band->GetYSize() *
+        GDALGetDataTypeSizeBytes(band->GetRasterDataType());
+  }
+  return size;
+}
+
 NAN_METHOD(Dataset::toString) {
   Nan::HandleScope scope;
   info.GetReturnValue().Set(Nan::New("Dataset").ToLocalChecked());
@@ -173,7 +195,7 @@ NAN_METHOD(Dataset::getMetadata) {
   GDALDataset *raw = ds->get();
   std::string domain("");
   NODE_ARG_OPT_STR(0, "domain", domain);
-  AsyncGuard lock({ds->uid}, eventLoopWarn);
+  GDAL_LOCK_DATASET(ds);
   info.GetReturnValue().Set(MajorObject::getMetadata(raw, domain.empty() ? NULL : domain.c_str()));
 }
 
@@ -199,7 +221,7 @@ NAN_METHOD(Dataset::testCapability) {
   std::string capability("");
   NODE_ARG_STR(0, "capability", capability);
 
-  AsyncGuard lock({ds->uid}, eventLoopWarn);
+  GDAL_LOCK_DATASET(ds);
   info.GetReturnValue().Set(Nan::New<Boolean>(raw->TestCapability(capability.c_str())));
 }
 
@@ -219,7 +241,7 @@ NAN_METHOD(Dataset::getGCPProjection) {
   }
 
   GDALDataset *raw = ds->get();
-  AsyncGuard lock({ds->uid}, eventLoopWarn);
+  GDAL_LOCK_DATASET(ds);
   info.GetReturnValue().Set(SafeString::New(raw->GetGCPProjection()));
 }
 
@@ -230,28 +252,75 @@ NAN_METHOD(Dataset::getGCPProjection) {
  * except if there is an operation running on this dataset in asynchronous context - in this case
  * this call will block until that operation finishes.
  *
+ * Closing a dataset that was written to can also trigger a large flush of its data.
+ *
  * If this could potentially be the case and blocking the event loop is not possible (server code),
- * then the best option is to simply dereference it (ds = null) and leave
- * the garbage collector to expire it.
- * 
- * Implementing an asynchronous delete is difficult since all V8 object creation/deletion
- * must take place on the main thread.
+ * then closeAsync() should be used instead.
  * 
  * flush[Async]() ensures that, when writing, all data has been written.
  *
  * @method close
  */
-NAN_METHOD(Dataset::close) {
-  Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(info.This());
 
-  if (!ds->isAlive()) {
-    Nan::ThrowError("Dataset object has already been destroyed");
+/**
+ * Closes the dataset to further operations. It releases all memory and ressources held
+ * by the dataset.
+ * {{{async}}}
+ *
+ * The dataset and all its bands and layers become unusable immediately,
+ * while the operations already running on it, the flushing of its data and
+ * the closing itself take place on a worker thread.
+ *
+ * The returned Promise is rejected if GDAL reports an error while closing,
+ * the dataset is closed in all cases.
+ *
+ * On the runtimes that support explicit resource management, `await using ds = ...`
+ * calls it at the end of the block and `using ds = ...` calls close().
+ *
+ * @method closeAsync
+ * @throws Error
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Dataset::close) {
+  Nan::HandleScope scope;
+  NODE_UNWRAP_CHECK(Dataset, info.This(), ds);
+
+  if (!async) {
+    ds->dispose();
     return;
   }
 
-  ds->dispose();
+  // The child datasets (if any) come first
+  std::shared_ptr<std::vector<DetachedDataset>> detached(new std::vector<DetachedDataset>);
+  if (!object_store.detachDataset(ds->uid, *detached)) {
+    Nan::ThrowError("Dataset object has already been destroyed");
+    return;
+  }
+  ds->this_dataset = nullptr;
 
-  return;
+  GDALAsyncableJob<int> job(0);
+  job.persist(info.This());
+  job.main = [detached](const GDALExecutionProgress &) {
+    CPLErrorReset();
+    bool failed = false;
+    std::string error;
+    for (const DetachedDataset &item : *detached) {
+      // Wait for the operations that are already running
+      object_store.lockDataset(item.async_lock);
+      for (OGRLayer *layer : item.result_sets) item.ptr->ReleaseResultSet(layer);
+      GDALClose(item.ptr);
+      object_store.unlockDataset(item.async_lock);
+      if (!failed && CPLGetLastErrorType() == CE_Failure) {
+        failed = true;
+        error = CPLGetLastErrorMsg();
+      }
+    }
+    if (failed) throw CPLSPrintf("%s", error.c_str());
+    return 0;
+  };
+  job.rval = [](int, GetFromPersistentFunc) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 0);
 }
 
 /**
@@ -285,6 +354,47 @@ GDAL_ASYNCABLE_DEFINE(Dataset::flush) {
   return;
 }
 
+/**
+ * Removes all the blocks of the dataset from the block cache, writing the modified ones first.
+ *
+ * Allows to release the memory used by a large one-off operation
+ * without waiting for the blocks to be evicted by other datasets.
+ *
+ * @throws Error
+ * @method dropCache
+ */
+
+/**
+ * Removes all the blocks of the dataset from the block cache, writing the modified ones first.
+ * {{{async}}}
+ *
+ * @method dropCacheAsync
+ * @throws Error
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Dataset::dropCache) {
+  Nan::HandleScope scope;
+  NODE_UNWRAP_CHECK(Dataset, info.This(), ds);
+  GDAL_RAW_CHECK(GDALDataset *, ds, raw);
+  GDALAsyncableJob<int> job(ds->uid);
+  job.main = [raw](const GDALExecutionProgress &) {
+    // Flushing a band writes its dirty blocks and frees all of its blocks
+    for (int i = 1; i <= raw->GetRasterCount(); i++) {
+      GDALRasterBand *band = raw->GetRasterBand(i);
+      band->FlushCache();
+      for (int j = 0; j < band->GetOverviewCount(); j++) {
+        GDALRasterBand *overview = band->GetOverview(j);
+        if (overview != nullptr) overview->FlushCache();
+      }
+    }
+    raw->FlushCache();
+    return 0;
+  };
+  job.rval = [](int, GetFromPersistentFunc) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 0);
+}
+
 /**
  * Execute an SQL statement against the data store.
  *
@@ -350,6 +460,72 @@ GDAL_ASYNCABLE_DEFINE(Dataset::executeSQL) {
   job.run(info, async, 3);
 }
 
+/**
+ * Releases the results of an SQL statement returned by `executeSQL()`.
+ *
+ * The result set is also released when the `gdal.Layer` object is
+ * garbage-collected, calling this method allows to free it immediately
+ * and without blocking the garbage collector when the dataset is in use.
+ * The layer can not be used anymore once this method has been called.
+ *
+ * @throws Error
+ * @method releaseResultSet
+ * @param {gdal.Layer} layer result set returned by `executeSQL()`
+ */
+
+/**
+ * Releases the results of an SQL statement returned by `executeSQL()`.
+ *
+ * The result set is also released when the `gdal.Layer` object is
+ * garbage-collected, calling this method allows to free it immediately
+ * and without blocking the garbage collector when the dataset is in use.
+ * The layer can not be used anymore once this method has been called.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method releaseResultSetAsync
+ * @param {gdal.Layer} layer result set returned by `executeSQL()`
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Dataset::releaseResultSet) {
+  Nan::HandleScope scope;
+  Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(info.This());
+
+  if (!ds->isAlive()) {
+    Nan::ThrowError("Dataset object has already been destroyed");
+    return;
+  }
+
+  Layer *layer;
+  NODE_ARG_WRAPPED(0, "layer", Layer, layer);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object has already been destroyed");
+    return;
+  }
+  if (layer->parent_uid != ds->uid) {
+    Nan::ThrowError("Layer does not belong to this Dataset");
+    return;
+  }
+
+  GDALDataset *raw = ds->get();
+  OGRLayer *gdal_layer = layer->get();
+  // From this point the Layer is not alive anymore and the GC won't try to release it
+  if (!object_store.detachResultSet(layer->uid)) {
+    Nan::ThrowError("Layer is not an SQL result set");
+    return;
+  }
+
+  GDALAsyncableJob<int> job(ds->uid);
+  job.persist(layer->handle());
+  job.main = [raw, gdal_layer](const GDALExecutionProgress &) {
+    raw->ReleaseResultSet(gdal_layer);
+    return 0;
+  };
+  job.rval = [](int, GetFromPersistentFunc) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 1);
+}
+
 /**
  * Fetch files forming dataset.
  *
@@ -379,7 +555,7 @@ NAN_METHOD(Dataset::getFileList) {
     return;
   }
 
-  AsyncGuard lock({ds->uid}, eventLoopWarn);
+  GDAL_LOCK_DATASET(ds);
   char **list = raw->GetFileList();
   if (!list) {
     info.GetReturnValue().Set(results);
@@ -397,6 +573,38 @@ NAN_METHOD(Dataset::getFileList) {
   info.GetReturnValue().Set(results);
 }
 
+/**
+ * Get the I/O statistics of the files forming the dataset.
+ *
+ * Only the files opened through the `/vsistats/` chaining file system are
+ * counted, see {{#crossLink "vsistats"}}gdal.vsistats{{/crossLink}}.
+ *
+ * The files are matched by the name of the dataset: `file.shp` includes
+ * all the `file.*` side-car files and a directory includes all of its files.
+ * This does not lock the dataset and can be called while it is used by an async operation.
+ *
+ * @method ioStats
+ * @return {VSIStats}
+ */
+NAN_METHOD(Dataset::ioStats) {
+  Nan::HandleScope scope;
+  Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(info.This());
+
+  if (!ds->isAlive()) {
+    Nan::ThrowError("Dataset object has already been destroyed");
+    return;
+  }
+
+  GDALDataset *raw = ds->get();
+  if (!raw) {
+    Nan::ThrowError("Dataset object has already been destroyed");
+    return;
+  }
+
+  // GetFileList() would require the dataset lock and it can do I/O on its own
+  info.GetReturnValue().Set(VSIStats::dataset(raw->GetDescription()).toObject());
+}
+
 /**
  * Fetches GCPs.
  *
@@ -420,7 +628,7 @@ NAN_METHOD(Dataset::getGCPs) {
     return;
   }
 
-  AsyncGuard lock({ds->uid}, eventLoopWarn);
+  GDAL_LOCK_DATASET(ds);
   int n = raw->GetGCPCount();
   const GDAL_GCP *gcps = raw->GetGCPs();
 
@@ -499,7 +707,7 @@ NAN_METHOD(Dataset::setGCPs) {
     gcp++;
   }
 
-  AsyncGuard lock({ds->uid}, eventLoopWarn);
+  GDAL_LOCK_DATASET(ds);
   CPLErr err = raw->SetGCPs(gcps->Length(), list.get(), projection.c_str());
 
   if (err) {
@@ -631,7 +839,7 @@ NAN_GETTER(Dataset::descriptionGetter) {
     Nan::ThrowError("Dataset object has already been destroyed");
     return;
   }
-  AsyncGuard lock({ds->uid}, eventLoopWarn);
+  GDAL_LOCK_DATASET(ds);
   info.GetReturnValue().Set(SafeString::New(raw->GetDescription()));
 }
 
@@ -858,7 +1066,7 @@ NAN_SETTER(Dataset::srsSetter) {
     return;
   }
 
-  AsyncGuard lock({ds->uid}, eventLoopWarn);
+  GDAL_LOCK_DATASET(ds);
   CPLErr err = raw->SetProjection(wkt.c_str());
 
   if (err) { NODE_THROW_LAST_CPLERR; }
@@ -896,7 +1104,7 @@ NAN_SETTER(Dataset::geoTransformSetter) {
     buffer[i] = Nan::To<double>(val).ToChecked();
   }
 
-  AsyncGuard lock({ds->uid}, eventLoopWarn);
+  GDAL_LOCK_DATASET(ds);
   CPLErr err = raw->SetGeoTransform(buffer);
 
   if (err) { NODE_THROW_LAST_CPLERR; }
@@ -934,7 +1142,7 @@ NAN_GETTER(Dataset::rootGetter) {
 #if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
     NODE_UNWRAP_CHECK(Dataset, info.This(), ds);
     GDAL_RAW_CHECK(GDALDataset *, ds, gdal_ds);
-    AsyncGuard lock({ds->uid}, eventLoopWarn);
+    GDAL_LOCK_DATASET(ds);
     std::shared_ptr<GDALGroup> root = gdal_ds->GetRootGroup();
     if (root == nullptr) {
 #endif
@@ -955,4 +1163,10 @@ NAN_GETTER(Dataset::uidGetter) {
   info.GetReturnValue().Set(Nan::New((int)ds->uid));
 }
 
+NAN_GETTER(Dataset::aliveGetter) {
+  Nan::HandleScope scope;
+  Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(info.This());
+  info.GetReturnValue().Set(Nan::New<Boolean>(ds->isAlive()));
+}
+
 } // namespace node_gdal
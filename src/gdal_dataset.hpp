@@ -33,15 +33,18 @@ class Dataset : public Nan::ObjectWrap {
   static Local<Value> New(GDALDataset *ds, GDALDataset *parent = nullptr);
   static NAN_METHOD(toString);
   GDAL_ASYNCABLE_DECLARE(flush);
+  GDAL_ASYNCABLE_DECLARE(dropCache);
   static NAN_METHOD(getMetadata);
   static NAN_METHOD(getFileList);
+  static NAN_METHOD(ioStats);
   static NAN_METHOD(getGCPProjection);
   static NAN_METHOD(getGCPs);
   static NAN_METHOD(setGCPs);
   GDAL_ASYNCABLE_DECLARE(executeSQL);
+  GDAL_ASYNCABLE_DECLARE(releaseResultSet);
   static NAN_METHOD(testCapability);
   GDAL_ASYNCABLE_DECLARE(buildOverviews);
-  static NAN_METHOD(close);
+  GDAL_ASYNCABLE_DECLARE(close);
 
   static NAN_GETTER(bandsGetter);
   GDAL_ASYNCABLE_GETTER_DECLARE(rasterSizeGetter);
@@ -52,6 +55,7 @@ class Dataset : public Nan::ObjectWrap {
   static NAN_GETTER(layersGetter);
   static NAN_GETTER(rootGetter);
   static NAN_GETTER(uidGetter);
+  static NAN_GETTER(aliveGetter);
 
   static NAN_SETTER(srsSetter);
   static NAN_SETTER(geoTransformSetter);
@@ -65,6 +69,9 @@ class Dataset : public Nan::ObjectWrap {
   long uid;
   long parent_uid;
 
+  // Estimated native size, must be called with the dataset locked
+  static int64_t estimateSize(GDALDataset *raw);
+
   inline bool isAlive() {
     return this_dataset && object_store.isAlive(uid);
   }
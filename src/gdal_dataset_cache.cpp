@@ -0,0 +1,230 @@
+#include "gdal_dataset_cache.hpp"
+#include "gdal_common.hpp"
+#include "gdal_dataset.hpp"
+
+namespace node_gdal {
+
+/**
+ * @for gdal
+ * @property datasetCache
+ * @type {datasetCache}
+ */
+
+/**
+ * Statistics and control of the cache of open datasets used by `gdal.openCached()`
+ *
+ * @class datasetCache
+ */
+
+// Never freed, the datasets must not be closed at exit by a static destructor
+LRUCache<std::string, DatasetCache::Entry> *DatasetCache::cache =
+  new LRUCache<std::string, DatasetCache::Entry>(64, DatasetCache::evict);
+uint64_t DatasetCache::ttl = 0;
+uint64_t DatasetCache::hits = 0;
+uint64_t DatasetCache::misses = 0;
+uint64_t DatasetCache::evictions = 0;
+
+void DatasetCache::Initialize(Local<Object> target) {
+  Nan__SetAsyncableMethod(target, "openCached", openCached);
+
+  Local<Object> datasetCache = Nan::New<Object>();
+  Nan::Set(target, Nan::New("datasetCache").ToLocalChecked(), datasetCache);
+  Nan::SetMethod(datasetCache, "stats", stats);
+  Nan::SetMethod(datasetCache, "clear", clear);
+}
+
+// The Dataset can still be used by its other holders and by async jobs,
+// it is closed by the GC once it is not referenced anymore
+void DatasetCache::evict(Entry &entry) {
+  evictions++;
+  entry.obj->Reset();
+  delete entry.obj;
+}
+
+// The expiration is lazy, it happens on the next access
+void DatasetCache::expire() {
+  if (ttl == 0) return;
+  uint64_t now = uv_now(Nan::GetCurrentEventLoop());
+  while (cache->size() > 0 && cache->list().back().second.used + ttl < now) cache->erase(cache->list().back().first);
+}
+
+// Two concurrent misses on the same key can open the same dataset twice,
+// the first one to complete wins
+Local<Value> DatasetCache::insert(const std::string &key, Local<Value> obj) {
+  Entry *entry = cache->get(key);
+  if (entry != nullptr) {
+    Dataset *cached = Nan::ObjectWrap::Unwrap<Dataset>(Nan::New(*entry->obj));
+    if (cached->isAlive()) {
+      Nan::ObjectWrap::Unwrap<Dataset>(obj.As<Object>())->dispose();
+      return Nan::New(*entry->obj);
+    }
+  }
+  cache->put(key, {new Nan::Persistent<Object>(obj.As<Object>()), uv_now(Nan::GetCurrentEventLoop())});
+  return obj;
+}
+
+/**
+ * @typedef OpenCachedOptions { maxOpen?: number, ttl?: number }
+ */
+
+/**
+ * Opens a dataset through a process-wide LRU cache of open datasets.
+ *
+ * Successive calls with the same path and mode return the same `gdal.Dataset` object
+ * without reopening the file and parsing again its headers.
+ *
+ * The least recently used datasets are removed from the cache when it is full or when they expire.
+ * The cache never closes a dataset: a removed dataset remains usable by those who still hold it,
+ * including the running async operations, and it is closed by the garbage collector once it
+ * is not referenced anymore. `maxOpen` limits the datasets kept open by the cache itself.
+ *
+ * A cached dataset is shared by all the callers, none of them should close it
+ * while the others are still using it - in this case the next call reopens it.
+ *
+ * @example
+ * ```
+ * const ds = await gdal.openCachedAsync('data.tif', 'r', { maxOpen: 256, ttl: 60000 });
+ * const data = await (await ds.bands.getAsync(1)).pixels.readAsync(0, 0, 256, 256);
+ * ```
+ *
+ * @throws Error
+ * @method openCached
+ * @static
+ * @for gdal
+ * @param {string} path Path to dataset
+ * @param {string} [mode="r"] The mode to use to open the file: `"r"`, `"r+"` or `"m"`
+ * @param {OpenCachedOptions} [options] Cache settings, the most recent values apply to the whole cache
+ * @param {number} [options.maxOpen=64] Maximum number of datasets kept by the cache
+ * @param {number} [options.ttl=0] Remove the datasets that have not been accessed during this number of milliseconds, 0 for no expiration
+ * @return {gdal.Dataset}
+ */
+
+/**
+ * Opens a dataset through a process-wide LRU cache of open datasets.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method openCachedAsync
+ * @static
+ * @for gdal
+ * @param {string} path Path to dataset
+ * @param {string} [mode="r"] The mode to use to open the file: `"r"`, `"r+"` or `"m"`
+ * @param {OpenCachedOptions} [options] Cache settings, the most recent values apply to the whole cache
+ * @param {number} [options.maxOpen=64] Maximum number of datasets kept by the cache
+ * @param {number} [options.ttl=0] Remove the datasets that have not been accessed during this number of milliseconds, 0 for no expiration
+ * @param {callback<gdal.Dataset>} [callback=undefined] {{{cb}}}
+ * @return {Promise<gdal.Dataset>}
+ */
+GDAL_ASYNCABLE_DEFINE(DatasetCache::openCached) {
+  Nan::HandleScope scope;
+
+  std::string path;
+  std::string mode = "r";
+  Local<Object> options;
+
+  NODE_ARG_STR(0, "path", path);
+  NODE_ARG_OPT_STR(1, "mode", mode);
+  NODE_ARG_OBJECT_OPT(2, "options", options);
+
+  unsigned int flags;
+  if (mode == "r")
+    flags = GDAL_OF_READONLY;
+  else if (mode == "r+")
+    flags = GDAL_OF_UPDATE;
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
+  else if (mode == "m")
+    flags = GDAL_OF_MULTIDIM_RASTER;
+#endif
+  else {
+    Nan::ThrowError("Invalid open mode. Must be \"r\", \"r+\" or \"m\"");
+    return;
+  }
+  flags |= GDAL_OF_VERBOSE_ERROR;
+
+  if (!options.IsEmpty()) {
+    int maxOpen = static_cast<int>(cache->getMax());
+    double ttl_ms = static_cast<double>(ttl);
+    NODE_INT_FROM_OBJ_OPT(options, "maxOpen", maxOpen);
+    NODE_DOUBLE_FROM_OBJ_OPT(options, "ttl", ttl_ms);
+    if (maxOpen < 1) {
+      Nan::ThrowRangeError("maxOpen must be greater than 0");
+      return;
+    }
+    if (ttl_ms < 0) {
+      Nan::ThrowRangeError("ttl must not be negative");
+      return;
+    }
+    ttl = static_cast<uint64_t>(ttl_ms);
+    cache->setMax(maxOpen);
+  }
+
+  expire();
+
+  std::string key = mode + ":" + path;
+  Entry *entry = cache->get(key);
+  if (entry != nullptr) {
+    Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(Nan::New(*entry->obj));
+    if (ds->isAlive()) {
+      hits++;
+      entry->used = uv_now(Nan::GetCurrentEventLoop());
+      // No GDAL work and no locking, this job only delivers the result
+      GDALAsyncableJob<GDALDataset *> job(0);
+      job.persist("ds", Nan::New(*entry->obj));
+      job.main = [](const GDALExecutionProgress &) { return static_cast<GDALDataset *>(nullptr); };
+      job.rval = [](GDALDataset *, GetFromPersistentFunc getter) { return getter("ds"); };
+      job.run(info, async, 3);
+      return;
+    }
+    // Closed by the user
+    cache->erase(key);
+  }
+
+  misses++;
+  GDALAsyncableJob<GDALDataset *> job(0);
+  job.main = [path, flags](const GDALExecutionProgress &) {
+    GDALDataset *ds = GDALDataset::FromHandle(GDALOpenEx(path.c_str(), flags, nullptr, nullptr, nullptr));
+    if (!ds) throw CPLGetLastErrorMsg();
+    return ds;
+  };
+  job.rval = [key](GDALDataset *ds, GetFromPersistentFunc) { return insert(key, Dataset::New(ds)); };
+  job.run(info, async, 3);
+}
+
+/**
+ * @typedef DatasetCacheStats { hits: number, misses: number, evictions: number, size: number, maxOpen: number, ttl: number }
+ */
+
+/**
+ * Returns the cache statistics.
+ *
+ * @static
+ * @method stats
+ * @return {DatasetCacheStats}
+ */
+NAN_METHOD(DatasetCache::stats) {
+  expire();
+
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("hits").ToLocalChecked(), Nan::New<Number>(static_cast<double>(hits)));
+  Nan::Set(result, Nan::New("misses").ToLocalChecked(), Nan::New<Number>(static_cast<double>(misses)));
+  Nan::Set(result, Nan::New("evictions").ToLocalChecked(), Nan::New<Number>(static_cast<double>(evictions)));
+  Nan::Set(result, Nan::New("size").ToLocalChecked(), Nan::New<Number>(static_cast<double>(cache->size())));
+  Nan::Set(result, Nan::New("maxOpen").ToLocalChecked(), Nan::New<Number>(static_cast<double>(cache->getMax())));
+  Nan::Set(result, Nan::New("ttl").ToLocalChecked(), Nan::New<Number>(static_cast<double>(ttl)));
+  info.GetReturnValue().Set(result);
+}
+
+/**
+ * Removes all the datasets from the cache, they are closed by the garbage collector
+ * once they are not referenced anymore or by calling their `close()` method
+ *
+ * @static
+ * @method clear
+ * @return {void}
+ */
+NAN_METHOD(DatasetCache::clear) {
+  cache->clear();
+  expire();
+}
+
+} // namespace node_gdal
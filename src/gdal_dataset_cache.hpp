@@ -0,0 +1,50 @@
+#ifndef __NODE_GDAL_DATASET_CACHE_H__
+#define __NODE_GDAL_DATASET_CACHE_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// gdal
+#include <gdal_priv.h>
+
+#include <string>
+
+#include "async.hpp"
+#include "utils/lru_cache.hpp"
+
+using namespace v8;
+
+namespace node_gdal {
+
+// A cache of open datasets shared between all the callers of gdal.openCached()
+//
+// It lives entirely on the main thread and it never closes a Dataset, an evicted Dataset
+// loses only the reference held by the cache and it is closed by the GC like any other
+class DatasetCache {
+    public:
+  static void Initialize(Local<Object> target);
+  GDAL_ASYNCABLE_DECLARE(openCached);
+  static NAN_METHOD(stats);
+  static NAN_METHOD(clear);
+
+    private:
+  struct Entry {
+    Nan::Persistent<Object> *obj;
+    // Last access, in event loop time (ms)
+    uint64_t used;
+  };
+
+  static void evict(Entry &entry);
+  static void expire();
+  static Local<Value> insert(const std::string &key, Local<Value> obj);
+
+  static LRUCache<std::string, Entry> *cache;
+  static uint64_t ttl;
+  static uint64_t hits, misses, evictions;
+};
+
+} // namespace node_gdal
+#endif
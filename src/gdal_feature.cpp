@@ -20,9 +20,10 @@ void Feature::Initialize(Local<Object> target) {
 
   Nan::SetPrototypeMethod(lcons, "toString", toString);
   Nan::SetPrototypeMethod(lcons, "getGeometry", getGeometry);
+  Nan::SetPrototypeMethod(lcons, "borrowGeometry", borrowGeometry);
   // Nan::SetPrototypeMethod(lcons, "setGeometryDirectly", setGeometryDirectly);
   Nan::SetPrototypeMethod(lcons, "setGeometry", setGeometry);
-  // Nan::SetPrototypeMethod(lcons, "stealGeometry", stealGeometry);
+  Nan::SetPrototypeMethod(lcons, "stealGeometry", stealGeometry);
   Nan::SetPrototypeMethod(lcons, "clone", clone);
   // Nan::SetPrototypeMethod(lcons, "equals", equals);
   // Nan::SetPrototypeMethod(lcons, "getFieldDefn", getFieldDefn); (use
@@ -30,8 +31,6 @@ void Feature::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "setFrom", setFrom);
 
   // Note: This is used mainly for testing
-  // TODO: Give node more info on the amount of memory a feature is using
-  //      Nan::AdjustExternalMemory()
   Nan::SetPrototypeMethod(lcons, "destroy", destroy);
 
   ATTR(lcons, "fields", fieldsGetter, READ_ONLY_SETTER);
@@ -43,11 +42,15 @@ void Feature::Initialize(Local<Object> target) {
   constructor.Reset(lcons);
 }
 
-Feature::Feature(OGRFeature *feature) : Nan::ObjectWrap(), this_(feature), owned_(true) {
+size_t Feature::live_count = 0;
+int64_t Feature::live_size = 0;
+
+Feature::Feature(OGRFeature *feature) : Nan::ObjectWrap(), this_(feature), owned_(true), size_(0) {
   LOG("Created Feature[%p]", feature);
+  live_count++;
 }
 
-Feature::Feature() : Nan::ObjectWrap(), this_(0), owned_(true) {
+Feature::Feature() : Nan::ObjectWrap(), this_(0), owned_(true), size_(0) {
 }
 
 Feature::~Feature() {
@@ -57,10 +60,62 @@ Feature::~Feature() {
 void Feature::dispose() {
   if (this_) {
     LOG("Disposing Feature [%p] (%s)", this_, owned_ ? "owned" : "unowned");
+    detachBorrowedGeometry();
     if (owned_) OGRFeature::DestroyFeature(this_);
     LOG("Disposed Feature [%p]", this_);
     this_ = NULL;
+    live_count--;
+    live_size -= size_;
+    adjustExternalMemory(-size_);
+    size_ = 0;
+  }
+}
+
+// Only the features owned by their wrapper are reported
+void Feature::updateSize() {
+  int64_t size = this_ && owned_ ? estimateSize(this_) : 0;
+  int64_t delta = size - size_;
+  if (size_ != 0 && delta > -NATIVE_SIZE_THRESHOLD && delta < NATIVE_SIZE_THRESHOLD) return;
+  size_ = size;
+  live_size += delta;
+  adjustExternalMemory(delta);
+}
+
+int64_t Feature::estimateSize(OGRFeature *feature) {
+  int n = feature->GetFieldCount();
+  int64_t size = sizeof(OGRFeature) + n * sizeof(OGRField);
+  for (int i = 0; i < n; i++) {
+    if (!feature->IsFieldSetAndNotNull(i)) continue;
+    const OGRField *field = feature->GetRawFieldRef(i);
+    switch (feature->GetFieldDefnRef(i)->GetType()) {
+      case OFTString: size += strlen(field->String) + 1; break;
+      case OFTIntegerList: size += field->IntegerList.nCount * sizeof(int); break;
+      case OFTInteger64List: size += field->Integer64List.nCount * sizeof(GIntBig); break;
+      case OFTRealList: size += field->RealList.nCount * sizeof(double); break;
+      case OFTStringList:
+        for (int j = 0; j < field->StringList.nCount; j++)
+          size += strlen(field->StringList.paList[j]) + 1 + sizeof(char *);
+        break;
+      case OFTBinary: size += field->Binary.nCount; break;
+      default: break;
+    }
   }
+  for (int i = 0; i < feature->GetGeomFieldCount(); i++) {
+    OGRGeometry *geom = feature->GetGeomFieldRef(i);
+    if (geom != nullptr) size += geom->WkbSize();
+  }
+  return size;
+}
+
+// Hands over the current geometry to the borrowed views that are still alive
+// The next call to borrowGeometry() will start a new GeometryBorrow
+void Feature::detachBorrowedGeometry() {
+  if (!borrow_) return;
+  if (this_ && borrow_.use_count() > 1) {
+    borrow_->detached = this_->StealGeometry();
+    LOG("Detached borrowed Geometry [%p] from Feature [%p]", borrow_->detached, this_);
+  }
+  borrow_.reset();
 }
 
 /**
@@ -130,6 +185,7 @@ NAN_METHOD(Feature::New) {
 
     OGRFeature *ogr_f = new OGRFeature(def);
     f = new Feature(ogr_f);
+    f->updateSize();
   }
 
   Local<Value> fields = FeatureFields::New(info.This());
@@ -151,6 +207,7 @@ Local<Value> Feature::New(OGRFeature *feature, bool owned) {
 
   Feature *wrapped = new Feature(feature);
   wrapped->owned_ = owned;
+  wrapped->updateSize();
   Local<Value> ext = Nan::New<External>(wrapped);
   Local<Object> obj =
     Nan::NewInstance(Nan::GetFunction(Nan::New(Feature::constructor)).ToLocalChecked(), 1, &ext).ToLocalChecked();
@@ -186,6 +243,78 @@ NAN_METHOD(Feature::getGeometry) {
   info.GetReturnValue().Set(Geometry::New(geom, false));
 }
 
+/**
+ * Returns a view of the geometry of the feature without copying it.
+ *
+ * The view refers to the geometry stored in the feature. Modifying the view
+ * never modifies the feature - the view is copied on the first write and
+ * becomes an independent geometry. When the feature is destroyed, its geometry is replaced
+ * or a {{#crossLink "gdal.FeatureCursor"}}FeatureCursor{{/crossLink}} is advanced,
+ * the existing views keep the previous geometry which becomes independent from the feature.
+ *
+ * Prefer `getGeometry()` which returns a copy when the geometry will be modified
+ * and `borrowGeometry()` when reading large geometries.
+ * Use `setGeometry()` to store a modified geometry in the feature.
+ *
+ * @example
+ * ```
+ * const cursor = layer.features.cursor();
+ * while (cursor.advance()) {
+ *   area += cursor.borrowGeometry().getArea();
+ * }```
+ *
+ * @method borrowGeometry
+ * @return {gdal.Geometry}
+ */
+NAN_METHOD(Feature::borrowGeometry) {
+  Nan::HandleScope scope;
+
+  Feature *feature = Nan::ObjectWrap::Unwrap<Feature>(info.This());
+  if (!feature->isAlive()) {
+    Nan::ThrowError("Feature object already destroyed");
+    return;
+  }
+
+  OGRGeometry *geom = feature->this_->GetGeometryRef();
+  if (!geom) {
+    info.GetReturnValue().Set(Nan::Null());
+    return;
+  }
+
+  if (!feature->borrow_) feature->borrow_ = std::make_shared<GeometryBorrow>();
+  info.GetReturnValue().Set(Geometry::New(geom, feature->borrow_));
+}
+
+/**
+ * Removes the geometry from the feature and returns it without copying it.
+ * The feature is left without a geometry.
+ *
+ * If views returned by `borrowGeometry()` are still referencing the geometry,
+ * they keep the original and a copy is returned.
+ *
+ * @method stealGeometry
+ * @return {gdal.Geometry|null}
+ */
+NAN_METHOD(Feature::stealGeometry) {
+  Nan::HandleScope scope;
+
+  Feature *feature = Nan::ObjectWrap::Unwrap<Feature>(info.This());
+  if (!feature->isAlive()) {
+    Nan::ThrowError("Feature object already destroyed");
+    return;
+  }
+
+  std::shared_ptr<GeometryBorrow> borrow = feature->borrow_;
+  feature->detachBorrowedGeometry();
+  if (borrow && borrow->detached) {
+    info.GetReturnValue().Set(Geometry::New(borrow->detached, false));
+    return;
+  }
+
+  info.GetReturnValue().Set(Geometry::New(feature->this_->StealGeometry(), true));
+  feature->updateSize();
+}
+
 #if 0
 /**
  * Returns the definition of a particular field at an index.
@@ -214,9 +343,6 @@ NAN_METHOD(Feature::getFieldDefn) {
 }
 #endif
 
-// NODE_WRAPPED_METHOD_WITH_RESULT(Feature, stealGeometry, Geometry,
-// StealGeometry);
-
 /**
  * Sets the feature's geometry.
  *
@@ -236,8 +362,10 @@ NAN_METHOD(Feature::setGeometry) {
     return;
   }
 
+  feature->detachBorrowedGeometry();
   OGRErr err = feature->this_->SetGeometry(geom ? geom->get() : NULL);
   if (err) { NODE_THROW_OGRERR(err); }
+  feature->updateSize();
 
   return;
 }
@@ -319,6 +447,7 @@ NAN_METHOD(Feature::setFrom) {
     return;
   }
 
+  feature->detachBorrowedGeometry();
   if (!info[1]->IsArray()) {
     NODE_ARG_BOOL_OPT(1, "forgiving", forgiving);
 
@@ -358,6 +487,7 @@ NAN_METHOD(Feature::setFrom) {
     NODE_THROW_OGRERR(err);
     return;
   }
+  feature->updateSize();
   return;
 }
 
@@ -11,11 +11,15 @@
 // ogr
 #include <ogrsf_frmts.h>
 
+#include <memory>
+
 using namespace v8;
 using namespace node;
 
 namespace node_gdal {
 
+struct GeometryBorrow;
+
 class Feature : public Nan::ObjectWrap {
     public:
   static Nan::Persistent<FunctionTemplate> constructor;
@@ -25,9 +29,10 @@ class Feature : public Nan::ObjectWrap {
   static Local<Value> New(OGRFeature *feature, bool owned);
   static NAN_METHOD(toString);
   static NAN_METHOD(getGeometry);
+  static NAN_METHOD(borrowGeometry);
   //	static NAN_METHOD(setGeometryDirectly);
   static NAN_METHOD(setGeometry);
-  //  static NAN_METHOD(stealGeometry);
+  static NAN_METHOD(stealGeometry);
   static NAN_METHOD(clone);
   static NAN_METHOD(equals);
   static NAN_METHOD(getFieldDefn);
@@ -49,12 +54,24 @@ class Feature : public Nan::ObjectWrap {
     return this_;
   }
   void dispose();
+  // Must be called before the geometry of the feature is replaced or destroyed
+  void detachBorrowedGeometry();
+  // Must be called after the contents of the feature have been modified
+  void updateSize();
+  static int64_t estimateSize(OGRFeature *feature);
+
+  // Live features and their estimated native size, main thread only
+  static size_t live_count;
+  static int64_t live_size;
 
-    private:
+    protected:
   ~Feature();
   OGRFeature *this_;
   bool owned_;
-  // int size_;
+  // Shared with the views returned by borrowGeometry()
+  std::shared_ptr<GeometryBorrow> borrow_;
+  // Estimated native size reported to V8
+  int64_t size_;
 };
 
 } // namespace node_gdal
@@ -0,0 +1,169 @@
+#include "gdal_feature_cursor.hpp"
+#include "collections/feature_fields.hpp"
+#include "gdal_common.hpp"
+#include "gdal_layer.hpp"
+
+namespace node_gdal {
+
+Nan::Persistent<FunctionTemplate> FeatureCursor::constructor;
+
+void FeatureCursor::Initialize(Local<Object> target) {
+  Nan::HandleScope scope;
+
+  Local<FunctionTemplate> lcons = Nan::New<FunctionTemplate>(FeatureCursor::New);
+  lcons->Inherit(Nan::New(Feature::constructor));
+  lcons->InstanceTemplate()->SetInternalFieldCount(1);
+  lcons->SetClassName(Nan::New("FeatureCursor").ToLocalChecked());
+
+  Nan::SetPrototypeMethod(lcons, "toString", toString);
+  Nan__SetPrototypeAsyncableMethod(lcons, "advance", advance);
+
+  ATTR_DONT_ENUM(lcons, "layer", layerGetter, READ_ONLY_SETTER);
+
+  Nan::Set(target, Nan::New("FeatureCursor").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
+
+  constructor.Reset(lcons);
+}
+
+FeatureCursor::FeatureCursor() : Feature() {
+}
+
+FeatureCursor::~FeatureCursor() {
+}
+
+// The previous OGRFeature is always owned by the cursor
+// Every row is accounted in gdal.memoryUsage() like a new Feature, dispose() releases it
+void FeatureCursor::replace(OGRFeature *feature) {
+  dispose();
+  this_ = feature;
+  owned_ = true;
+  if (feature != nullptr) {
+    live_count++;
+    updateSize();
+  }
+}
+
+/**
+ * A reusable {{#crossLink "gdal.Feature"}}Feature{{/crossLink}} that iterates
+ * over the features of a {{#crossLink "gdal.Layer"}}Layer{{/crossLink}}
+ * without creating a new JS object for every feature.
+ *
+ * Every call to `advance()` replaces the underlying feature, the values
+ * read through `fields`, `fid` or `getGeometry()` are those of the current row.
+ * Use `clone()` to keep a row after advancing.
+ * `borrowGeometry()` reads the geometry of the current row without copying it.
+ *
+ * The cursor shares the read position of the layer with `next()`.
+ *
+ * @example
+ * ```
+ * const cursor = layer.features.cursor();
+ * while (cursor.advance()) {
+ *   console.log(cursor.fid, cursor.fields.get('name'));
+ * }```
+ *
+ * @class gdal.FeatureCursor
+ * @extends gdal.Feature
+ */
+NAN_METHOD(FeatureCursor::New) {
+  Nan::HandleScope scope;
+
+  if (!info.IsConstructCall()) {
+    Nan::ThrowError("Cannot call constructor as function, you need to use 'new' keyword");
+    return;
+  }
+  if (info[0]->IsExternal()) {
+    Local<External> ext = info[0].As<External>();
+    void *ptr = ext->Value();
+    FeatureCursor *f = static_cast<FeatureCursor *>(ptr);
+
+    Local<Value> fields = FeatureFields::New(info.This());
+    Nan::SetPrivate(info.This(), Nan::New("fields_").ToLocalChecked(), fields);
+
+    f->Wrap(info.This());
+    info.GetReturnValue().Set(info.This());
+    return;
+  } else {
+    Nan::ThrowError("Cannot create FeatureCursor directly, use LayerFeatures.cursor() instead");
+    return;
+  }
+}
+
+Local<Value> FeatureCursor::New(Local<Value> layer_obj) {
+  Nan::EscapableHandleScope scope;
+
+  FeatureCursor *wrapped = new FeatureCursor();
+
+  Local<Value> ext = Nan::New<External>(wrapped);
+  Local<Object> obj =
+    Nan::NewInstance(Nan::GetFunction(Nan::New(FeatureCursor::constructor)).ToLocalChecked(), 1, &ext)
+      .ToLocalChecked();
+  Nan::SetPrivate(obj, Nan::New("layer_").ToLocalChecked(), layer_obj);
+
+  return scope.Escape(obj);
+}
+
+NAN_METHOD(FeatureCursor::toString) {
+  Nan::HandleScope scope;
+  info.GetReturnValue().Set(Nan::New("FeatureCursor").ToLocalChecked());
+}
+
+/**
+ * Loads the next feature of the layer into the cursor.
+ * Returns `false` and leaves the cursor empty when there are no more features.
+ *
+ * @method advance
+ * @return {boolean}
+ */
+
+/**
+ * Loads the next feature of the layer into the cursor.
+ * Resolves to `false` and leaves the cursor empty when there are no more features.
+ * {{{async}}}
+ *
+ * @method advanceAsync
+ * @param {callback<boolean>} [callback=undefined] {{{cb}}}
+ * @return {Promise<boolean>}
+ */
+GDAL_ASYNCABLE_DEFINE(FeatureCursor::advance) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("layer_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  OGRLayer *gdal_layer = layer->get();
+  GDALAsyncableJob<OGRFeature *> job(layer->parent_uid);
+  job.persist(layer->handle());
+  job.persist("cursor", info.This());
+  job.main = [gdal_layer](const GDALExecutionProgress &) {
+    OGRFeature *feature = gdal_layer->GetNextFeature();
+    return feature;
+  };
+  // The swap happens on the main thread, the previous feature
+  // remains readable while the next one is being fetched
+  job.rval = [](OGRFeature *feature, GetFromPersistentFunc getter) {
+    FeatureCursor *cursor = Nan::ObjectWrap::Unwrap<FeatureCursor>(getter("cursor").As<Object>());
+    cursor->replace(feature);
+    return Nan::New<Boolean>(feature != nullptr);
+  };
+  job.run(info, async, 0);
+}
+
+/**
+ * Parent layer
+ *
+ * @readOnly
+ * @attribute layer
+ * @type {gdal.Layer}
+ */
+NAN_GETTER(FeatureCursor::layerGetter) {
+  Nan::HandleScope scope;
+  info.GetReturnValue().Set(Nan::GetPrivate(info.This(), Nan::New("layer_").ToLocalChecked()).ToLocalChecked());
+}
+
+} // namespace node_gdal
@@ -0,0 +1,43 @@
+#ifndef __NODE_OGR_FEATURE_CURSOR_H__
+#define __NODE_OGR_FEATURE_CURSOR_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include "async.hpp"
+#include "gdal_feature.hpp"
+
+using namespace v8;
+using namespace node;
+
+namespace node_gdal {
+
+// A Feature that is reused for every row of a Layer
+// Its OGRFeature is replaced each time it is advanced
+class FeatureCursor : public Feature {
+    public:
+  static Nan::Persistent<FunctionTemplate> constructor;
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(New);
+  static Local<Value> New(Local<Value> layer_obj);
+  static NAN_METHOD(toString);
+  GDAL_ASYNCABLE_DECLARE(advance);
+
+  static NAN_GETTER(layerGetter);
+
+  FeatureCursor();
+  void replace(OGRFeature *feature);
+
+    private:
+  ~FeatureCursor();
+};
+
+} // namespace node_gdal
+#endif
@@ -9,9 +9,15 @@
 #include "gdal_field_defn.hpp"
 #include "geometry/gdal_geometry.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "utils/string_list.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <stdlib.h>
+#include <thread>
 
 namespace node_gdal {
 
@@ -31,6 +37,14 @@ void Layer::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "getSpatialFilter", getSpatialFilter);
   Nan::SetPrototypeMethod(lcons, "testCapability", testCapability);
   Nan__SetPrototypeAsyncableMethod(lcons, "flush", syncToDisk);
+  Nan__SetPrototypeAsyncableMethod(lcons, "intersection", intersection);
+  Nan__SetPrototypeAsyncableMethod(lcons, "union", unionLayer);
+  Nan__SetPrototypeAsyncableMethod(lcons, "symDifference", symDifference);
+  Nan__SetPrototypeAsyncableMethod(lcons, "identity", identity);
+  Nan__SetPrototypeAsyncableMethod(lcons, "update", update);
+  Nan__SetPrototypeAsyncableMethod(lcons, "clip", clip);
+  Nan__SetPrototypeAsyncableMethod(lcons, "erase", erase);
+  Nan__SetPrototypeAsyncableMethod(lcons, "dissolve", dissolve);
 
   ATTR_DONT_ENUM(lcons, "ds", dsGetter, READ_ONLY_SETTER);
   ATTR_DONT_ENUM(lcons, "_uid", uidGetter, READ_ONLY_SETTER);
@@ -47,17 +61,28 @@ void Layer::Initialize(Local<Object> target) {
   constructor.Reset(lcons);
 }
 
-Layer::Layer(OGRLayer *layer) : Nan::ObjectWrap(), uid(0), this_(layer), parent_ds(0) {
+Layer::Layer(OGRLayer *layer)
+  : Nan::ObjectWrap(), uid(0), fid_index(), fid_index_valid(false), this_(layer), parent_ds(0) {
   LOG("Created layer [%p]", layer);
 }
 
-Layer::Layer() : Nan::ObjectWrap(), uid(0), this_(0), parent_ds(0) {
+Layer::Layer() : Nan::ObjectWrap(), uid(0), fid_index(), fid_index_valid(false), this_(0), parent_ds(0) {
 }
 
 Layer::~Layer() {
   dispose();
 }
 
+void Layer::invalidateFidIndexUnlocked() {
+  if (!isAlive()) return;
+  try {
+    AsyncGuard lock(parent_uid);
+    invalidateFidIndex();
+  } catch (const char *) {
+    // The dataset has been closed in the meantime
+  }
+}
+
 void Layer::dispose() {
   if (this_) {
 
@@ -138,6 +163,7 @@ Local<Value> Layer::New(OGRLayer *raw, GDALDataset *raw_parent, bool result_set)
   long parent_uid = unwrapped->uid;
 
   wrapped->uid = object_store.add(raw, wrapped->persistent(), parent_uid, result_set);
+  object_store.setSize<OGRLayer *>(wrapped->uid, estimateSize(0));
   wrapped->parent_ds = raw_parent;
   wrapped->parent_uid = parent_uid;
   Nan::SetPrivate(obj, Nan::New("ds_").ToLocalChecked(), ds);
@@ -180,6 +206,596 @@ NAN_METHOD(Layer::toString) {
  */
 NODE_WRAPPED_ASYNC_METHOD_WITH_OGRERR_RESULT_LOCKED(Layer, syncToDisk, SyncToDisk);
 
+typedef OGRErr (OGRLayer::*OverlayMethod)(OGRLayer *, OGRLayer *, char **, GDALProgressFunc, void *);
+
+// The common block of all the layer algebra methods
+// (method, result, options, progress_options, callback)
+static void layerOverlay(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async, OverlayMethod overlay) {
+  Nan::HandleScope scope;
+
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info.This());
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object has already been destroyed");
+    return;
+  }
+
+  Layer *method, *result;
+  NODE_ARG_WRAPPED(0, "method layer", Layer, method);
+  NODE_ARG_WRAPPED(1, "result layer", Layer, result);
+
+  GDALAsyncableJob<int> job({layer->parent_uid, method->parent_uid, result->parent_uid});
+  Nan::Callback *progress_cb;
+  NODE_PROGRESS_CB_OPT(3, progress_cb, job);
+
+  StringList *options = new StringList;
+  if (info.Length() > 2 && options->parse(info[2])) {
+    delete options;
+    return; // error parsing string list
+  }
+  job.persist(method->handle(), result->handle());
+
+  OGRLayer *raw = layer->get();
+  OGRLayer *raw_method = method->get();
+  OGRLayer *raw_result = result->get();
+  job.main = [raw, raw_method, raw_result, options, overlay, progress_cb](
+               const GDALExecutionProgress &progress) {
+    std::unique_ptr<StringList> options_ptr(options);
+    CPLErrorReset();
+    OGRErr err = (raw->*overlay)(
+      raw_method,
+      raw_result,
+      options->get(),
+      progress_cb ? ProgressTrampoline : nullptr,
+      progress_cb ? (void *)&progress : nullptr);
+    if (err != OGRERR_NONE) {
+      if (CPLGetLastErrorType() != CE_None) throw CPLGetLastErrorMsg();
+      throw getOGRErrMsg(err);
+    }
+    return 0;
+  };
+  // The FID index is touched only on the main thread, the sync rval runs with the dataset still locked
+  job.rval = [result, async](int, GetFromPersistentFunc) {
+    if (async)
+      result->invalidateFidIndexUnlocked();
+    else
+      result->invalidateFidIndex();
+    return Nan::Undefined().As<Value>();
+  };
+  // Features may have been added even if the operation fails and rval is not called
+  result->invalidateFidIndexUnlocked();
+  job.run(info, async, 4);
+}
+
+/**
+ * @typedef LayerAlgebraOptions { progress_cb?: ProgressCb }
+ */
+
+/**
+ * Intersection of two layers.
+ *
+ * The result layer contains the features whose geometries represent
+ * areas that are common between features in this layer and in the method layer,
+ * its fields are the union of the fields of the two layers unless they already exist.
+ *
+ * Returning `false` from the progress callback interrupts the operation.
+ *
+ * @throws Error
+ * @method intersection
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options such as `SKIP_FAILURES`, `PROMOTE_TO_MULTI`,
+ * `INPUT_PREFIX`, `METHOD_PREFIX`, `USE_PREPARED_GEOMETRIES` or `KEEP_LOWER_DIMENSION_GEOMETRIES`,
+ * see the documentation of `OGRLayer::Intersection()`
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ */
+
+/**
+ * Intersection of two layers.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method intersectionAsync
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options, see {{#crossLink "gdal.Layer/intersection:method"}}{{/crossLink}}
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::intersection) {
+  layerOverlay(info, async, &OGRLayer::Intersection);
+}
+
+/**
+ * Union of two layers.
+ *
+ * The result layer contains the features whose geometries represent
+ * areas that are either in this layer, in the method layer or in both.
+ *
+ * Returning `false` from the progress callback interrupts the operation.
+ *
+ * @throws Error
+ * @method union
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options, see the documentation of `OGRLayer::Union()`
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ */
+
+/**
+ * Union of two layers.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method unionAsync
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options, see the documentation of `OGRLayer::Union()`
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::unionLayer) {
+  layerOverlay(info, async, &OGRLayer::Union);
+}
+
+/**
+ * Symmetrical difference of two layers.
+ *
+ * The result layer contains the features whose geometries represent
+ * areas that are in this layer or in the method layer but not in both.
+ *
+ * Returning `false` from the progress callback interrupts the operation.
+ *
+ * @throws Error
+ * @method symDifference
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options, see the documentation of `OGRLayer::SymDifference()`
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ */
+
+/**
+ * Symmetrical difference of two layers.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method symDifferenceAsync
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options, see the documentation of `OGRLayer::SymDifference()`
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::symDifference) {
+  layerOverlay(info, async, &OGRLayer::SymDifference);
+}
+
+/**
+ * Identify the features of this layer with the ones from the method layer.
+ *
+ * The result layer contains the features whose geometries represent
+ * areas that are in this layer, split by the features of the method layer.
+ *
+ * Returning `false` from the progress callback interrupts the operation.
+ *
+ * @throws Error
+ * @method identity
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options, see the documentation of `OGRLayer::Identity()`
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ */
+
+/**
+ * Identify the features of this layer with the ones from the method layer.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method identityAsync
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options, see the documentation of `OGRLayer::Identity()`
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::identity) {
+  layerOverlay(info, async, &OGRLayer::Identity);
+}
+
+/**
+ * Update this layer with the features from the method layer.
+ *
+ * The result layer contains the features whose geometries represent
+ * areas that are either in this layer or in the method layer,
+ * the features from the method layer take precedence.
+ *
+ * Returning `false` from the progress callback interrupts the operation.
+ *
+ * @throws Error
+ * @method update
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options, see the documentation of `OGRLayer::Update()`
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ */
+
+/**
+ * Update this layer with the features from the method layer.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method updateAsync
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options, see the documentation of `OGRLayer::Update()`
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::update) {
+  layerOverlay(info, async, &OGRLayer::Update);
+}
+
+/**
+ * Clip this layer by the method layer.
+ *
+ * The result layer contains the features whose geometries represent
+ * areas that are in this layer and in the method layer,
+ * it has the same fields as this layer.
+ *
+ * Returning `false` from the progress callback interrupts the operation.
+ *
+ * @throws Error
+ * @method clip
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options, see the documentation of `OGRLayer::Clip()`
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ */
+
+/**
+ * Clip this layer by the method layer.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method clipAsync
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options, see the documentation of `OGRLayer::Clip()`
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::clip) {
+  layerOverlay(info, async, &OGRLayer::Clip);
+}
+
+/**
+ * Erase the areas of the method layer from this layer.
+ *
+ * The result layer contains the features whose geometries represent
+ * areas that are in this layer but not in the method layer,
+ * it has the same fields as this layer.
+ *
+ * Returning `false` from the progress callback interrupts the operation.
+ *
+ * @throws Error
+ * @method erase
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options, see the documentation of `OGRLayer::Erase()`
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ */
+
+/**
+ * Erase the areas of the method layer from this layer.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method eraseAsync
+ * @param {gdal.Layer} method the method layer
+ * @param {gdal.Layer} result the layer where the features will be written
+ * @param {string[]|object} [options] GDAL options, see the documentation of `OGRLayer::Erase()`
+ * @param {LayerAlgebraOptions} [progress_options]
+ * @param {ProgressCb} [progress_options.progress_cb] {{{progress_cb}}}
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::erase) {
+  layerOverlay(info, async, &OGRLayer::Erase);
+}
+
+// A group of features with the same values of the dissolve fields
+struct DissolveGroup {
+  // The first feature of the group, without its geometry, for the field values
+  OGRFeature *feature;
+  std::vector<OGRGeometry *> geoms;
+  OGRGeometry *result;
+};
+
+// Union of all the geometries of a group, consumes them
+// Polygons go through the cascaded union, everything else is merged one by one
+static OGRGeometry *dissolveGroup(std::vector<OGRGeometry *> &geoms) {
+  bool polygonal = true;
+  for (OGRGeometry *geom : geoms) {
+    OGRwkbGeometryType type = wkbFlatten(geom->getGeometryType());
+    if (type != wkbPolygon && type != wkbMultiPolygon) {
+      polygonal = false;
+      break;
+    }
+  }
+
+  OGRGeometry *r = nullptr;
+  if (polygonal) {
+    OGRMultiPolygon parts;
+    for (OGRGeometry *geom : geoms) {
+      if (wkbFlatten(geom->getGeometryType()) == wkbPolygon) {
+        parts.addGeometryDirectly(geom);
+      } else {
+        OGRMultiPolygon *multi = geom->toMultiPolygon();
+        while (multi->getNumGeometries() > 0) {
+          parts.addGeometryDirectly(multi->getGeometryRef(0));
+          multi->removeGeometry(0, FALSE);
+        }
+        delete multi;
+      }
+    }
+    geoms.clear();
+    r = parts.UnionCascaded();
+  } else {
+    r = geoms[0];
+    for (size_t i = 1; i < geoms.size(); i++) {
+      if (r != nullptr) {
+        OGRGeometry *merged = r->Union(geoms[i]);
+        delete r;
+        r = merged;
+      }
+      delete geoms[i];
+    }
+    geoms.clear();
+  }
+  return r;
+}
+
+/**
+ * @typedef DissolveOptions { by?: string[], output: gdal.Layer, threads?: number, progress_cb?: ProgressCb }
+ */
+
+/**
+ * Dissolves the features of this layer by the values of some of their fields.
+ *
+ * The features that have the same values in all the `by` fields are merged
+ * into a single feature in the `output` layer, its geometry is the union of their
+ * geometries and its fields are the `by` fields which are created in the output
+ * layer if they are missing. Without `by` fields the whole layer is merged into one feature.
+ *
+ * The features are grouped while reading, then the unions run on a pool of threads,
+ * polygons use the GEOS cascaded union.
+ *
+ * The current spatial and attribute filters are respected.
+ * Returning `false` from the progress callback interrupts the operation.
+ * Requires GDAL with GEOS support.
+ *
+ * @example
+ * ```
+ * const out = gdal.open('regions.shp', 'w', 'ESRI Shapefile');
+ * await parcels.dissolveAsync({ by: [ 'region' ], output: out.layers.create('regions', parcels.srs, gdal.MultiPolygon) });```
+ *
+ * @throws Error
+ * @method dissolve
+ * @param {DissolveOptions} options
+ * @param {string[]} [options.by] Fields to group by
+ * @param {gdal.Layer} options.output Output layer
+ * @param {number} [options.threads] Number of threads, the number of CPUs by default
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ */
+
+/**
+ * Dissolves the features of this layer by the values of some of their fields.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method dissolveAsync
+ * @param {DissolveOptions} options
+ * @param {string[]} [options.by] Fields to group by
+ * @param {gdal.Layer} options.output Output layer
+ * @param {number} [options.threads] Number of threads, the number of CPUs by default
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::dissolve) {
+  Nan::HandleScope scope;
+
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info.This());
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object has already been destroyed");
+    return;
+  }
+
+  Local<Object> obj;
+  Local<Array> by_array;
+  Layer *output;
+  int threads = CPLGetNumCPUs();
+  Nan::Callback *progress_cb = nullptr;
+
+  NODE_ARG_OBJECT(0, "options", obj);
+  NODE_ARRAY_FROM_OBJ_OPT(obj, "by", by_array);
+  NODE_WRAPPED_FROM_OBJ(obj, "output", Layer, output);
+  NODE_INT_FROM_OBJ_OPT(obj, "threads", threads);
+
+  std::vector<std::string> by;
+  if (!by_array.IsEmpty()) {
+    for (unsigned i = 0; i < by_array->Length(); i++) {
+      Local<Value> field = Nan::Get(by_array, i).ToLocalChecked();
+      if (!field->IsString()) {
+        Nan::ThrowTypeError("by must contain only strings");
+        return;
+      }
+      by.push_back(*Nan::Utf8String(field));
+    }
+  }
+  threads = std::max(1, threads);
+  NODE_CB_FROM_OBJ_OPT(obj, "progress_cb", progress_cb);
+
+  OGRLayer *gdal_layer = layer->get();
+  OGRLayer *gdal_output = output->get();
+
+  GDALAsyncableJob<int> job({layer->parent_uid, output->parent_uid});
+  job.progress = progress_cb;
+  job.persist(obj, output->handle());
+  job.main = [gdal_layer, gdal_output, by, threads, progress_cb](const GDALExecutionProgress &progress) {
+    OGRFeatureDefn *defn = gdal_layer->GetLayerDefn();
+    OGRFeatureDefn *output_defn = gdal_output->GetLayerDefn();
+
+    // Output field index of every input field, -1 for those not copied
+    std::vector<int> by_fields;
+    std::vector<int> field_map(defn->GetFieldCount(), -1);
+    for (const std::string &name : by) {
+      int idx = defn->GetFieldIndex(name.c_str());
+      if (idx < 0) throw "by contains a non-existent field";
+      by_fields.push_back(idx);
+      OGRFieldDefn *field = defn->GetFieldDefn(idx);
+      int out_idx = output_defn->GetFieldIndex(field->GetNameRef());
+      if (out_idx < 0) {
+        if (gdal_output->CreateField(field) != OGRERR_NONE) throw CPLGetLastErrorMsg();
+        out_idx = output_defn->GetFieldIndex(field->GetNameRef());
+      }
+      field_map[idx] = out_idx;
+    }
+
+    std::map<std::vector<std::string>, size_t> keys;
+    std::vector<DissolveGroup> groups;
+    auto cleanup = [&groups]() {
+      for (DissolveGroup &group : groups) {
+        OGRFeature::DestroyFeature(group.feature);
+        for (OGRGeometry *geom : group.geoms) delete geom;
+        delete group.result;
+      }
+    };
+
+    // Reading is the first half of the progress
+    GIntBig total = progress_cb ? gdal_layer->GetFeatureCount(TRUE) : 0;
+    GIntBig read = 0;
+    OGRFeature *feature;
+    gdal_layer->ResetReading();
+    while ((feature = gdal_layer->GetNextFeature()) != nullptr) {
+      OGRGeometry *geom = feature->StealGeometry();
+      if (geom == nullptr || geom->IsEmpty()) {
+        delete geom;
+        OGRFeature::DestroyFeature(feature);
+        continue;
+      }
+      std::vector<std::string> key;
+      for (int idx : by_fields)
+        // unset and null fields form their own group
+        key.push_back(feature->IsFieldSetAndNotNull(idx) ? std::string("v") + feature->GetFieldAsString(idx) : "");
+      auto it = keys.find(key);
+      if (it == keys.end()) {
+        keys[key] = groups.size();
+        groups.push_back({feature, {geom}, nullptr});
+      } else {
+        groups[it->second].geoms.push_back(geom);
+        OGRFeature::DestroyFeature(feature);
+      }
+      read++;
+      if (progress_cb && total > 0 && read % 1024 == 0 &&
+          !ProgressTrampoline(0.5 * read / total, nullptr, (void *)&progress)) {
+        gdal_layer->ResetReading();
+        cleanup();
+        throw "User terminated";
+      }
+    }
+    gdal_layer->ResetReading();
+
+    // The biggest groups first for a better load balancing
+    std::vector<size_t> order(groups.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&groups](size_t a, size_t b) {
+      return groups[a].geoms.size() > groups[b].geoms.size();
+    });
+
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> done(0);
+    std::atomic<bool> failed(false);
+    std::mutex error_lock;
+    std::string error;
+    auto work = [&](bool main_thread) {
+      size_t i;
+      while (!failed && (i = next++) < order.size()) {
+        DissolveGroup &group = groups[order[i]];
+        CPLErrorReset();
+        group.result = dissolveGroup(group.geoms);
+        if (group.result == nullptr) {
+          std::lock_guard<std::mutex> lock(error_lock);
+          if (!failed) error = CPLGetLastErrorType() != CE_None ? CPLGetLastErrorMsg() : "Failed computing union";
+          failed = true;
+        }
+        done++;
+        // Only the calling thread can report the progress in sync mode
+        if (main_thread && progress_cb && !failed &&
+            !ProgressTrampoline(0.5 + 0.5 * done / groups.size(), nullptr, (void *)&progress)) {
+          std::lock_guard<std::mutex> lock(error_lock);
+          error = "User terminated";
+          failed = true;
+        }
+      }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads && (size_t)t < groups.size(); t++) pool.push_back(std::thread(work, false));
+    work(true);
+    for (auto &thread : pool) thread.join();
+    if (failed) {
+      cleanup();
+      // error is about to go out of scope
+      CPLErrorSetState(CE_Failure, CPLE_AppDefined, error.c_str());
+      throw CPLGetLastErrorMsg();
+    }
+
+    for (DissolveGroup &group : groups) {
+      OGRFeature *out = new OGRFeature(output_defn);
+      OGRErr err = out->SetFieldsFrom(group.feature, field_map.data(), TRUE);
+      out->SetGeometryDirectly(group.result);
+      group.result = nullptr;
+      if (err == OGRERR_NONE) err = gdal_output->CreateFeature(out);
+      OGRFeature::DestroyFeature(out);
+      if (err != OGRERR_NONE) {
+        cleanup();
+        throw getOGRErrMsg(err);
+      }
+    }
+    cleanup();
+    return 0;
+  };
+  // The FID index is touched only on the main thread, the sync rval runs with the dataset still locked
+  job.rval = [output, async](int, GetFromPersistentFunc) {
+    if (async)
+      output->invalidateFidIndexUnlocked();
+    else
+      output->invalidateFidIndex();
+    return Nan::Undefined().As<Value>();
+  };
+  // Features may have been added even if the operation fails and rval is not called
+  output->invalidateFidIndexUnlocked();
+  job.run(info, async, 1);
+}
+
 /**
  * Determines if the dataset supports the indicated operation.
  *
@@ -280,6 +896,7 @@ NAN_METHOD(Layer::setSpatialFilter) {
     NODE_ARG_WRAPPED_OPT(0, "filter", Geometry, filter);
 
     GDAL_LOCK_PARENT(layer);
+    layer->invalidateFidIndex();
     if (filter) {
       layer->this_->SetSpatialFilter(filter->get());
     } else {
@@ -293,6 +910,7 @@ NAN_METHOD(Layer::setSpatialFilter) {
     NODE_ARG_DOUBLE(3, "maxY", maxY);
 
     GDAL_LOCK_PARENT(layer);
+    layer->invalidateFidIndex();
     layer->this_->SetSpatialFilterRect(minX, minY, maxX, maxY);
   } else {
     Nan::ThrowError("Invalid number of arguments");
@@ -338,6 +956,7 @@ NAN_METHOD(Layer::setAttributeFilter) {
 
   OGRErr err;
   GDAL_LOCK_PARENT(layer);
+  layer->invalidateFidIndex();
   if (filter.empty()) {
     err = layer->this_->SetAttributeFilter(NULL);
   } else {
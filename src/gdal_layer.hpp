@@ -32,6 +32,14 @@ class Layer : public Nan::ObjectWrap {
   static NAN_METHOD(getSpatialFilter);
   static NAN_METHOD(testCapability);
   GDAL_ASYNCABLE_DECLARE(syncToDisk);
+  GDAL_ASYNCABLE_DECLARE(intersection);
+  GDAL_ASYNCABLE_DECLARE(unionLayer);
+  GDAL_ASYNCABLE_DECLARE(symDifference);
+  GDAL_ASYNCABLE_DECLARE(identity);
+  GDAL_ASYNCABLE_DECLARE(update);
+  GDAL_ASYNCABLE_DECLARE(clip);
+  GDAL_ASYNCABLE_DECLARE(erase);
+  GDAL_ASYNCABLE_DECLARE(dissolve);
 
   static NAN_SETTER(dsSetter);
   static NAN_GETTER(dsGetter);
@@ -59,6 +67,22 @@ class Layer : public Nan::ObjectWrap {
   long uid;
   long parent_uid;
 
+  // FIDs in iteration order, used by LayerFeatures.page() when
+  // the driver does not support fast SetNextByIndex()
+  // Must be accessed with the parent dataset locked
+  std::vector<GIntBig> fid_index;
+  bool fid_index_valid;
+  inline void invalidateFidIndex() {
+    fid_index.clear();
+    fid_index_valid = false;
+  }
+  // Same as above, but from the main thread when the parent dataset is not locked
+  void invalidateFidIndexUnlocked();
+  // Estimated native size, including the FID index
+  inline static int64_t estimateSize(size_t fid_index_capacity) {
+    return sizeof(OGRLayer) + fid_index_capacity * sizeof(GIntBig);
+  }
+
     private:
   ~Layer();
   OGRLayer *this_;
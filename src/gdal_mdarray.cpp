@@ -132,12 +132,22 @@ Local<Value> MDArray::New(std::shared_ptr<GDALMDArray> raw, GDALDataset *parent_
   wrapped->parent_ds = parent_ds;
   wrapped->parent_uid = parent_uid;
   wrapped->dimensions = dim;
+  object_store.setSize<std::shared_ptr<GDALMDArray>>(wrapped->uid, estimateSize(raw, parent_ds));
 
   Nan::SetPrivate(obj, Nan::New("ds_").ToLocalChecked(), ds);
 
   return scope.Escape(obj);
 }
 
+// Only the arrays of the MEM driver keep their data in the process heap
+int64_t MDArray::estimateSize(std::shared_ptr<GDALMDArray> raw, GDALDataset *parent_ds) {
+  int64_t size = sizeof(GDALMDArray);
+  GDALDriver *driver = parent_ds->GetDriver();
+  if (driver != nullptr && !strcmp(driver->GetDescription(), "MEM"))
+    size += static_cast<int64_t>(raw->GetTotalElementsCount() * raw->GetDataType().GetSize());
+  return size;
+}
+
 NAN_METHOD(MDArray::toString) {
   Nan::HandleScope scope;
   info.GetReturnValue().Set(Nan::New("MDArray").ToLocalChecked());
@@ -60,6 +60,8 @@ class MDArray : public Nan::ObjectWrap {
     return this_ && object_store.isAlive(uid);
   }
 
+  static int64_t estimateSize(std::shared_ptr<GDALMDArray> raw, GDALDataset *parent_ds);
+
     private:
   ~MDArray();
   std::shared_ptr<GDALMDArray> this_;
@@ -42,6 +42,8 @@ void Memfile::Initialize(Local<Object> target) {
   Nan::SetMethod(vsimem, "_anonymous", Memfile::vsimemAnonymous); // not a public API
   Nan::SetMethod(vsimem, "set", Memfile::vsimemSet);
   Nan::SetMethod(vsimem, "release", Memfile::vsimemRelease);
+  Nan::SetMethod(vsimem, "take", Memfile::vsimemTake);
+  Nan::SetMethod(vsimem, "read", Memfile::vsimemRead);
 }
 
 // Anonymous buffers are handled by the GC
@@ -126,6 +128,20 @@ NAN_METHOD(Memfile::vsimemAnonymous) {
     info.GetReturnValue().Set(Nan::New<String>(memfile->filename).ToLocalChecked());
 }
 
+// The GDAL allocated buffers are freed by GDAL
+void Memfile::freeGDALBuffer(char *data, void *) {
+  VSIFree(data);
+}
+
+// Retrieves the buffer of an existing file and sets an explicit error for a missing one
+static void *getMemFileBuffer(const std::string &filename, vsi_l_offset *len) {
+  CPLErrorReset();
+  void *data = VSIGetMemFileBuffer(filename.c_str(), len, false);
+  if (data == nullptr && CPLGetLastErrorType() == CE_None)
+    CPLErrorSetState(CE_Failure, CPLE_FileIO, (filename + ": No such file or directory").c_str());
+  return data;
+}
+
 /**
  * Delete and retrieve the contents of an in-memory /vsimem/ file.
  * This is a very fast zero-copy operation.
@@ -134,25 +150,36 @@ NAN_METHOD(Memfile::vsimemAnonymous) {
  * If the file was created by vsimem.set, it will return a reference
  * to the same Buffer that was used to create it.
  * Otherwise it will construct a new Buffer object with the GDAL
- * allocated buffer as its backing store.
+ * allocated buffer as its backing store which will be freed by GDAL
+ * when the Buffer is garbage collected.
+ *
+ * @example
+ * ```
+ * gdal.drivers.get('PNG').createCopy('/vsimem/tile.png', ds).close();
+ * const png = gdal.vsimem.take('/vsimem/tile.png');
+ * ```
  *
  * @static
- * @method release
+ * @method take
  * @param {string} filename A file name beginning with /vsimem/
  * @throws
  * @return {Buffer} A binary buffer containing all the data
  */
-NAN_METHOD(Memfile::vsimemRelease) {
+NAN_METHOD(Memfile::vsimemTake) {
   vsi_l_offset len;
   std::string filename;
   NODE_ARG_STR(0, "filename", filename);
 
-  CPLErrorReset();
-  void *data = VSIGetMemFileBuffer(filename.c_str(), &len, false);
+  void *data = getMemFileBuffer(filename, &len);
   if (data == nullptr) {
     NODE_THROW_LAST_CPLERR;
     return;
   }
+  // Before GDAL relinquishes the ownership
+  if (len > node::Buffer::kMaxLength) {
+    Nan::ThrowRangeError((filename + ": file is larger than the maximum Buffer size").c_str());
+    return;
+  }
 
   // Two cases:
   if (memfile_collection.count(data)) {
@@ -167,8 +194,57 @@ NAN_METHOD(Memfile::vsimemRelease) {
     // the file has been created by GDAL and the buffer is owned by GDAL
     // -> a new Buffer is constructed and GDAL has to relinquish control
     VSIGetMemFileBuffer(filename.c_str(), &len, true);
-    info.GetReturnValue().Set(Nan::NewBuffer(static_cast<char *>(data), static_cast<uint32_t>(len)).ToLocalChecked());
+    info.GetReturnValue().Set(
+      Nan::NewBuffer(static_cast<char *>(data), static_cast<size_t>(len), freeGDALBuffer, nullptr).ToLocalChecked());
   }
 }
 
+/**
+ * Delete and retrieve the contents of an in-memory /vsimem/ file,
+ * same as vsimem.take.
+ *
+ * @static
+ * @method release
+ * @param {string} filename A file name beginning with /vsimem/
+ * @throws
+ * @return {Buffer} A binary buffer containing all the data
+ */
+NAN_METHOD(Memfile::vsimemRelease) {
+  vsimemTake(info);
+}
+
+/**
+ * Retrieve a copy of the contents of an in-memory /vsimem/ file.
+ * The file is not deleted and remains usable by GDAL.
+ * The file must not be open for writing.
+ *
+ * @static
+ * @method read
+ * @param {string} filename A file name beginning with /vsimem/
+ * @throws
+ * @return {Buffer} A binary buffer containing a copy of the data
+ */
+NAN_METHOD(Memfile::vsimemRead) {
+  vsi_l_offset len;
+  std::string filename;
+  NODE_ARG_STR(0, "filename", filename);
+
+  void *data = getMemFileBuffer(filename, &len);
+  if (data == nullptr) {
+    NODE_THROW_LAST_CPLERR;
+    return;
+  }
+
+  // Nan::CopyBuffer() is limited to 4GB
+  if (len > node::Buffer::kMaxLength) {
+    Nan::ThrowRangeError((filename + ": file is larger than the maximum Buffer size").c_str());
+    return;
+  }
+  Local<Object> buffer;
+  if (!node::Buffer::Copy(v8::Isolate::GetCurrent(), static_cast<char *>(data), static_cast<size_t>(len))
+         .ToLocal(&buffer))
+    return;
+  info.GetReturnValue().Set(buffer);
+}
+
 } // namespace node_gdal
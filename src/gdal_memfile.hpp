@@ -34,11 +34,15 @@ class Memfile {
   static Memfile *get(Local<Object>);
   static Memfile *get(Local<Object>, const std::string &filename);
   static std::map<void *, Memfile *> memfile_collection;
+  // Free callback for the Buffers backed by GDAL memory
+  static void freeGDALBuffer(char *data, void *hint);
 
   static void Initialize(Local<Object> target);
   static NAN_METHOD(vsimemSet);
   static NAN_METHOD(vsimemAnonymous);
   static NAN_METHOD(vsimemRelease);
+  static NAN_METHOD(vsimemTake);
+  static NAN_METHOD(vsimemRead);
 };
 } // namespace node_gdal
 #endif
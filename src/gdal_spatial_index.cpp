@@ -0,0 +1,399 @@
+#include "gdal_spatial_index.hpp"
+#include "gdal_common.hpp"
+#include "gdal_layer.hpp"
+#include "geometry/gdal_geometry.hpp"
+#include "utils/typed_array.hpp"
+
+#include <algorithm>
+
+namespace node_gdal {
+
+Nan::Persistent<FunctionTemplate> SpatialIndex::constructor;
+
+void SpatialIndex::Initialize(Local<Object> target) {
+  Nan::HandleScope scope;
+
+  Local<FunctionTemplate> lcons = Nan::New<FunctionTemplate>(SpatialIndex::New);
+  lcons->InstanceTemplate()->SetInternalFieldCount(1);
+  lcons->SetClassName(Nan::New("SpatialIndex").ToLocalChecked());
+
+  Nan__SetAsyncableMethod(lcons, "fromGeometries", fromGeometries);
+  Nan__SetAsyncableMethod(lcons, "fromLayer", fromLayer);
+
+  Nan::SetPrototypeMethod(lcons, "toString", toString);
+  Nan::SetPrototypeMethod(lcons, "query", query);
+  Nan__SetPrototypeAsyncableMethod(lcons, "intersecting", intersecting);
+  Nan__SetPrototypeAsyncableMethod(lcons, "nearest", nearest);
+
+  ATTR(lcons, "count", countGetter, READ_ONLY_SETTER);
+
+  Nan::Set(target, Nan::New("SpatialIndex").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
+
+  constructor.Reset(lcons);
+}
+
+SpatialIndex::SpatialIndex() : Nan::ObjectWrap(), tree(), geoms(), envs(), ids() {
+}
+
+SpatialIndex::~SpatialIndex() {
+  LOG("Disposing SpatialIndex [%p]", this);
+  for (OGRGeometry *geom : geoms) OGRGeometryFactory::destroyGeometry(geom);
+  geoms.clear();
+}
+
+// Empty geometries are not indexed
+void SpatialIndex::add(OGRGeometry *geom, GIntBig id) {
+  if (geom == nullptr) return;
+  if (geom->IsEmpty()) {
+    OGRGeometryFactory::destroyGeometry(geom);
+    return;
+  }
+  OGREnvelope env;
+  geom->getEnvelope(&env);
+  geoms.push_back(geom);
+  envs.push_back(env);
+  ids.push_back(id);
+}
+
+void SpatialIndex::build() {
+  tree.build(envs);
+}
+
+static Local<Value> idsToArray(const std::vector<GIntBig> &ids) {
+  Nan::EscapableHandleScope scope;
+  Local<Value> array = TypedArray::New(GDT_Float64, ids.size());
+  if (array.IsEmpty() || !array->IsObject()) return scope.Escape(array);
+  Nan::TypedArrayContents<double> contents(array);
+  std::copy(ids.begin(), ids.end(), *contents);
+  return scope.Escape(array);
+}
+
+/**
+ * An in-memory spatial index built once from an array of geometries or from
+ * the features of a layer.
+ *
+ * It is a packed R-tree (STR-tree) that cannot be modified after it has been built.
+ * The index keeps its own copy of every geometry.
+ *
+ * All the queries return the identifiers of the matching geometries as a `Float64Array` -
+ * their position in the array or their FID when built from a layer.
+ *
+ * @example
+ * ```
+ * const index = await gdal.SpatialIndex.fromLayerAsync(layer);
+ * const fids = index.query({ minX: 0, maxX: 10, minY: 0, maxY: 10 });
+ * const closest = index.nearest(new gdal.Point(5, 5), 3);```
+ *
+ * @class gdal.SpatialIndex
+ */
+NAN_METHOD(SpatialIndex::New) {
+  Nan::HandleScope scope;
+
+  if (!info.IsConstructCall()) {
+    Nan::ThrowError("Cannot call constructor as function, you need to use 'new' keyword");
+    return;
+  }
+  if (info[0]->IsExternal()) {
+    Local<External> ext = info[0].As<External>();
+    void *ptr = ext->Value();
+    SpatialIndex *f = static_cast<SpatialIndex *>(ptr);
+    f->Wrap(info.This());
+    info.GetReturnValue().Set(info.This());
+    return;
+  } else {
+    Nan::ThrowError(
+      "Cannot create SpatialIndex directly, use SpatialIndex.fromGeometries() or SpatialIndex.fromLayer() instead");
+    return;
+  }
+}
+
+Local<Value> SpatialIndex::New(SpatialIndex *index) {
+  Nan::EscapableHandleScope scope;
+
+  Local<Value> ext = Nan::New<External>(index);
+  Local<Object> obj =
+    Nan::NewInstance(Nan::GetFunction(Nan::New(SpatialIndex::constructor)).ToLocalChecked(), 1, &ext).ToLocalChecked();
+
+  return scope.Escape(obj);
+}
+
+NAN_METHOD(SpatialIndex::toString) {
+  Nan::HandleScope scope;
+  info.GetReturnValue().Set(Nan::New("SpatialIndex").ToLocalChecked());
+}
+
+/**
+ * Builds a spatial index from an array of geometries.
+ *
+ * @static
+ * @method fromGeometries
+ * @param {gdal.Geometry[]} geometries
+ * @throws Error
+ * @return {gdal.SpatialIndex}
+ */
+
+/**
+ * Builds a spatial index from an array of geometries.
+ * {{{async}}}
+ *
+ * @static
+ * @method fromGeometriesAsync
+ * @param {gdal.Geometry[]} geometries
+ * @param {callback<gdal.SpatialIndex>} [callback=undefined] {{{cb}}}
+ * @throws Error
+ * @return {Promise<gdal.SpatialIndex>}
+ */
+GDAL_ASYNCABLE_DEFINE(SpatialIndex::fromGeometries) {
+  Nan::HandleScope scope;
+
+  Local<Array> array;
+  NODE_ARG_ARRAY(0, "geometries", array);
+
+  std::vector<OGRGeometry *> geoms(array->Length());
+  std::vector<uv_sem_t *> locks(array->Length());
+  std::vector<Local<Object>> elements(array->Length());
+  for (unsigned i = 0; i < array->Length(); i++) {
+    Local<Value> element = Nan::Get(array, i).ToLocalChecked();
+    if (!IS_WRAPPED(element, Geometry)) {
+      Nan::ThrowTypeError("geometries must contain only Geometry objects");
+      return;
+    }
+    Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(element.As<Object>());
+    if (!geom->isAlive()) {
+      Nan::ThrowError("Geometry object has already been destroyed");
+      return;
+    }
+    geoms[i] = geom->get();
+    locks[i] = geom->getAsyncLock();
+    elements[i] = element.As<Object>();
+  }
+
+  GDALAsyncableJob<SpatialIndex *> job(0);
+  job.persist(array);
+  // The array can be modified while the job is running
+  job.persist(elements);
+  job.main = [geoms, locks](const GDALExecutionProgress &) {
+    SpatialIndex *index = new SpatialIndex();
+    // Only one geometry is locked at a time, the same geometry can appear more than once
+    for (size_t i = 0; i < geoms.size(); i++) {
+      uv_sem_wait(locks[i]);
+      OGRGeometry *clone = geoms[i]->clone();
+      uv_sem_post(locks[i]);
+      index->add(clone, i);
+    }
+    index->build();
+    return index;
+  };
+  job.rval = [](SpatialIndex *index, GetFromPersistentFunc) { return SpatialIndex::New(index); };
+  job.run(info, async, 1);
+}
+
+/**
+ * Builds a spatial index from the geometries of the features of a layer.
+ * The current spatial and attribute filters of the layer are respected.
+ * The layer is read from the start and its reading is reset afterwards,
+ * an ongoing iteration over its features will restart from the first feature.
+ *
+ * @static
+ * @method fromLayer
+ * @param {gdal.Layer} layer
+ * @throws Error
+ * @return {gdal.SpatialIndex}
+ */
+
+/**
+ * Builds a spatial index from the geometries of the features of a layer.
+ * The current spatial and attribute filters of the layer are respected.
+ * The layer is read from the start and its reading is reset afterwards,
+ * an ongoing iteration over its features will restart from the first feature.
+ * {{{async}}}
+ *
+ * @static
+ * @method fromLayerAsync
+ * @param {gdal.Layer} layer
+ * @param {callback<gdal.SpatialIndex>} [callback=undefined] {{{cb}}}
+ * @throws Error
+ * @return {Promise<gdal.SpatialIndex>}
+ */
+GDAL_ASYNCABLE_DEFINE(SpatialIndex::fromLayer) {
+  Nan::HandleScope scope;
+
+  Layer *layer;
+  NODE_ARG_WRAPPED(0, "layer", Layer, layer);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object has already been destroyed");
+    return;
+  }
+
+  OGRLayer *gdal_layer = layer->get();
+  GDALAsyncableJob<SpatialIndex *> job(layer->parent_uid);
+  job.persist(info[0].As<Object>());
+  job.main = [gdal_layer](const GDALExecutionProgress &) {
+    SpatialIndex *index = new SpatialIndex();
+    OGRFeature *feature;
+    gdal_layer->ResetReading();
+    while ((feature = gdal_layer->GetNextFeature()) != nullptr) {
+      index->add(feature->StealGeometry(), feature->GetFID());
+      OGRFeature::DestroyFeature(feature);
+    }
+    gdal_layer->ResetReading();
+    index->build();
+    return index;
+  };
+  job.rval = [](SpatialIndex *index, GetFromPersistentFunc) { return SpatialIndex::New(index); };
+  job.run(info, async, 1);
+}
+
+/**
+ * Returns the identifiers of the geometries whose envelopes intersect the given envelope.
+ *
+ * @method query
+ * @param {gdal.Envelope} envelope
+ * @throws Error
+ * @return {Float64Array}
+ */
+NAN_METHOD(SpatialIndex::query) {
+  Nan::HandleScope scope;
+
+  Local<Object> obj;
+  NODE_ARG_OBJECT(0, "envelope", obj);
+  OGREnvelope env;
+  NODE_DOUBLE_FROM_OBJ(obj, "minX", env.MinX);
+  NODE_DOUBLE_FROM_OBJ(obj, "maxX", env.MaxX);
+  NODE_DOUBLE_FROM_OBJ(obj, "minY", env.MinY);
+  NODE_DOUBLE_FROM_OBJ(obj, "maxY", env.MaxY);
+
+  SpatialIndex *index = Nan::ObjectWrap::Unwrap<SpatialIndex>(info.This());
+  std::vector<GIntBig> r;
+  index->tree.query(env, [index, &r](uint32_t i) { r.push_back(index->ids[i]); });
+  std::sort(r.begin(), r.end());
+
+  info.GetReturnValue().Set(idsToArray(r));
+}
+
+/**
+ * Returns the identifiers of the geometries that intersect the given geometry.
+ *
+ * The candidates are selected using their envelopes and then tested
+ * with an exact intersection test.
+ *
+ * @method intersecting
+ * @param {gdal.Geometry} geometry
+ * @throws Error
+ * @return {Float64Array}
+ */
+
+/**
+ * Returns the identifiers of the geometries that intersect the given geometry.
+ * {{{async}}}
+ *
+ * The candidates are selected using their envelopes and then tested
+ * with an exact intersection test.
+ *
+ * @method intersectingAsync
+ * @param {gdal.Geometry} geometry
+ * @param {callback<Float64Array>} [callback=undefined] {{{cb}}}
+ * @throws Error
+ * @return {Promise<Float64Array>}
+ */
+GDAL_ASYNCABLE_DEFINE(SpatialIndex::intersecting) {
+  Nan::HandleScope scope;
+
+  Geometry *geom;
+  NODE_ARG_WRAPPED(0, "geometry", Geometry, geom);
+
+  SpatialIndex *index = Nan::ObjectWrap::Unwrap<SpatialIndex>(info.This());
+  OGRGeometry *gdal_geom = geom->get();
+  uv_sem_t *async_lock = geom->getAsyncLock();
+
+  GDALAsyncableJob<std::vector<GIntBig>> job(0);
+  job.persist(info[0].As<Object>());
+  job.main = [index, gdal_geom, async_lock](const GDALExecutionProgress &) {
+    std::vector<GIntBig> r;
+    OGREnvelope env;
+    uv_sem_wait(async_lock);
+    gdal_geom->getEnvelope(&env);
+    index->tree.query(env, [index, gdal_geom, &r](uint32_t i) {
+      if (index->geoms[i]->Intersects(gdal_geom)) r.push_back(index->ids[i]);
+    });
+    uv_sem_post(async_lock);
+    std::sort(r.begin(), r.end());
+    return r;
+  };
+  job.rval = [](std::vector<GIntBig> r, GetFromPersistentFunc) { return idsToArray(r); };
+  job.run(info, async, 1);
+}
+
+/**
+ * Returns the identifiers of the `k` geometries closest to the given geometry,
+ * ordered by distance.
+ *
+ * @method nearest
+ * @param {gdal.Geometry} geometry
+ * @param {number} [k=1]
+ * @throws Error
+ * @return {Float64Array}
+ */
+
+/**
+ * Returns the identifiers of the `k` geometries closest to the given geometry,
+ * ordered by distance.
+ * {{{async}}}
+ *
+ * @method nearestAsync
+ * @param {gdal.Geometry} geometry
+ * @param {number} [k=1]
+ * @param {callback<Float64Array>} [callback=undefined] {{{cb}}}
+ * @throws Error
+ * @return {Promise<Float64Array>}
+ */
+GDAL_ASYNCABLE_DEFINE(SpatialIndex::nearest) {
+  Nan::HandleScope scope;
+
+  Geometry *geom;
+  int k = 1;
+  NODE_ARG_WRAPPED(0, "geometry", Geometry, geom);
+  NODE_ARG_INT_OPT(1, "k", k);
+  if (k < 0) {
+    Nan::ThrowRangeError("k must not be negative");
+    return;
+  }
+
+  SpatialIndex *index = Nan::ObjectWrap::Unwrap<SpatialIndex>(info.This());
+  OGRGeometry *gdal_geom = geom->get();
+  uv_sem_t *async_lock = geom->getAsyncLock();
+
+  GDALAsyncableJob<std::vector<GIntBig>> job(0);
+  job.persist(info[0].As<Object>());
+  job.main = [index, gdal_geom, async_lock, k](const GDALExecutionProgress &) {
+    OGREnvelope env;
+    uv_sem_wait(async_lock);
+    gdal_geom->getEnvelope(&env);
+    std::vector<uint32_t> nearest = index->tree.nearest(env, k, [index, gdal_geom, &env](uint32_t i) {
+      double d = index->geoms[i]->Distance(gdal_geom);
+      // Distance() returns -1 when GEOS is not available
+      return d < 0 ? STRtree::envDistance(index->envs[i], env) : d;
+    });
+    uv_sem_post(async_lock);
+    std::vector<GIntBig> r(nearest.size());
+    for (size_t i = 0; i < nearest.size(); i++) r[i] = index->ids[nearest[i]];
+    return r;
+  };
+  job.rval = [](std::vector<GIntBig> r, GetFromPersistentFunc) { return idsToArray(r); };
+  job.run(info, async, 2);
+}
+
+/**
+ * Number of indexed geometries, empty geometries are not indexed.
+ *
+ * @readOnly
+ * @attribute count
+ * @type {number}
+ */
+NAN_GETTER(SpatialIndex::countGetter) {
+  Nan::HandleScope scope;
+  SpatialIndex *index = Nan::ObjectWrap::Unwrap<SpatialIndex>(info.This());
+  info.GetReturnValue().Set(Nan::New<Number>(index->tree.size()));
+}
+
+} // namespace node_gdal
@@ -0,0 +1,54 @@
+#ifndef __NODE_GDAL_SPATIAL_INDEX_H__
+#define __NODE_GDAL_SPATIAL_INDEX_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include "async.hpp"
+#include "utils/strtree.hpp"
+
+using namespace v8;
+using namespace node;
+
+namespace node_gdal {
+
+// An immutable in-memory spatial index
+// It owns a copy of every indexed geometry for the exact predicates
+class SpatialIndex : public Nan::ObjectWrap {
+    public:
+  static Nan::Persistent<FunctionTemplate> constructor;
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(New);
+  static Local<Value> New(SpatialIndex *index);
+  static NAN_METHOD(toString);
+
+  GDAL_ASYNCABLE_DECLARE(fromGeometries);
+  GDAL_ASYNCABLE_DECLARE(fromLayer);
+  static NAN_METHOD(query);
+  GDAL_ASYNCABLE_DECLARE(intersecting);
+  GDAL_ASYNCABLE_DECLARE(nearest);
+
+  static NAN_GETTER(countGetter);
+
+  SpatialIndex();
+  // Takes ownership of the geometries
+  void add(OGRGeometry *geom, GIntBig id);
+  void build();
+
+    private:
+  ~SpatialIndex();
+  STRtree tree;
+  std::vector<OGRGeometry *> geoms;
+  std::vector<OGREnvelope> envs;
+  std::vector<GIntBig> ids;
+};
+
+} // namespace node_gdal
+#endif
@@ -1,5 +1,6 @@
 
 #include "gdal_spatial_reference.hpp"
+#include "gdal_srs_cache.hpp"
 #include "gdal_common.hpp"
 #include "utils/string_list.hpp"
 
@@ -744,10 +745,20 @@ NAN_METHOD(SpatialReference::fromUserInput) {
   std::string input("");
   NODE_ARG_STR(0, "input", input);
 
-  OGRSpatialReference *srs = new OGRSpatialReference();
-  int err = srs->SetFromUserInput(input.c_str());
+  OGRSpatialReference *srs = nullptr;
+  OGRErr err;
+  if (SRSCache::isCacheableUserInput(input)) {
+    err = SRSCache::getSRS(
+      "input:" + input,
+      [input](OGRSpatialReference *created) { return created->SetFromUserInput(input.c_str()); },
+      &srs);
+  } else {
+    // The content of a file or of a URL can change
+    srs = new OGRSpatialReference();
+    err = srs->SetFromUserInput(input.c_str());
+    if (err) delete srs;
+  }
   if (err) {
-    delete srs;
     NODE_THROW_OGRERR(err);
     return;
   }
@@ -774,10 +785,12 @@ NAN_METHOD(SpatialReference::fromEPSG) {
   int epsg;
   NODE_ARG_INT(0, "epsg", epsg);
 
-  OGRSpatialReference *srs = new OGRSpatialReference();
-  int err = srs->importFromEPSG(epsg);
+  OGRSpatialReference *srs = nullptr;
+  OGRErr err = SRSCache::getSRS(
+    "EPSG:" + std::to_string(epsg),
+    [epsg](OGRSpatialReference *created) { return created->importFromEPSG(epsg); },
+    &srs);
   if (err) {
-    delete srs;
     NODE_THROW_OGRERR(err);
     return;
   }
@@ -810,10 +823,12 @@ NAN_METHOD(SpatialReference::fromEPSGA) {
   int epsg;
   NODE_ARG_INT(0, "epsg", epsg);
 
-  OGRSpatialReference *srs = new OGRSpatialReference();
-  int err = srs->importFromEPSGA(epsg);
+  OGRSpatialReference *srs = nullptr;
+  OGRErr err = SRSCache::getSRS(
+    "EPSGA:" + std::to_string(epsg),
+    [epsg](OGRSpatialReference *created) { return created->importFromEPSGA(epsg); },
+    &srs);
   if (err) {
-    delete srs;
     NODE_THROW_OGRERR(err);
     return;
   }
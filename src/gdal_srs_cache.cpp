@@ -0,0 +1,217 @@
+#include "gdal_srs_cache.hpp"
+#include "gdal_common.hpp"
+
+#include <cctype>
+#include <sstream>
+
+namespace node_gdal {
+
+/**
+ * @for gdal
+ * @property srsCache
+ * @type {srsCache}
+ */
+
+/**
+ * Process-wide cache of the spatial references created by
+ * `gdal.SpatialReference.fromEPSG()`, `fromEPSGA()` and `fromUserInput()`,
+ * except when the latter receives a file name or a URL,
+ * and of the coordinate transformations created by `new gdal.CoordinateTransformation()`
+ * and `gdal.Geometry.transformTo()`.
+ *
+ * Every call still returns a new independent object cloned from the cached one,
+ * which avoids looking up the PROJ database and building the transformation pipeline.
+ *
+ * @class srsCache
+ */
+
+std::mutex SRSCache::lock;
+LRUCache<std::string, OGRSpatialReference *> *SRSCache::srs_cache =
+  new LRUCache<std::string, OGRSpatialReference *>(256, [](OGRSpatialReference *&srs) { srs->Release(); });
+LRUCache<std::string, OGRCoordinateTransformation *> *SRSCache::ct_cache =
+  new LRUCache<std::string, OGRCoordinateTransformation *>(
+    256, [](OGRCoordinateTransformation *&ct) { OGRCoordinateTransformation::DestroyCT(ct); });
+uint64_t SRSCache::srs_hits = 0;
+uint64_t SRSCache::srs_misses = 0;
+uint64_t SRSCache::ct_hits = 0;
+uint64_t SRSCache::ct_misses = 0;
+
+void SRSCache::Initialize(Local<Object> target) {
+  Local<Object> cache = Nan::New<Object>();
+  Nan::Set(target, Nan::New("srsCache").ToLocalChecked(), cache);
+  Nan::SetMethod(cache, "clear", clear);
+  Nan::SetMethod(cache, "stats", stats);
+  Nan::SetMethod(cache, "setMaxSize", setMaxSize);
+}
+
+OGRErr SRSCache::getSRS(
+  const std::string &key, const std::function<OGRErr(OGRSpatialReference *)> &init, OGRSpatialReference **srs) {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    OGRSpatialReference **cached = srs_cache->get(key);
+    if (cached != nullptr) {
+      srs_hits++;
+      *srs = (*cached)->Clone();
+      return OGRERR_NONE;
+    }
+    srs_misses++;
+  }
+
+  // Do not hold the lock while querying the database
+  OGRSpatialReference *created = new OGRSpatialReference();
+  OGRErr err = init(created);
+  if (err) {
+    delete created;
+    return err;
+  }
+  *srs = created->Clone();
+
+  std::lock_guard<std::mutex> guard(lock);
+  srs_cache->put(key, created);
+  return OGRERR_NONE;
+}
+
+// Authority codes (EPSG:4326, urn:ogc:def:crs:EPSG::4326), PROJ strings,
+// PROJJSON, WKT and the few well-known names
+bool SRSCache::isCacheableUserInput(const std::string &input) {
+  static const char *names[] = {"WGS84", "WGS72", "NAD27", "NAD83", "CRS84", "CRS83", "CRS27"};
+  size_t start = input.find_first_not_of(" \t\r\n");
+  if (start == std::string::npos) return false;
+  const unsigned char *str = reinterpret_cast<const unsigned char *>(input.c_str()) + start;
+
+  if (*str == '+' || *str == '{') return true;
+  for (const char *name : names)
+    if (!strcmp(reinterpret_cast<const char *>(str), name)) return true;
+
+  // WKT, a keyword immediately followed by its opening bracket
+  const unsigned char *p = str;
+  while (isupper(*p) || isdigit(*p) || *p == '_') p++;
+  if (p > str && (*p == '[' || *p == '(')) return true;
+
+  // AUTHORITY:CODE, the authority must have more than one character to exclude the Windows drive letters
+  p = str;
+  while (isalnum(*p) || *p == '_' || *p == '-') p++;
+  return p - str > 1 && *p == ':' && input.find_first_of("/\\") == std::string::npos;
+}
+
+// The key must include everything that influences the transformation
+bool SRSCache::key(const OGRSpatialReference *srs, std::string &key) {
+  std::ostringstream ss;
+  char *wkt = nullptr;
+#if GDAL_VERSION_MAJOR >= 3
+  const char *options[] = {"FORMAT=WKT2_2018", "MULTILINE=NO", nullptr};
+  OGRErr err = srs->exportToWkt(&wkt, options);
+#else
+  OGRErr err = srs->exportToWkt(&wkt);
+#endif
+  bool ok = err == OGRERR_NONE && wkt != nullptr && *wkt != '\0';
+  if (ok) {
+    ss << wkt;
+#if GDAL_VERSION_MAJOR >= 3
+    for (int axis : srs->GetDataAxisToSRSAxisMapping()) ss << "," << axis;
+#endif
+    key = ss.str();
+  }
+  CPLFree(wkt);
+  return ok;
+}
+
+// The transformations are always created with the default OGRCoordinateTransformationOptions,
+// the key is complete as long as none of the callers need any options - those that do must not use the cache
+OGRCoordinateTransformation *SRSCache::getCT(const OGRSpatialReference *src, const OGRSpatialReference *dst) {
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
+  std::string src_key, dst_key;
+  // Two different SRS that cannot be exported would share the same key
+  if (!key(src, src_key) || !key(dst, dst_key)) return OGRCreateCoordinateTransformation(src, dst);
+  std::string ct_key = src_key + "|" + dst_key;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    OGRCoordinateTransformation **cached = ct_cache->get(ct_key);
+    if (cached != nullptr) {
+      ct_hits++;
+      return (*cached)->Clone();
+    }
+    ct_misses++;
+  }
+
+  OGRCoordinateTransformation *created = OGRCreateCoordinateTransformation(src, dst);
+  if (created == nullptr) return nullptr;
+  OGRCoordinateTransformation *r = created->Clone();
+
+  std::lock_guard<std::mutex> guard(lock);
+  ct_cache->put(ct_key, created);
+  return r;
+#else
+  // Transformations cannot be cloned
+  return OGRCreateCoordinateTransformation(src, dst);
+#endif
+}
+
+/**
+ * Empties the cache and resets the counters.
+ *
+ * @method clear
+ */
+NAN_METHOD(SRSCache::clear) {
+  std::lock_guard<std::mutex> guard(lock);
+  srs_cache->clear();
+  ct_cache->clear();
+  srs_hits = srs_misses = ct_hits = ct_misses = 0;
+}
+
+/**
+ * @typedef SRSCacheStats { srs: { hits: number, misses: number, size: number, maxSize: number }, transformations: { hits: number, misses: number, size: number, maxSize: number } }
+ */
+
+/**
+ * Returns the hit and miss counters, the current number of cached objects
+ * and the capacity of the spatial references and of the transformations caches.
+ *
+ * @method stats
+ * @return {SRSCacheStats}
+ */
+NAN_METHOD(SRSCache::stats) {
+  Nan::HandleScope scope;
+  std::lock_guard<std::mutex> guard(lock);
+
+  auto counters = [](uint64_t hits, uint64_t misses, size_t size, size_t max) {
+    Local<Object> obj = Nan::New<Object>();
+    Nan::Set(obj, Nan::New("hits").ToLocalChecked(), Nan::New<Number>((double)hits));
+    Nan::Set(obj, Nan::New("misses").ToLocalChecked(), Nan::New<Number>((double)misses));
+    Nan::Set(obj, Nan::New("size").ToLocalChecked(), Nan::New<Number>((double)size));
+    Nan::Set(obj, Nan::New("maxSize").ToLocalChecked(), Nan::New<Number>((double)max));
+    return obj;
+  };
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(
+    result,
+    Nan::New("srs").ToLocalChecked(),
+    counters(srs_hits, srs_misses, srs_cache->size(), srs_cache->getMax()));
+  Nan::Set(
+    result,
+    Nan::New("transformations").ToLocalChecked(),
+    counters(ct_hits, ct_misses, ct_cache->size(), ct_cache->getMax()));
+  info.GetReturnValue().Set(result);
+}
+
+/**
+ * Sets the maximum number of spatial references and of transformations
+ * kept in the cache, `0` disables the cache. The default is 256.
+ *
+ * @method setMaxSize
+ * @param {number} size
+ */
+NAN_METHOD(SRSCache::setMaxSize) {
+  Nan::HandleScope scope;
+  int size;
+  NODE_ARG_INT(0, "size", size);
+  if (size < 0) {
+    Nan::ThrowRangeError("size must not be negative");
+    return;
+  }
+  std::lock_guard<std::mutex> guard(lock);
+  srs_cache->setMax(size);
+  ct_cache->setMax(size);
+}
+
+} // namespace node_gdal
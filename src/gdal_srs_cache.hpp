@@ -0,0 +1,58 @@
+#ifndef __NODE_GDAL_SRS_CACHE_H__
+#define __NODE_GDAL_SRS_CACHE_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// ogr
+#include <ogr_spatialref.h>
+
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "utils/lru_cache.hpp"
+
+using namespace v8;
+
+namespace node_gdal {
+
+// A process-wide cache of the spatial references and the coordinate transformations
+// that are expensive to create because they need the PROJ database
+//
+// Neither OGRSpatialReference nor OGRCoordinateTransformation are thread-safe,
+// so the cache keeps the original objects and returns clones that can
+// be used from any thread
+class SRSCache {
+    public:
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(clear);
+  static NAN_METHOD(stats);
+  static NAN_METHOD(setMaxSize);
+
+  // Returns a new SRS owned by the caller in *srs
+  // init is called on a new SRS only on a cache miss
+  static OGRErr getSRS(
+    const std::string &key, const std::function<OGRErr(OGRSpatialReference *)> &init, OGRSpatialReference **srs);
+  // Returns a new transformation owned by the caller, nullptr on error
+  static OGRCoordinateTransformation *getCT(const OGRSpatialReference *src, const OGRSpatialReference *dst);
+  // True if the result of SetFromUserInput() depends only on the string itself,
+  // false for the file names and the URLs whose content can change
+  static bool isCacheableUserInput(const std::string &input);
+
+    private:
+  // Returns false if the SRS cannot be exported
+  static bool key(const OGRSpatialReference *srs, std::string &key);
+
+  static std::mutex lock;
+  // Never freed, they must outlive PROJ at exit
+  static LRUCache<std::string, OGRSpatialReference *> *srs_cache;
+  static LRUCache<std::string, OGRCoordinateTransformation *> *ct_cache;
+  static uint64_t srs_hits, srs_misses, ct_hits, ct_misses;
+};
+
+} // namespace node_gdal
+#endif
@@ -0,0 +1,547 @@
+#include "gdal_utils.hpp"
+#include "gdal_common.hpp"
+#include "gdal_dataset.hpp"
+#include "utils/string_list.hpp"
+
+#include <memory>
+
+namespace node_gdal {
+
+void Utils::Initialize(Local<Object> target) {
+  Nan__SetAsyncableMethod(target, "translate", translate);
+  Nan__SetAsyncableMethod(target, "vectorTranslate", vectorTranslate);
+  Nan__SetAsyncableMethod(target, "warp", warp);
+  Nan__SetAsyncableMethod(target, "buildVRT", buildVRT);
+  Nan__SetAsyncableMethod(target, "demProcessing", demProcessing);
+}
+
+static auto UtilsDatasetRval = [](GDALDataset *ds, GetFromPersistentFunc) { return Dataset::New(ds); };
+
+// A VRT references its source datasets without owning them
+// -> the JS objects of the sources, persisted as "sources", are attached to the VRT and live as long as it
+static auto UtilsVRTRval = [](GDALDataset *ds, GetFromPersistentFunc getter) {
+  Nan::EscapableHandleScope scope;
+  Local<Value> r = Dataset::New(ds);
+  GDALDriver *drv = ds->GetDriver();
+  if (r->IsObject() && drv != nullptr && EQUAL(drv->GetDescription(), "VRT"))
+    Nan::SetPrivate(r.As<Object>(), Nan::New("sources_").ToLocalChecked(), getter("sources"));
+  return scope.Escape(r);
+};
+
+static Local<Array> toArray(const std::vector<Local<Object>> &objs) {
+  Nan::EscapableHandleScope scope;
+  Local<Array> array = Nan::New<Array>(objs.size());
+  for (size_t i = 0; i < objs.size(); i++) Nan::Set(array, i, objs[i]);
+  return scope.Escape(array);
+}
+
+// The command-line arguments, an optional array of strings
+static bool parseArgs(const Nan::FunctionCallbackInfo<Value> &info, int num, StringList &args) {
+  if (info.Length() <= num || info[num]->IsUndefined() || info[num]->IsNull()) return true;
+  if (!info[num]->IsArray()) {
+    Nan::ThrowTypeError("args must be an array of strings");
+    return false;
+  }
+  return args.parse(info[num]) == 0;
+}
+
+// An array of open Datasets
+static bool parseDatasets(
+  Local<Value> val,
+  const char *name,
+  std::vector<GDALDatasetH> &handles,
+  std::vector<long> &uids,
+  std::vector<Local<Object>> &objs) {
+  if (!val->IsArray()) {
+    Nan::ThrowTypeError((std::string(name) + " must be an array of Datasets").c_str());
+    return false;
+  }
+  Local<Array> array = val.As<Array>();
+  for (unsigned i = 0; i < array->Length(); i++) {
+    Local<Value> item = Nan::Get(array, i).ToLocalChecked();
+    if (!item->IsObject() || !IS_WRAPPED(item, Dataset)) {
+      Nan::ThrowTypeError((std::string(name) + " must be an array of Datasets").c_str());
+      return false;
+    }
+    Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(item.As<Object>());
+    if (!ds->isAlive()) {
+      Nan::ThrowError("Dataset object has already been destroyed");
+      return false;
+    }
+    handles.push_back(ds->get());
+    uids.push_back(ds->uid);
+    objs.push_back(item.As<Object>());
+  }
+  return true;
+}
+
+/**
+ * @typedef UtilOptions { progress_cb?: ProgressCb }
+ */
+
+/**
+ * Library version of the gdal_translate command-line tool, converts raster data
+ * between different formats and can perform subsetting, resampling and rescaling.
+ *
+ * A VRT output keeps a reference to the source dataset which won't be
+ * garbage-collected before it.
+ *
+ * @example
+ * ```
+ * const ds = gdal.open('input.tif');
+ * const out = gdal.translate('output.png', ds, [ '-of', 'PNG', '-outsize', '50%', '50%' ]);
+ * ```
+ *
+ * @throws Error
+ * @method translate
+ * @static
+ * @for gdal
+ * @param {string} destination Destination dataset path
+ * @param {gdal.Dataset} source Source dataset
+ * @param {string[]} [args] Command-line arguments, see https://gdal.org/programs/gdal_translate.html
+ * @param {UtilOptions} [options] Additional options
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @return {gdal.Dataset}
+ */
+
+/**
+ * Library version of the gdal_translate command-line tool, converts raster data
+ * between different formats and can perform subsetting, resampling and rescaling.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method translateAsync
+ * @static
+ * @for gdal
+ * @param {string} destination Destination dataset path
+ * @param {gdal.Dataset} source Source dataset
+ * @param {string[]} [args] Command-line arguments, see https://gdal.org/programs/gdal_translate.html
+ * @param {UtilOptions} [options] Additional options
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @param {callback<gdal.Dataset>} [callback=undefined] {{{cb}}}
+ * @return {Promise<gdal.Dataset>}
+ */
+GDAL_ASYNCABLE_DEFINE(Utils::translate) {
+  Nan::HandleScope scope;
+
+  std::string destination;
+  Dataset *src;
+  StringList args;
+  Nan::Callback *progress_cb;
+
+  NODE_ARG_STR(0, "destination", destination);
+  NODE_ARG_WRAPPED(1, "source", Dataset, src);
+  if (!parseArgs(info, 2, args)) return;
+
+  CPLErrorReset();
+  std::shared_ptr<GDALTranslateOptions> options(GDALTranslateOptionsNew(args.get(), nullptr), GDALTranslateOptionsFree);
+  if (options == nullptr) {
+    NODE_THROW_LAST_CPLERR;
+    return;
+  }
+
+  GDALAsyncableJob<GDALDataset *> job(src->uid);
+  job.persist("sources", info[1].As<Object>());
+  NODE_PROGRESS_CB_OPT(3, progress_cb, job);
+
+  GDALDatasetH raw = src->get();
+  job.main = [destination, raw, options, progress_cb](const GDALExecutionProgress &progress) {
+    if (progress_cb) GDALTranslateOptionsSetProgress(options.get(), ProgressTrampoline, (void *)&progress);
+    CPLErrorReset();
+    GDALDatasetH ds = GDALTranslate(destination.c_str(), raw, options.get(), nullptr);
+    if (ds == nullptr) throw CPLGetLastErrorMsg();
+    return GDALDataset::FromHandle(ds);
+  };
+  job.rval = UtilsVRTRval;
+  job.run(info, async, 4);
+}
+
+/**
+ * Library version of the ogr2ogr command-line tool, converts vector data
+ * between different formats and can perform reprojection, filtering and SQL queries.
+ *
+ * @example
+ * ```
+ * const ds = gdal.open('input.shp');
+ * const out = gdal.vectorTranslate('output.gpkg', ds, [ '-f', 'GPKG', '-t_srs', 'EPSG:4326' ]);
+ * ```
+ *
+ * @throws Error
+ * @method vectorTranslate
+ * @static
+ * @for gdal
+ * @param {string|gdal.Dataset} destination Destination dataset path or an open dataset to update
+ * @param {gdal.Dataset} source Source dataset
+ * @param {string[]} [args] Command-line arguments, see https://gdal.org/programs/ogr2ogr.html
+ * @param {UtilOptions} [options] Additional options
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @return {gdal.Dataset}
+ */
+
+/**
+ * Library version of the ogr2ogr command-line tool, converts vector data
+ * between different formats and can perform reprojection, filtering and SQL queries.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method vectorTranslateAsync
+ * @static
+ * @for gdal
+ * @param {string|gdal.Dataset} destination Destination dataset path or an open dataset to update
+ * @param {gdal.Dataset} source Source dataset
+ * @param {string[]} [args] Command-line arguments, see https://gdal.org/programs/ogr2ogr.html
+ * @param {UtilOptions} [options] Additional options
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @param {callback<gdal.Dataset>} [callback=undefined] {{{cb}}}
+ * @return {Promise<gdal.Dataset>}
+ */
+GDAL_ASYNCABLE_DEFINE(Utils::vectorTranslate) {
+  Nan::HandleScope scope;
+
+  std::string destination;
+  Dataset *dst = nullptr;
+  Dataset *src;
+  StringList args;
+  Nan::Callback *progress_cb;
+
+  if (info.Length() > 0 && info[0]->IsObject() && IS_WRAPPED(info[0], Dataset)) {
+    NODE_ARG_WRAPPED(0, "destination", Dataset, dst);
+  } else {
+    NODE_ARG_STR(0, "destination", destination);
+  }
+  NODE_ARG_WRAPPED(1, "source", Dataset, src);
+  if (!parseArgs(info, 2, args)) return;
+
+  CPLErrorReset();
+  std::shared_ptr<GDALVectorTranslateOptions> options(
+    GDALVectorTranslateOptionsNew(args.get(), nullptr), GDALVectorTranslateOptionsFree);
+  if (options == nullptr) {
+    NODE_THROW_LAST_CPLERR;
+    return;
+  }
+
+  std::vector<long> uids = {src->uid};
+  if (dst != nullptr) uids.push_back(dst->uid);
+  GDALAsyncableJob<GDALDataset *> job(uids);
+  job.persist(info[1].As<Object>());
+  if (dst != nullptr) job.persist(info[0].As<Object>());
+  NODE_PROGRESS_CB_OPT(3, progress_cb, job);
+
+  GDALDatasetH raw_src = src->get();
+  GDALDatasetH raw_dst = dst != nullptr ? dst->get() : nullptr;
+  job.main = [destination, raw_dst, raw_src, options, progress_cb](const GDALExecutionProgress &progress) {
+    if (progress_cb) GDALVectorTranslateOptionsSetProgress(options.get(), ProgressTrampoline, (void *)&progress);
+    CPLErrorReset();
+    GDALDatasetH src = raw_src;
+    GDALDatasetH ds = GDALVectorTranslate(
+      raw_dst == nullptr ? destination.c_str() : nullptr, raw_dst, 1, &src, options.get(), nullptr);
+    if (ds == nullptr) throw CPLGetLastErrorMsg();
+    return GDALDataset::FromHandle(ds);
+  };
+  job.rval = UtilsDatasetRval;
+  job.run(info, async, 4);
+}
+
+/**
+ * Library version of the gdalwarp command-line tool, mosaics, reprojects and warps rasters.
+ *
+ * The warping can use multiple threads with the `-multi` and `-wo NUM_THREADS=ALL_CPUS` arguments.
+ * A VRT output keeps a reference to the source datasets which won't be garbage-collected before it.
+ *
+ * @example
+ * ```
+ * const ds = gdal.open('input.tif');
+ * const out = gdal.warp('output.tif', null, [ ds ], [ '-t_srs', 'EPSG:3857', '-multi', '-wo', 'NUM_THREADS=ALL_CPUS' ]);
+ * ```
+ *
+ * @throws Error
+ * @method warp
+ * @static
+ * @for gdal
+ * @param {string|null} destination Destination dataset path, `null` when warping into an existing dataset
+ * @param {gdal.Dataset|null} dst An existing dataset to warp into
+ * @param {gdal.Dataset[]} sources Source datasets
+ * @param {string[]} [args] Command-line arguments, see https://gdal.org/programs/gdalwarp.html
+ * @param {UtilOptions} [options] Additional options
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @return {gdal.Dataset}
+ */
+
+/**
+ * Library version of the gdalwarp command-line tool, mosaics, reprojects and warps rasters.
+ * {{{async}}}
+ *
+ * The warping can use multiple threads with the `-multi` and `-wo NUM_THREADS=ALL_CPUS` arguments.
+ *
+ * @throws Error
+ * @method warpAsync
+ * @static
+ * @for gdal
+ * @param {string|null} destination Destination dataset path, `null` when warping into an existing dataset
+ * @param {gdal.Dataset|null} dst An existing dataset to warp into
+ * @param {gdal.Dataset[]} sources Source datasets
+ * @param {string[]} [args] Command-line arguments, see https://gdal.org/programs/gdalwarp.html
+ * @param {UtilOptions} [options] Additional options
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @param {callback<gdal.Dataset>} [callback=undefined] {{{cb}}}
+ * @return {Promise<gdal.Dataset>}
+ */
+GDAL_ASYNCABLE_DEFINE(Utils::warp) {
+  Nan::HandleScope scope;
+
+  std::string destination;
+  Dataset *dst = nullptr;
+  std::vector<GDALDatasetH> sources;
+  std::vector<long> uids;
+  std::vector<Local<Object>> objs;
+  StringList args;
+  Nan::Callback *progress_cb;
+
+  NODE_ARG_OPT_STR(0, "destination", destination);
+  NODE_ARG_WRAPPED_OPT(1, "dst", Dataset, dst);
+  if (destination.empty() && dst == nullptr) {
+    Nan::ThrowError("Either destination or dst must be provided");
+    return;
+  }
+  if (info.Length() < 3) {
+    Nan::ThrowError("sources must be provided");
+    return;
+  }
+  if (!parseDatasets(info[2], "sources", sources, uids, objs)) return;
+  if (sources.empty()) {
+    Nan::ThrowError("sources must contain at least one Dataset");
+    return;
+  }
+  if (!parseArgs(info, 3, args)) return;
+
+  CPLErrorReset();
+  std::shared_ptr<GDALWarpAppOptions> options(GDALWarpAppOptionsNew(args.get(), nullptr), GDALWarpAppOptionsFree);
+  if (options == nullptr) {
+    NODE_THROW_LAST_CPLERR;
+    return;
+  }
+
+  Local<Array> sources_obj = toArray(objs);
+  if (dst != nullptr) {
+    uids.push_back(dst->uid);
+    objs.push_back(info[1].As<Object>());
+  }
+  GDALAsyncableJob<GDALDataset *> job(uids);
+  job.persist(objs);
+  job.persist("sources", sources_obj);
+  NODE_PROGRESS_CB_OPT(4, progress_cb, job);
+
+  GDALDatasetH raw_dst = dst != nullptr ? dst->get() : nullptr;
+  job.main = [destination, raw_dst, sources, options, progress_cb](const GDALExecutionProgress &progress) {
+    if (progress_cb) GDALWarpAppOptionsSetProgress(options.get(), ProgressTrampoline, (void *)&progress);
+    CPLErrorReset();
+    std::vector<GDALDatasetH> src = sources;
+    GDALDatasetH ds = GDALWarp(
+      raw_dst == nullptr ? destination.c_str() : nullptr,
+      raw_dst,
+      static_cast<int>(src.size()),
+      src.data(),
+      options.get(),
+      nullptr);
+    if (ds == nullptr) throw CPLGetLastErrorMsg();
+    return GDALDataset::FromHandle(ds);
+  };
+  job.rval = UtilsVRTRval;
+  job.run(info, async, 5);
+}
+
+/**
+ * Library version of the gdalbuildvrt command-line tool, builds a VRT mosaic
+ * from a list of datasets or files.
+ *
+ * The returned VRT keeps a reference to the source datasets which won't be
+ * garbage-collected before it. They must not be closed while the VRT is in use.
+ *
+ * @example
+ * ```
+ * const vrt = gdal.buildVRT('mosaic.vrt', [ 'tile1.tif', 'tile2.tif' ], [ '-resolution', 'highest' ]);
+ * ```
+ *
+ * @throws Error
+ * @method buildVRT
+ * @static
+ * @for gdal
+ * @param {string} destination Destination dataset path, can be an empty string for an in-memory VRT
+ * @param {gdal.Dataset[]|string[]} sources Source datasets or file names
+ * @param {string[]} [args] Command-line arguments, see https://gdal.org/programs/gdalbuildvrt.html
+ * @param {UtilOptions} [options] Additional options
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @return {gdal.Dataset}
+ */
+
+/**
+ * Library version of the gdalbuildvrt command-line tool, builds a VRT mosaic
+ * from a list of datasets or files.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method buildVRTAsync
+ * @static
+ * @for gdal
+ * @param {string} destination Destination dataset path, can be an empty string for an in-memory VRT
+ * @param {gdal.Dataset[]|string[]} sources Source datasets or file names
+ * @param {string[]} [args] Command-line arguments, see https://gdal.org/programs/gdalbuildvrt.html
+ * @param {UtilOptions} [options] Additional options
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @param {callback<gdal.Dataset>} [callback=undefined] {{{cb}}}
+ * @return {Promise<gdal.Dataset>}
+ */
+GDAL_ASYNCABLE_DEFINE(Utils::buildVRT) {
+  Nan::HandleScope scope;
+
+  std::string destination;
+  std::vector<GDALDatasetH> sources;
+  std::vector<long> uids;
+  std::vector<Local<Object>> objs;
+  auto names = std::make_shared<StringList>();
+  StringList args;
+  Nan::Callback *progress_cb;
+
+  NODE_ARG_STR(0, "destination", destination);
+  if (info.Length() < 2 || !info[1]->IsArray()) {
+    Nan::ThrowTypeError("sources must be an array of Datasets or an array of strings");
+    return;
+  }
+  Local<Array> array = info[1].As<Array>();
+  if (array->Length() > 0 && Nan::Get(array, 0).ToLocalChecked()->IsString()) {
+    if (names->parse(array)) return;
+  } else {
+    if (!parseDatasets(array, "sources", sources, uids, objs)) return;
+  }
+  if (array->Length() == 0) {
+    Nan::ThrowError("sources must contain at least one element");
+    return;
+  }
+  if (!parseArgs(info, 2, args)) return;
+
+  CPLErrorReset();
+  std::shared_ptr<GDALBuildVRTOptions> options(GDALBuildVRTOptionsNew(args.get(), nullptr), GDALBuildVRTOptionsFree);
+  if (options == nullptr) {
+    NODE_THROW_LAST_CPLERR;
+    return;
+  }
+
+  // File names do not need any locking
+  if (uids.empty()) uids.push_back(0);
+  GDALAsyncableJob<GDALDataset *> job(uids);
+  job.persist("sources", toArray(objs));
+  NODE_PROGRESS_CB_OPT(3, progress_cb, job);
+
+  int count = static_cast<int>(array->Length());
+  job.main = [destination, count, sources, names, options, progress_cb](const GDALExecutionProgress &progress) {
+    if (progress_cb) GDALBuildVRTOptionsSetProgress(options.get(), ProgressTrampoline, (void *)&progress);
+    CPLErrorReset();
+    std::vector<GDALDatasetH> src = sources;
+    GDALDatasetH ds = GDALBuildVRT(
+      destination.c_str(), count, src.empty() ? nullptr : src.data(), names->get(), options.get(), nullptr);
+    if (ds == nullptr) throw CPLGetLastErrorMsg();
+    return GDALDataset::FromHandle(ds);
+  };
+  job.rval = UtilsVRTRval;
+  job.run(info, async, 4);
+}
+
+/**
+ * @typedef DEMProcessingOptions { colorFile?: string, progress_cb?: ProgressCb }
+ */
+
+/**
+ * Library version of the gdaldem command-line tool, analyzes and visualizes DEMs.
+ *
+ * @example
+ * ```
+ * const dem = gdal.open('dem.tif');
+ * const hillshade = gdal.demProcessing('hillshade.tif', dem, 'hillshade', [ '-z', '2' ]);
+ * ```
+ *
+ * @throws Error
+ * @method demProcessing
+ * @static
+ * @for gdal
+ * @param {string} destination Destination dataset path
+ * @param {gdal.Dataset} source Source dataset
+ * @param {string} mode One of `hillshade`, `slope`, `aspect`, `color-relief`, `TRI`, `TPI` or `roughness`
+ * @param {string[]} [args] Command-line arguments, see https://gdal.org/programs/gdaldem.html
+ * @param {DEMProcessingOptions} [options] Additional options
+ * @param {string} [options.colorFile] Color configuration file, required for `color-relief`
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @return {gdal.Dataset}
+ */
+
+/**
+ * Library version of the gdaldem command-line tool, analyzes and visualizes DEMs.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method demProcessingAsync
+ * @static
+ * @for gdal
+ * @param {string} destination Destination dataset path
+ * @param {gdal.Dataset} source Source dataset
+ * @param {string} mode One of `hillshade`, `slope`, `aspect`, `color-relief`, `TRI`, `TPI` or `roughness`
+ * @param {string[]} [args] Command-line arguments, see https://gdal.org/programs/gdaldem.html
+ * @param {DEMProcessingOptions} [options] Additional options
+ * @param {string} [options.colorFile] Color configuration file, required for `color-relief`
+ * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @param {callback<gdal.Dataset>} [callback=undefined] {{{cb}}}
+ * @return {Promise<gdal.Dataset>}
+ */
+GDAL_ASYNCABLE_DEFINE(Utils::demProcessing) {
+  Nan::HandleScope scope;
+
+  std::string destination;
+  Dataset *src;
+  std::string mode;
+  std::string color_file;
+  StringList args;
+  Nan::Callback *progress_cb;
+
+  NODE_ARG_STR(0, "destination", destination);
+  NODE_ARG_WRAPPED(1, "source", Dataset, src);
+  NODE_ARG_STR(2, "mode", mode);
+  if (!parseArgs(info, 3, args)) return;
+  if (info.Length() > 4 && info[4]->IsObject()) {
+    Local<Object> obj = info[4].As<Object>();
+    NODE_STR_FROM_OBJ_OPT(obj, "colorFile", color_file);
+  }
+  if (mode == "color-relief" && color_file.empty()) {
+    Nan::ThrowError("colorFile must be provided for color-relief");
+    return;
+  }
+
+  CPLErrorReset();
+  std::shared_ptr<GDALDEMProcessingOptions> options(
+    GDALDEMProcessingOptionsNew(args.get(), nullptr), GDALDEMProcessingOptionsFree);
+  if (options == nullptr) {
+    NODE_THROW_LAST_CPLERR;
+    return;
+  }
+
+  GDALAsyncableJob<GDALDataset *> job(src->uid);
+  job.persist(info[1].As<Object>());
+  NODE_PROGRESS_CB_OPT(4, progress_cb, job);
+
+  GDALDatasetH raw = src->get();
+  job.main = [destination, raw, mode, color_file, options, progress_cb](const GDALExecutionProgress &progress) {
+    if (progress_cb) GDALDEMProcessingOptionsSetProgress(options.get(), ProgressTrampoline, (void *)&progress);
+    CPLErrorReset();
+    GDALDatasetH ds = GDALDEMProcessing(
+      destination.c_str(),
+      raw,
+      mode.c_str(),
+      color_file.empty() ? nullptr : color_file.c_str(),
+      options.get(),
+      nullptr);
+    if (ds == nullptr) throw CPLGetLastErrorMsg();
+    return GDALDataset::FromHandle(ds);
+  };
+  job.rval = UtilsDatasetRval;
+  job.run(info, async, 5);
+}
+
+} // namespace node_gdal
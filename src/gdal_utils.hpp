@@ -0,0 +1,37 @@
+#ifndef __GDAL_UTILS_H__
+#define __GDAL_UTILS_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// gdal
+#include <gdal_priv.h>
+#include <gdal_utils.h>
+
+#include "async.hpp"
+
+using namespace v8;
+using namespace node;
+
+// Methods from gdal_utils.h, the library versions of the GDAL command-line tools
+// https://gdal.org/api/gdal_utils.html
+
+namespace node_gdal {
+namespace Utils {
+
+void Initialize(Local<Object> target);
+
+GDAL_ASYNCABLE_GLOBAL(translate);
+GDAL_ASYNCABLE_GLOBAL(vectorTranslate);
+GDAL_ASYNCABLE_GLOBAL(warp);
+GDAL_ASYNCABLE_GLOBAL(buildVRT);
+GDAL_ASYNCABLE_GLOBAL(demProcessing);
+
+} // namespace Utils
+} // namespace node_gdal
+
+#endif
@@ -0,0 +1,492 @@
+#include "gdal_vsinode.hpp"
+#include "gdal_common.hpp"
+
+#include <string.h>
+
+namespace node_gdal {
+
+/**
+ * @for gdal
+ * @property vsinode
+ * @type {vsinode}
+ */
+
+/**
+ * Read-only /vsinode/ files served by asynchronous JS callbacks
+ *
+ * Once a backend has been registered with `gdal.vsinode.register(name, {stat, read})`,
+ * every `/vsinode/<name>/<path>` file opened by GDAL is read through these callbacks,
+ * allowing to serve data from any JS source - an HTTP client, a database, a cloud SDK...
+ *
+ * The GDAL operations run on a worker thread which blocks while the main thread
+ * executes the callbacks - thus these files can be accessed only by the asynchronous
+ * methods, a synchronous operation on a /vsinode/ file will throw.
+ *
+ * The callbacks must not call synchronous methods on a Dataset used by a running
+ * asynchronous operation: the operation holds the Dataset while it waits for the callbacks
+ * and the synchronous call would never return. Such a call throws instead of blocking
+ * for as long as an asynchronous operation is waiting for a callback.
+ *
+ * When the callbacks themselves use the libuv threadpool (for example `fs.promises`),
+ * `UV_THREADPOOL_SIZE` must be greater than the number of concurrent asynchronous GDAL operations
+ * on /vsinode/ files, otherwise all the threads can end up waiting on each other.
+ *
+ * @class vsinode
+ */
+
+std::map<std::string, VSINodeBackend *> VSINode::backends;
+std::thread::id VSINode::main_thread;
+uv_async_t *VSINode::async = nullptr;
+std::mutex VSINode::queue_lock;
+std::vector<VSINodeRequest *> VSINode::queue;
+std::atomic<int> VSINode::waiting(0);
+
+// Size of the read-ahead buffer for small reads
+static const size_t VSINODE_BLOCK_SIZE = 65536;
+
+VSINodeRequest::VSINodeRequest(Type type, const std::string &backend, const std::string &path)
+  : type(type),
+    backend(backend),
+    path(path),
+    offsets(),
+    sizes(),
+    buffers(),
+    bytes(),
+    exists(false),
+    size(0),
+    error(),
+    pending(0),
+    done(false),
+    lock(),
+    cv() {
+}
+
+VSINodeBackend::VSINodeBackend(Local<Function> stat, Local<Function> read)
+  : stat(stat), read(read), context(), resource("gdal:vsinode") {
+  context.Reset(Nan::GetCurrentContext());
+}
+
+VSINodeBackend::~VSINodeBackend() {
+  context.Reset();
+}
+
+// The state of a pending Promise
+struct VSINodeSettle {
+  VSINodeRequest *req;
+  size_t idx;
+};
+
+void VSINode::Initialize(Local<Object> target) {
+  Local<Object> vsinode = Nan::New<Object>();
+  Nan::Set(target, Nan::New("vsinode").ToLocalChecked(), vsinode);
+  Nan::SetMethod(vsinode, "register", registerBackend);
+  Nan::SetMethod(vsinode, "unregister", unregisterBackend);
+
+  main_thread = std::this_thread::get_id();
+  async = new uv_async_t;
+  uv_async_init(Nan::GetCurrentEventLoop(), async, processQueue);
+  // Pending requests always come from an async operation which keeps the loop alive
+  uv_unref(reinterpret_cast<uv_handle_t *>(async));
+
+  VSIFileManager::InstallHandler("/vsinode/", new VSINodeFilesystemHandler);
+}
+
+/**
+ * @typedef VSINodeStat { size: number }
+ */
+
+/**
+ * @typedef VSINodeBackend { stat: (path: string) => Promise<VSINodeStat|null>, read: (path: string, offset: number, length: number) => Promise<Buffer> }
+ */
+
+/**
+ * Register a backend serving the files under `/vsinode/<name>/`
+ *
+ * `stat(path)` must resolve with an object with a `size` property or with `null` if the file does not exist.
+ *
+ * `read(path, offset, length)` must resolve with a `Buffer` containing at most `length` bytes,
+ * a shorter `Buffer` signals the end of the file.
+ *
+ * @example
+ * ```
+ * gdal.vsinode.register('data', {
+ *   stat: (path) => fs.promises.stat(path).then((s) => ({size: s.size}), () => null),
+ *   read: async (path, offset, length) => {
+ *     const fd = await fs.promises.open(path);
+ *     const r = await fd.read(Buffer.alloc(length), 0, length, offset);
+ *     await fd.close();
+ *     return r.buffer.subarray(0, r.bytesRead);
+ *   }
+ * });
+ * const ds = await gdal.openAsync('/vsinode/data/test/data/sample.tif');
+ * ```
+ *
+ * @static
+ * @method register
+ * @param {string} name
+ * @param {VSINodeBackend} backend
+ * @return {void}
+ */
+NAN_METHOD(VSINode::registerBackend) {
+  std::string name;
+  Local<Object> backend;
+  Local<Function> stat, read;
+
+  NODE_ARG_STR(0, "name", name);
+  NODE_ARG_OBJECT(1, "backend", backend);
+  Local<Value> val = Nan::Get(backend, Nan::New("stat").ToLocalChecked()).ToLocalChecked();
+  if (!val->IsFunction()) {
+    Nan::ThrowTypeError("Property \"stat\" must be a function");
+    return;
+  }
+  stat = val.As<Function>();
+  val = Nan::Get(backend, Nan::New("read").ToLocalChecked()).ToLocalChecked();
+  if (!val->IsFunction()) {
+    Nan::ThrowTypeError("Property \"read\" must be a function");
+    return;
+  }
+  read = val.As<Function>();
+
+  if (name.empty() || name.find('/') != std::string::npos) {
+    Nan::ThrowError("name must be a non-empty string without a '/'");
+    return;
+  }
+  if (backends.count(name)) {
+    Nan::ThrowError("A /vsinode/ backend with this name is already registered");
+    return;
+  }
+
+  backends[name] = new VSINodeBackend(stat, read);
+}
+
+/**
+ * Unregister a backend, files that are still open will fail on their next access
+ *
+ * @static
+ * @method unregister
+ * @param {string} name
+ * @return {void}
+ */
+NAN_METHOD(VSINode::unregisterBackend) {
+  std::string name;
+  NODE_ARG_STR(0, "name", name);
+
+  auto it = backends.find(name);
+  if (it == backends.end()) {
+    Nan::ThrowError("No /vsinode/ backend with this name is registered");
+    return;
+  }
+  delete it->second;
+  backends.erase(it);
+}
+
+bool VSINode::parse(const char *filename, std::string &backend, std::string &path) {
+  static const char prefix[] = "/vsinode/";
+  if (strncmp(filename, prefix, sizeof(prefix) - 1)) return false;
+  const char *name = filename + sizeof(prefix) - 1;
+  const char *slash = strchr(name, '/');
+  if (slash == nullptr || slash == name) return false;
+  backend = std::string(name, slash - name);
+  path = std::string(slash + 1);
+  return true;
+}
+
+bool VSINode::execute(VSINodeRequest *req) {
+  if (std::this_thread::get_id() == main_thread) {
+    CPLError(CE_Failure, CPLE_AppDefined, "/vsinode/ files can be accessed only by asynchronous methods");
+    return false;
+  }
+
+  waiting++;
+  {
+    std::lock_guard<std::mutex> guard(queue_lock);
+    queue.push_back(req);
+  }
+  uv_async_send(async);
+  // A synchronous call already waiting on the main thread for a Dataset held by this thread must fail
+  object_store.wakeUp();
+
+  {
+    std::unique_lock<std::mutex> guard(req->lock);
+    req->cv.wait(guard, [req] { return req->done; });
+  }
+  waiting--;
+
+  if (!req->error.empty()) {
+    CPLError(CE_Failure, CPLE_AppDefined, "%s", req->error.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool VSINode::mustNotBlock() {
+  return waiting > 0 && std::this_thread::get_id() == main_thread;
+}
+
+// uv_async_send() coalesces the calls, so every run processes all queued requests
+void VSINode::processQueue(uv_async_t *) {
+  std::vector<VSINodeRequest *> requests;
+  {
+    std::lock_guard<std::mutex> guard(queue_lock);
+    requests.swap(queue);
+  }
+  for (VSINodeRequest *req : requests) dispatch(req);
+}
+
+void VSINode::dispatch(VSINodeRequest *req) {
+  Nan::HandleScope scope;
+
+  auto it = backends.find(req->backend);
+  if (it == backends.end()) {
+    req->error = "No /vsinode/ backend named " + req->backend;
+    req->pending = 1;
+    settle(req, 0, Local<Value>(), true);
+    return;
+  }
+  VSINodeBackend *backend = it->second;
+  Local<Context> context = Nan::New(backend->context);
+  Context::Scope context_scope(context);
+
+  // The callbacks are invoked and their Promises are chained from inside a JS callback scope,
+  // so that the microtasks queued in the process are drained when it returns
+  Local<Function> trampoline = Nan::New<Function>(issue, Nan::New<External>(req));
+  backend->resource.runInAsyncScope(context->Global(), trampoline, 0, nullptr);
+}
+
+NAN_METHOD(VSINode::issue) {
+  VSINodeRequest *req = reinterpret_cast<VSINodeRequest *>(info.Data().As<External>()->Value());
+  VSINodeBackend *backend = backends[req->backend];
+
+  Local<Value> path = SafeString::New(req->path.c_str());
+  if (req->type == VSINodeRequest::Stat) {
+    req->pending = 1;
+    Local<Value> argv[] = {path};
+    call(req, backend->stat, 1, argv, 0);
+    return;
+  }
+
+  // All the ranges are requested at once, the JS side is free to serve them in parallel
+  req->pending = req->offsets.size();
+  req->bytes.assign(req->offsets.size(), 0);
+  for (size_t i = 0; i < req->offsets.size(); i++) {
+    Local<Value> argv[] = {
+      path,
+      Nan::New<Number>(static_cast<double>(req->offsets[i])),
+      Nan::New<Number>(static_cast<double>(req->sizes[i]))};
+    call(req, backend->read, 3, argv, i);
+  }
+}
+
+void VSINode::call(VSINodeRequest *req, Nan::Callback &cb, int argc, Local<Value> argv[], size_t idx) {
+  Nan::TryCatch try_catch;
+  Nan::MaybeLocal<Value> maybe = Nan::Call(cb.GetFunction(), Nan::GetCurrentContext()->Global(), argc, argv);
+  if (try_catch.HasCaught()) {
+    settle(req, idx, try_catch.Exception(), true);
+    return;
+  }
+  Local<Value> result;
+  if (!maybe.ToLocal(&result)) {
+    settle(req, idx, Local<Value>(), true);
+    return;
+  }
+  if (!result->IsPromise()) {
+    settle(req, idx, result, false);
+    return;
+  }
+
+  // Exactly one of the two handlers will be called and it will free the state
+  VSINodeSettle *state = new VSINodeSettle{req, idx};
+  Local<Value> data = Nan::New<External>(state);
+  Local<Function> fulfilled = Nan::New<Function>(onFulfilled, data);
+  Local<Function> rejected = Nan::New<Function>(onRejected, data);
+  if (result.As<Promise>()->Then(Nan::GetCurrentContext(), fulfilled, rejected).IsEmpty()) {
+    delete state;
+    settle(req, idx, Local<Value>(), true);
+  }
+}
+
+NAN_METHOD(VSINode::onFulfilled) {
+  VSINodeSettle *state = reinterpret_cast<VSINodeSettle *>(info.Data().As<External>()->Value());
+  settle(state->req, state->idx, info[0], false);
+  delete state;
+}
+
+NAN_METHOD(VSINode::onRejected) {
+  VSINodeSettle *state = reinterpret_cast<VSINodeSettle *>(info.Data().As<External>()->Value());
+  settle(state->req, state->idx, info[0], true);
+  delete state;
+}
+
+// Runs on the main thread, once the last pending callback has settled,
+// the request belongs again to the waiting thread and must not be touched
+void VSINode::settle(VSINodeRequest *req, size_t idx, Local<Value> value, bool rejected) {
+  if (rejected) {
+    if (req->error.empty()) {
+      if (!value.IsEmpty() && value->IsObject()) {
+        Local<Value> msg = Nan::Get(value.As<Object>(), Nan::New("message").ToLocalChecked()).ToLocalChecked();
+        req->error = *Nan::Utf8String(msg);
+      } else if (!value.IsEmpty() && !value->IsUndefined()) {
+        req->error = *Nan::Utf8String(value);
+      } else {
+        req->error = "/vsinode/ callback failed";
+      }
+    }
+  } else if (req->type == VSINodeRequest::Stat) {
+    if (value->IsObject()) {
+      Local<Value> size = Nan::Get(value.As<Object>(), Nan::New("size").ToLocalChecked()).ToLocalChecked();
+      if (size->IsNumber() && Nan::To<double>(size).FromJust() >= 0) {
+        req->exists = true;
+        req->size = static_cast<vsi_l_offset>(Nan::To<double>(size).FromJust());
+      } else if (req->error.empty()) {
+        req->error = "stat must return an object with a numeric size property";
+      }
+    } else if (!value->IsNull() && !value->IsUndefined() && req->error.empty()) {
+      req->error = "stat must return an object or null";
+    }
+  } else {
+    if (Buffer::HasInstance(value)) {
+      size_t len = Buffer::Length(value);
+      if (len > req->sizes[idx]) len = req->sizes[idx];
+      memcpy(req->buffers[idx], Buffer::Data(value), len);
+      req->bytes[idx] = len;
+    } else if (req->error.empty()) {
+      req->error = "read must return a Buffer";
+    }
+  }
+
+  if (--req->pending > 0) return;
+  std::lock_guard<std::mutex> guard(req->lock);
+  req->done = true;
+  req->cv.notify_all();
+}
+
+VSINodeHandle::VSINodeHandle(const std::string &backend, const std::string &path, vsi_l_offset size)
+  : backend(backend), path(path), size(size), pos(0), eof(false), block(), block_offset(0) {
+}
+
+bool VSINodeHandle::fetch(vsi_l_offset offset, size_t len, void *dst, size_t &got) {
+  VSINodeRequest req(VSINodeRequest::Read, backend, path);
+  req.offsets.push_back(offset);
+  req.sizes.push_back(len);
+  req.buffers.push_back(dst);
+  if (!VSINode::execute(&req)) return false;
+  got = req.bytes[0];
+  return true;
+}
+
+int VSINodeHandle::Seek(vsi_l_offset nOffset, int nWhence) {
+  switch (nWhence) {
+    case SEEK_SET: pos = nOffset; break;
+    case SEEK_CUR: pos += nOffset; break;
+    case SEEK_END: pos = size + nOffset; break;
+    default: return -1;
+  }
+  eof = false;
+  return 0;
+}
+
+vsi_l_offset VSINodeHandle::Tell() {
+  return pos;
+}
+
+size_t VSINodeHandle::Read(void *pBuffer, size_t nSize, size_t nCount) {
+  size_t total = nSize * nCount;
+  if (total == 0) return 0;
+  if (pos >= size) {
+    eof = true;
+    return 0;
+  }
+  if (total > size - pos) total = static_cast<size_t>(size - pos);
+
+  size_t got = 0;
+  if (total <= VSINODE_BLOCK_SIZE) {
+    if (pos < block_offset || pos + total > block_offset + block.size()) {
+      size_t len = VSINODE_BLOCK_SIZE;
+      if (len > size - pos) len = static_cast<size_t>(size - pos);
+      block.resize(len);
+      size_t block_got = 0;
+      if (!fetch(pos, len, block.data(), block_got)) {
+        block.clear();
+        return 0;
+      }
+      block.resize(block_got);
+      block_offset = pos;
+    }
+    got = static_cast<size_t>(block_offset + block.size() - pos);
+    if (got > total) got = total;
+    memcpy(pBuffer, block.data() + (pos - block_offset), got);
+  } else {
+    if (!fetch(pos, total, pBuffer, got)) return 0;
+  }
+
+  pos += got;
+  if (got < nSize * nCount) eof = true;
+  return got / nSize;
+}
+
+int VSINodeHandle::ReadMultiRange(
+  int nRanges, void **ppData, const vsi_l_offset *panOffsets, const size_t *panSizes) {
+  if (nRanges == 0) return 0;
+  VSINodeRequest req(VSINodeRequest::Read, backend, path);
+  for (int i = 0; i < nRanges; i++) {
+    req.offsets.push_back(panOffsets[i]);
+    req.sizes.push_back(panSizes[i]);
+    req.buffers.push_back(ppData[i]);
+  }
+  if (!VSINode::execute(&req)) return -1;
+  for (int i = 0; i < nRanges; i++)
+    if (req.bytes[i] != panSizes[i]) return -1;
+  return 0;
+}
+
+size_t VSINodeHandle::Write(const void *, size_t, size_t) {
+  return 0;
+}
+
+int VSINodeHandle::Eof() {
+  return eof ? 1 : 0;
+}
+
+int VSINodeHandle::Close() {
+  return 0;
+}
+
+VSIVirtualHandle *
+VSINodeFilesystemHandler::Open(const char *pszFilename, const char *pszAccess, bool bSetError, CSLConstList) {
+  std::string backend, path;
+  if (!VSINode::parse(pszFilename, backend, path)) {
+    if (bSetError) VSIError(VSIE_FileError, "Invalid /vsinode/ filename %s", pszFilename);
+    errno = ENOENT;
+    return nullptr;
+  }
+  if (strchr(pszAccess, 'w') || strchr(pszAccess, 'a') || strchr(pszAccess, '+')) {
+    if (bSetError) VSIError(VSIE_FileError, "/vsinode/ files are read-only");
+    errno = EACCES;
+    return nullptr;
+  }
+
+  VSINodeRequest req(VSINodeRequest::Stat, backend, path);
+  if (!VSINode::execute(&req)) return nullptr;
+  if (!req.exists) {
+    if (bSetError) VSIError(VSIE_FileError, "%s: No such file or directory", pszFilename);
+    errno = ENOENT;
+    return nullptr;
+  }
+
+  return new VSINodeHandle(backend, path, req.size);
+}
+
+int VSINodeFilesystemHandler::Stat(const char *pszFilename, VSIStatBufL *pStatBuf, int) {
+  memset(pStatBuf, 0, sizeof(VSIStatBufL));
+  std::string backend, path;
+  if (!VSINode::parse(pszFilename, backend, path)) return -1;
+
+  VSINodeRequest req(VSINodeRequest::Stat, backend, path);
+  if (!VSINode::execute(&req) || !req.exists) return -1;
+
+  pStatBuf->st_size = req.size;
+  pStatBuf->st_mode = S_IFREG;
+  return 0;
+}
+
+} // namespace node_gdal
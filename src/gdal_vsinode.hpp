@@ -0,0 +1,136 @@
+#ifndef __NODE_GDAL_VSINODE_H__
+#define __NODE_GDAL_VSINODE_H__
+
+// node
+#include <node.h>
+#include <node_buffer.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// gdal
+#include <cpl_vsi_virtual.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace v8;
+using namespace node;
+
+// A /vsinode/ file, a read-only virtual file backed by JS callbacks
+
+namespace node_gdal {
+
+// A request from a GDAL thread to the JS world
+struct VSINodeRequest {
+  enum Type { Stat, Read };
+  Type type;
+  std::string backend;
+  std::string path;
+
+  // Read
+  std::vector<vsi_l_offset> offsets;
+  std::vector<size_t> sizes;
+  std::vector<void *> buffers;
+  std::vector<size_t> bytes;
+
+  // Stat
+  bool exists;
+  vsi_l_offset size;
+
+  std::string error;
+  // Accessed only on the main thread
+  size_t pending;
+  bool done;
+  std::mutex lock;
+  std::condition_variable cv;
+
+  VSINodeRequest(Type type, const std::string &backend, const std::string &path);
+};
+
+// The JS callbacks of a /vsinode/<name>/ prefix
+struct VSINodeBackend {
+  Nan::Callback stat;
+  Nan::Callback read;
+  Nan::Persistent<Context> context;
+  Nan::AsyncResource resource;
+
+  VSINodeBackend(Local<Function> stat, Local<Function> read);
+  ~VSINodeBackend();
+};
+
+class VSINode {
+  // Only accessed on the main thread
+  static std::map<std::string, VSINodeBackend *> backends;
+
+  static std::thread::id main_thread;
+  static uv_async_t *async;
+  static std::mutex queue_lock;
+  static std::vector<VSINodeRequest *> queue;
+  // Number of GDAL threads blocked in execute()
+  static std::atomic<int> waiting;
+
+  static void processQueue(uv_async_t *);
+  static void dispatch(VSINodeRequest *req);
+  static NAN_METHOD(issue);
+  static void call(VSINodeRequest *req, Nan::Callback &cb, int argc, Local<Value> argv[], size_t idx);
+  static void settle(VSINodeRequest *req, size_t idx, Local<Value> value, bool rejected);
+  static NAN_METHOD(onFulfilled);
+  static NAN_METHOD(onRejected);
+
+    public:
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(registerBackend);
+  static NAN_METHOD(unregisterBackend);
+
+  // Called from the GDAL threads, blocks until the JS world has answered
+  // Returns false and sets the CPL error on failure
+  static bool execute(VSINodeRequest *req);
+  // True on the main thread while a GDAL thread is waiting for the callbacks,
+  // this thread can hold any Dataset lock and the main thread must not wait for one
+  static bool mustNotBlock();
+  // Splits /vsinode/<name>/<path>
+  static bool parse(const char *filename, std::string &backend, std::string &path);
+};
+
+class VSINodeHandle : public VSIVirtualHandle {
+  std::string backend;
+  std::string path;
+  vsi_l_offset size;
+  vsi_l_offset pos;
+  bool eof;
+  // Small reads go through a one block read-ahead buffer
+  std::vector<GByte> block;
+  vsi_l_offset block_offset;
+
+  bool fetch(vsi_l_offset offset, size_t len, void *dst, size_t &got);
+
+    public:
+  VSINodeHandle(const std::string &backend, const std::string &path, vsi_l_offset size);
+  virtual int Seek(vsi_l_offset nOffset, int nWhence) override;
+  virtual vsi_l_offset Tell() override;
+  virtual size_t Read(void *pBuffer, size_t nSize, size_t nCount) override;
+  virtual int
+  ReadMultiRange(int nRanges, void **ppData, const vsi_l_offset *panOffsets, const size_t *panSizes) override;
+  virtual size_t Write(const void *pBuffer, size_t nSize, size_t nCount) override;
+  virtual int Eof() override;
+  virtual int Close() override;
+};
+
+class VSINodeFilesystemHandler : public VSIFilesystemHandler {
+    public:
+  virtual VSIVirtualHandle *
+  Open(const char *pszFilename, const char *pszAccess, bool bSetError, CSLConstList papszOptions) override;
+  virtual int Stat(const char *pszFilename, VSIStatBufL *pStatBuf, int nFlags) override;
+  virtual int HasOptimizedReadMultiRange(const char *) override {
+    return TRUE;
+  }
+};
+
+} // namespace node_gdal
+#endif
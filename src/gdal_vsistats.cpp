@@ -0,0 +1,323 @@
+#include "gdal_vsistats.hpp"
+#include "gdal_common.hpp"
+
+#include <string.h>
+
+namespace node_gdal {
+
+/**
+ * @for gdal
+ * @property vsistats
+ * @type {vsistats}
+ */
+
+/**
+ * I/O statistics of the /vsistats/ files
+ *
+ * `/vsistats/` is a chaining file system: opening `/vsistats/<path>` opens `<path>`
+ * through any other GDAL file system while counting the operations on it.
+ * The counters are kept per underlying file name and are cheap enough to be sampled on
+ * every request.
+ *
+ * `ranges` is the number of reads that do not continue the previous one, on a network
+ * file system without a cache each one of them is a separate range request.
+ *
+ * @example
+ * ```
+ * const ds = gdal.open('/vsistats//vsicurl/https://example.com/cog.tif');
+ * ds.bands.get(1).pixels.read(0, 0, 256, 256);
+ * console.log(ds.ioStats(), gdal.vsistats.get('/vsicurl/https://example.com/'));
+ * ```
+ *
+ * @class vsistats
+ */
+
+/**
+ * @typedef VSIStats { opens: number, reads: number, bytesRead: number, writes: number, bytesWritten: number, seeks: number, ranges: number }
+ */
+
+std::mutex VSIStats::lock;
+std::map<std::string, std::shared_ptr<VSIStatsCounters>> VSIStats::files;
+
+VSIStatsCounters::VSIStatsCounters()
+  : opens(0), reads(0), bytes_read(0), writes(0), bytes_written(0), seeks(0), ranges(0) {
+}
+
+void VSIStatsCounters::reset() {
+  for (auto *counter : {&opens, &reads, &bytes_read, &writes, &bytes_written, &seeks, &ranges})
+    counter->store(0, std::memory_order_relaxed);
+}
+
+VSIStatsTotals::VSIStatsTotals()
+  : opens(0), reads(0), bytes_read(0), writes(0), bytes_written(0), seeks(0), ranges(0) {
+}
+
+void VSIStatsTotals::add(const VSIStatsCounters &counters) {
+  opens += counters.opens.load(std::memory_order_relaxed);
+  reads += counters.reads.load(std::memory_order_relaxed);
+  bytes_read += counters.bytes_read.load(std::memory_order_relaxed);
+  writes += counters.writes.load(std::memory_order_relaxed);
+  bytes_written += counters.bytes_written.load(std::memory_order_relaxed);
+  seeks += counters.seeks.load(std::memory_order_relaxed);
+  ranges += counters.ranges.load(std::memory_order_relaxed);
+}
+
+Local<Object> VSIStatsTotals::toObject() const {
+  Nan::EscapableHandleScope scope;
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("opens").ToLocalChecked(), Nan::New<Number>(static_cast<double>(opens)));
+  Nan::Set(result, Nan::New("reads").ToLocalChecked(), Nan::New<Number>(static_cast<double>(reads)));
+  Nan::Set(result, Nan::New("bytesRead").ToLocalChecked(), Nan::New<Number>(static_cast<double>(bytes_read)));
+  Nan::Set(result, Nan::New("writes").ToLocalChecked(), Nan::New<Number>(static_cast<double>(writes)));
+  Nan::Set(
+    result, Nan::New("bytesWritten").ToLocalChecked(), Nan::New<Number>(static_cast<double>(bytes_written)));
+  Nan::Set(result, Nan::New("seeks").ToLocalChecked(), Nan::New<Number>(static_cast<double>(seeks)));
+  Nan::Set(result, Nan::New("ranges").ToLocalChecked(), Nan::New<Number>(static_cast<double>(ranges)));
+  return scope.Escape(result);
+}
+
+void VSIStats::Initialize(Local<Object> target) {
+  Local<Object> vsistats = Nan::New<Object>();
+  Nan::Set(target, Nan::New("vsistats").ToLocalChecked(), vsistats);
+  Nan::SetMethod(vsistats, "get", get);
+  Nan::SetMethod(vsistats, "reset", reset);
+
+  VSIFileManager::InstallHandler(VSISTATS_PREFIX, new VSIStatsFilesystemHandler);
+}
+
+const char *VSIStats::underlying(const char *filename) {
+  if (strncmp(filename, VSISTATS_PREFIX, sizeof(VSISTATS_PREFIX) - 1)) return nullptr;
+  return filename + sizeof(VSISTATS_PREFIX) - 1;
+}
+
+std::shared_ptr<VSIStatsCounters> VSIStats::counters(const std::string &filename) {
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = files.find(filename);
+  if (it != files.end()) return it->second;
+  std::shared_ptr<VSIStatsCounters> r(new VSIStatsCounters);
+  files[filename] = r;
+  return r;
+}
+
+VSIStatsTotals VSIStats::sum(const std::string &prefix) {
+  VSIStatsTotals r;
+  std::lock_guard<std::mutex> guard(lock);
+  for (auto it = files.lower_bound(prefix); it != files.end() && !it->first.compare(0, prefix.size(), prefix); it++)
+    r.add(*it->second);
+  return r;
+}
+
+// The side-car files share the stem of the main file (file.shp, file.dbf, file.tif.ovr, file.aux.xml),
+// a dataset without an extension can be a directory
+VSIStatsTotals VSIStats::dataset(const char *description) {
+  const char *underlying_name = underlying(description);
+  if (underlying_name == nullptr) return VSIStatsTotals();
+  std::string name = underlying_name;
+
+  size_t dot = name.find_last_of('.');
+  size_t slash = name.find_last_of('/');
+  if (dot != std::string::npos && (slash == std::string::npos || dot > slash)) return sum(name.substr(0, dot + 1));
+
+  VSIStatsTotals r = sum(name + "/");
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = files.find(name);
+  if (it != files.end()) r.add(*it->second);
+  return r;
+}
+
+// Both the underlying and the /vsistats/ names are accepted
+static std::string prefixArg(const Nan::FunctionCallbackInfo<v8::Value> &info) {
+  std::string prefix;
+  if (info.Length() > 0 && info[0]->IsString()) prefix = *Nan::Utf8String(info[0]);
+  const char *name = VSIStats::underlying(prefix.c_str());
+  if (name != nullptr) prefix = name;
+  return prefix;
+}
+
+/**
+ * Get the I/O statistics of all the /vsistats/ files whose name begins with `prefix`.
+ *
+ * The prefix is matched against the underlying file name, with or without
+ * the `/vsistats/` prefix, all files are included if it is not given.
+ *
+ * @static
+ * @method get
+ * @param {string} [prefix]
+ * @return {VSIStats}
+ */
+NAN_METHOD(VSIStats::get) {
+  if (info.Length() > 0 && !info[0]->IsUndefined() && !info[0]->IsString()) {
+    Nan::ThrowTypeError("prefix must be a string");
+    return;
+  }
+  info.GetReturnValue().Set(sum(prefixArg(info)).toObject());
+}
+
+/**
+ * Reset the I/O statistics of all the /vsistats/ files whose name begins with `prefix`.
+ *
+ * All files are reset if it is not given.
+ *
+ * @static
+ * @method reset
+ * @param {string} [prefix]
+ * @return {void}
+ */
+NAN_METHOD(VSIStats::reset) {
+  if (info.Length() > 0 && !info[0]->IsUndefined() && !info[0]->IsString()) {
+    Nan::ThrowTypeError("prefix must be a string");
+    return;
+  }
+  std::string prefix = prefixArg(info);
+
+  // The counters of the files that are still open stay in the map as their handles keep updating them,
+  // the others are dropped - counters() is the only place where new references are created
+  std::lock_guard<std::mutex> guard(lock);
+  for (auto it = files.lower_bound(prefix); it != files.end() && !it->first.compare(0, prefix.size(), prefix);) {
+    if (it->second.use_count() == 1) {
+      it = files.erase(it);
+    } else {
+      it->second->reset();
+      it++;
+    }
+  }
+}
+
+VSIStatsHandle::VSIStatsHandle(VSIVirtualHandle *handle, std::shared_ptr<VSIStatsCounters> counters)
+  : handle(handle), counters(counters), next(static_cast<vsi_l_offset>(-1)) {
+}
+
+VSIStatsHandle::~VSIStatsHandle() {
+  delete handle;
+}
+
+int VSIStatsHandle::Seek(vsi_l_offset nOffset, int nWhence) {
+  vsi_l_offset pos = handle->Tell();
+  int r = handle->Seek(nOffset, nWhence);
+  if (handle->Tell() != pos) counters->seeks.fetch_add(1, std::memory_order_relaxed);
+  return r;
+}
+
+vsi_l_offset VSIStatsHandle::Tell() {
+  return handle->Tell();
+}
+
+size_t VSIStatsHandle::Read(void *pBuffer, size_t nSize, size_t nCount) {
+  vsi_l_offset pos = handle->Tell();
+  size_t r = handle->Read(pBuffer, nSize, nCount);
+  counters->reads.fetch_add(1, std::memory_order_relaxed);
+  if (pos != next) counters->ranges.fetch_add(1, std::memory_order_relaxed);
+  counters->bytes_read.fetch_add(r * nSize, std::memory_order_relaxed);
+  next = handle->Tell();
+  return r;
+}
+
+int VSIStatsHandle::ReadMultiRange(
+  int nRanges, void **ppData, const vsi_l_offset *panOffsets, const size_t *panSizes) {
+  int r = handle->ReadMultiRange(nRanges, ppData, panOffsets, panSizes);
+  counters->reads.fetch_add(1, std::memory_order_relaxed);
+  counters->ranges.fetch_add(nRanges, std::memory_order_relaxed);
+  if (r == 0)
+    for (int i = 0; i < nRanges; i++) counters->bytes_read.fetch_add(panSizes[i], std::memory_order_relaxed);
+  return r;
+}
+
+size_t VSIStatsHandle::Write(const void *pBuffer, size_t nSize, size_t nCount) {
+  size_t r = handle->Write(pBuffer, nSize, nCount);
+  counters->writes.fetch_add(1, std::memory_order_relaxed);
+  counters->bytes_written.fetch_add(r * nSize, std::memory_order_relaxed);
+  return r;
+}
+
+int VSIStatsHandle::Eof() {
+  return handle->Eof();
+}
+
+int VSIStatsHandle::Flush() {
+  return handle->Flush();
+}
+
+int VSIStatsHandle::Close() {
+  return handle->Close();
+}
+
+int VSIStatsHandle::Truncate(vsi_l_offset nNewSize) {
+  return handle->Truncate(nNewSize);
+}
+
+VSIVirtualHandle *VSIStatsFilesystemHandler::Open(
+  const char *pszFilename, const char *pszAccess, bool bSetError, CSLConstList papszOptions) {
+  const char *name = VSIStats::underlying(pszFilename);
+  if (name == nullptr) return nullptr;
+
+  VSIVirtualHandle *handle =
+    VSIFileManager::GetHandler(name)->Open(name, pszAccess, bSetError, papszOptions);
+  if (handle == nullptr) return nullptr;
+
+  std::shared_ptr<VSIStatsCounters> counters = VSIStats::counters(name);
+  counters->opens.fetch_add(1, std::memory_order_relaxed);
+  return new VSIStatsHandle(handle, counters);
+}
+
+int VSIStatsFilesystemHandler::Stat(const char *pszFilename, VSIStatBufL *pStatBuf, int nFlags) {
+  const char *name = VSIStats::underlying(pszFilename);
+  if (name == nullptr) return -1;
+  return VSIFileManager::GetHandler(name)->Stat(name, pStatBuf, nFlags);
+}
+
+int VSIStatsFilesystemHandler::Unlink(const char *pszFilename) {
+  const char *name = VSIStats::underlying(pszFilename);
+  if (name == nullptr) return -1;
+  return VSIFileManager::GetHandler(name)->Unlink(name);
+}
+
+int VSIStatsFilesystemHandler::Rename(const char *oldpath, const char *newpath) {
+  const char *oldname = VSIStats::underlying(oldpath);
+  const char *newname = VSIStats::underlying(newpath);
+  if (oldname == nullptr || newname == nullptr) return -1;
+  return VSIFileManager::GetHandler(oldname)->Rename(oldname, newname);
+}
+
+int VSIStatsFilesystemHandler::Mkdir(const char *pszDirname, long nMode) {
+  const char *name = VSIStats::underlying(pszDirname);
+  if (name == nullptr) return -1;
+  return VSIFileManager::GetHandler(name)->Mkdir(name, nMode);
+}
+
+int VSIStatsFilesystemHandler::Rmdir(const char *pszDirname) {
+  const char *name = VSIStats::underlying(pszDirname);
+  if (name == nullptr) return -1;
+  return VSIFileManager::GetHandler(name)->Rmdir(name);
+}
+
+char **VSIStatsFilesystemHandler::ReadDirEx(const char *pszDirname, int nMaxFiles) {
+  const char *name = VSIStats::underlying(pszDirname);
+  if (name == nullptr) return nullptr;
+  return VSIFileManager::GetHandler(name)->ReadDirEx(name, nMaxFiles);
+}
+
+char **VSIStatsFilesystemHandler::SiblingFiles(const char *pszFilename) {
+  const char *name = VSIStats::underlying(pszFilename);
+  if (name == nullptr) return nullptr;
+  return VSIFileManager::GetHandler(name)->SiblingFiles(name);
+}
+
+int VSIStatsFilesystemHandler::IsCaseSensitive(const char *pszFilename) {
+  const char *name = VSIStats::underlying(pszFilename);
+  if (name == nullptr) return TRUE;
+  return VSIFileManager::GetHandler(name)->IsCaseSensitive(name);
+}
+
+int VSIStatsFilesystemHandler::HasOptimizedReadMultiRange(const char *pszPath) {
+  const char *name = VSIStats::underlying(pszPath);
+  if (name == nullptr) return FALSE;
+  return VSIFileManager::GetHandler(name)->HasOptimizedReadMultiRange(name);
+}
+
+const char *VSIStatsFilesystemHandler::GetActualURL(const char *pszFilename) {
+  const char *name = VSIStats::underlying(pszFilename);
+  if (name == nullptr) return nullptr;
+  return VSIFileManager::GetHandler(name)->GetActualURL(name);
+}
+
+} // namespace node_gdal
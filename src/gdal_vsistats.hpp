@@ -0,0 +1,111 @@
+#ifndef __NODE_GDAL_VSISTATS_H__
+#define __NODE_GDAL_VSISTATS_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// gdal
+#include <cpl_vsi_virtual.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace v8;
+using namespace node;
+
+// /vsistats/ is a chaining file system counting the I/O operations on the underlying file
+
+namespace node_gdal {
+
+#define VSISTATS_PREFIX "/vsistats/"
+
+struct VSIStatsCounters {
+  std::atomic<uint64_t> opens;
+  std::atomic<uint64_t> reads;
+  std::atomic<uint64_t> bytes_read;
+  std::atomic<uint64_t> writes;
+  std::atomic<uint64_t> bytes_written;
+  std::atomic<uint64_t> seeks;
+  // Reads that do not continue the previous one, each one is a request on a network file system
+  std::atomic<uint64_t> ranges;
+
+  VSIStatsCounters();
+  void reset();
+};
+
+// A plain copy of the counters
+struct VSIStatsTotals {
+  uint64_t opens, reads, bytes_read, writes, bytes_written, seeks, ranges;
+
+  VSIStatsTotals();
+  void add(const VSIStatsCounters &counters);
+  Local<Object> toObject() const;
+};
+
+class VSIStats {
+  static std::mutex lock;
+  // The counters are never freed while there are open handles referencing them,
+  // the others are dropped by reset()
+  static std::map<std::string, std::shared_ptr<VSIStatsCounters>> files;
+
+    public:
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(get);
+  static NAN_METHOD(reset);
+
+  // Returns the counters of an underlying file, creating them if needed
+  static std::shared_ptr<VSIStatsCounters> counters(const std::string &filename);
+  // Sums the counters of the underlying files whose name begins with prefix
+  static VSIStatsTotals sum(const std::string &prefix);
+  // Sums the counters of the files of a dataset, matched by the name of its main /vsistats/ file
+  static VSIStatsTotals dataset(const char *description);
+  // Returns the underlying file name of a /vsistats/ file
+  static const char *underlying(const char *filename);
+};
+
+class VSIStatsHandle : public VSIVirtualHandle {
+  VSIVirtualHandle *handle;
+  std::shared_ptr<VSIStatsCounters> counters;
+  // End of the last read, -1 before the first one
+  vsi_l_offset next;
+
+    public:
+  VSIStatsHandle(VSIVirtualHandle *handle, std::shared_ptr<VSIStatsCounters> counters);
+  virtual ~VSIStatsHandle();
+  virtual int Seek(vsi_l_offset nOffset, int nWhence) override;
+  virtual vsi_l_offset Tell() override;
+  virtual size_t Read(void *pBuffer, size_t nSize, size_t nCount) override;
+  virtual int
+  ReadMultiRange(int nRanges, void **ppData, const vsi_l_offset *panOffsets, const size_t *panSizes) override;
+  virtual size_t Write(const void *pBuffer, size_t nSize, size_t nCount) override;
+  virtual int Eof() override;
+  virtual int Flush() override;
+  virtual int Close() override;
+  virtual int Truncate(vsi_l_offset nNewSize) override;
+};
+
+class VSIStatsFilesystemHandler : public VSIFilesystemHandler {
+    public:
+  virtual VSIVirtualHandle *
+  Open(const char *pszFilename, const char *pszAccess, bool bSetError, CSLConstList papszOptions) override;
+  virtual int Stat(const char *pszFilename, VSIStatBufL *pStatBuf, int nFlags) override;
+  virtual int Unlink(const char *pszFilename) override;
+  virtual int Rename(const char *oldpath, const char *newpath) override;
+  virtual int Mkdir(const char *pszDirname, long nMode) override;
+  virtual int Rmdir(const char *pszDirname) override;
+  virtual char **ReadDirEx(const char *pszDirname, int nMaxFiles) override;
+  virtual char **SiblingFiles(const char *pszFilename) override;
+  virtual int IsCaseSensitive(const char *pszFilename) override;
+  virtual int HasOptimizedReadMultiRange(const char *pszPath) override;
+  virtual const char *GetActualURL(const char *pszFilename) override;
+};
+
+} // namespace node_gdal
+#endif
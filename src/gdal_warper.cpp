@@ -1,14 +1,24 @@
 #include "gdal_warper.hpp"
 #include "gdal_common.hpp"
 #include "gdal_dataset.hpp"
+#include "gdal_memfile.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "utils/string_list.hpp"
 #include "utils/warp_options.hpp"
 
+#include <gdal_utils.h>
+
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <thread>
+
 namespace node_gdal {
 
 void Warper::Initialize(Local<Object> target) {
   Nan__SetAsyncableMethod(target, "reprojectImage", reprojectImage);
   Nan__SetAsyncableMethod(target, "suggestedWarpOutput", suggestedWarpOutput);
+  Nan__SetAsyncableMethod(target, "renderTile", renderTile);
 }
 
 /**
@@ -475,4 +485,330 @@ GDAL_ASYNCABLE_DEFINE(Warper::suggestedWarpOutput) {
   job.run(info, async, 1);
 }
 
+// Half of the extent of the EPSG:3857 Web Mercator projection
+static const double WEB_MERCATOR_EXTENT = 20037508.342789244;
+
+struct TileScale {
+  double min, max;
+};
+
+struct RenderedTile {
+  void *data;
+  vsi_l_offset len;
+};
+
+// Numbers the temporary /vsimem/ files of the tiles
+static std::atomic<uint64_t> tile_counter(0);
+
+static char **argList(const std::vector<std::string> &args) {
+  char **list = nullptr;
+  for (const std::string &arg : args) list = CSLAddString(list, arg.c_str());
+  return list;
+}
+
+// gdalwarp uses its own names for the resampling algorithms
+static const char *warpResampling(const std::string &name) {
+  if (name == "NearestNeighbor" || name == "NearestNeighbour") return "near";
+  if (name == "Bilinear") return "bilinear";
+  if (name == "Cubic") return "cubic";
+  if (name == "CubicSpline") return "cubicspline";
+  if (name == "Lanczos") return "lanczos";
+  if (name == "Average") return "average";
+  if (name == "Mode") return "mode";
+  return nullptr;
+}
+
+static bool parseTileScale(Local<Value> val, TileScale &scale) {
+  if (!val->IsArray() || val.As<Array>()->Length() != 2) return false;
+  Local<Value> min = Nan::Get(val.As<Array>(), 0).ToLocalChecked();
+  Local<Value> max = Nan::Get(val.As<Array>(), 1).ToLocalChecked();
+  if (!min->IsNumber() || !max->IsNumber()) return false;
+  scale.min = Nan::To<double>(min).ToChecked();
+  scale.max = Nan::To<double>(max).ToChecked();
+  return true;
+}
+
+/**
+ * @typedef RenderTileOptions { z: number, x: number, y: number, tileSize?: number, bands?: number[], resampling?: string, format?: string, scale?: number[]|number[][], colorTable?: number[][], creationOptions?: string[]|object }
+ */
+
+/**
+ * Renders a `z/x/y` XYZ tile of the EPSG:3857 Web Mercator tiling scheme from a raster dataset
+ * and encodes it in a single operation.
+ *
+ * The source bands are selected, scaled to 8-bit, reprojected and resampled using the most
+ * appropriate overview level, then encoded in memory.
+ * The areas outside the dataset and the nodata pixels are transparent in the PNG and WebP tiles.
+ *
+ * @throws Error
+ * @method renderTile
+ * @static
+ * @for gdal
+ * @param {gdal.Dataset} dataset The source dataset, it must have a spatial reference and a geotransform
+ * @param {RenderTileOptions} options
+ * @param {number} options.z Zoom level
+ * @param {number} options.x Tile column
+ * @param {number} options.y Tile row, starting from the north
+ * @param {number} [options.tileSize=256] Width and height of the tile in pixels
+ * @param {number[]} [options.bands] Source bands, by default all the bands of a dataset with up to 4 bands, the first 3 otherwise
+ * @param {string} [options.resampling=NearestNeighbor] Resampling algorithm ({{#crossLink "Constants (GRA)"}}available options{{/crossLink}})
+ * @param {string} [options.format=png] Output format, `png`, `jpeg` or `webp`, `webp` requires GDAL to be built with libwebp
+ * @param {number[]|number[][]} [options.scale] `[min, max]` source range mapped to `[0, 255]`, for all bands or as an array with one range per band, non 8-bit data is clamped if it is not specified
+ * @param {number[][]} [options.colorTable] `[r, g, b, a?]` entries applied to the output when rendering a single band as a paletted image
+ * @param {string[]|object} [options.creationOptions] Driver-specific creation options such as `QUALITY`
+ * @return {Buffer} The encoded tile
+ */
+
+/**
+ * Renders a `z/x/y` XYZ tile of the EPSG:3857 Web Mercator tiling scheme from a raster dataset
+ * and encodes it in a single operation.
+ * {{{async}}}
+ *
+ * The source bands are selected, scaled to 8-bit, reprojected and resampled using the most
+ * appropriate overview level, then encoded in memory.
+ * The areas outside the dataset and the nodata pixels are transparent in the PNG and WebP tiles.
+ *
+ * @throws Error
+ * @method renderTileAsync
+ * @static
+ * @for gdal
+ * @param {gdal.Dataset} dataset The source dataset, it must have a spatial reference and a geotransform
+ * @param {RenderTileOptions} options
+ * @param {number} options.z Zoom level
+ * @param {number} options.x Tile column
+ * @param {number} options.y Tile row, starting from the north
+ * @param {number} [options.tileSize=256] Width and height of the tile in pixels
+ * @param {number[]} [options.bands] Source bands, by default all the bands of a dataset with up to 4 bands, the first 3 otherwise
+ * @param {string} [options.resampling=NearestNeighbor] Resampling algorithm ({{#crossLink "Constants (GRA)"}}available options{{/crossLink}})
+ * @param {string} [options.format=png] Output format, `png`, `jpeg` or `webp`, `webp` requires GDAL to be built with libwebp
+ * @param {number[]|number[][]} [options.scale] `[min, max]` source range mapped to `[0, 255]`, for all bands or as an array with one range per band, non 8-bit data is clamped if it is not specified
+ * @param {number[][]} [options.colorTable] `[r, g, b, a?]` entries applied to the output when rendering a single band as a paletted image
+ * @param {string[]|object} [options.creationOptions] Driver-specific creation options such as `QUALITY`
+ * @param {callback<Buffer>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Buffer>}
+ */
+GDAL_ASYNCABLE_DEFINE(Warper::renderTile) {
+  Nan::HandleScope scope;
+
+  Dataset *ds;
+  Local<Object> obj;
+  int z, x, y, tileSize = 256;
+  Local<Array> bands_arr, color_arr;
+  std::string resampling = "NearestNeighbor";
+  std::string format = "png";
+
+  NODE_ARG_WRAPPED(0, "dataset", Dataset, ds);
+  NODE_ARG_OBJECT(1, "options", obj);
+  NODE_INT_FROM_OBJ(obj, "z", z);
+  NODE_INT_FROM_OBJ(obj, "x", x);
+  NODE_INT_FROM_OBJ(obj, "y", y);
+  NODE_INT_FROM_OBJ_OPT(obj, "tileSize", tileSize);
+  NODE_ARRAY_FROM_OBJ_OPT(obj, "bands", bands_arr);
+  NODE_STR_FROM_OBJ_OPT(obj, "resampling", resampling);
+  NODE_STR_FROM_OBJ_OPT(obj, "format", format);
+  NODE_ARRAY_FROM_OBJ_OPT(obj, "colorTable", color_arr);
+
+  GDALDataset *raw = ds->get();
+  if (raw->GetRasterCount() == 0) {
+    Nan::ThrowError("Dataset does not have any raster bands");
+    return;
+  }
+  if (z < 0 || z > 30) {
+    Nan::ThrowRangeError("z must be between 0 and 30");
+    return;
+  }
+  if (x < 0 || y < 0 || x >= (1 << z) || y >= (1 << z)) {
+    Nan::ThrowRangeError("x and y must be between 0 and 2^z - 1");
+    return;
+  }
+  if (tileSize < 1 || tileSize > 4096) {
+    Nan::ThrowRangeError("tileSize must be between 1 and 4096");
+    return;
+  }
+
+  const char *alg = warpResampling(resampling);
+  if (alg == nullptr) {
+    Nan::ThrowError("Invalid resampling algorithm");
+    return;
+  }
+
+  std::string driver;
+  bool alpha = true;
+  if (format == "png") {
+    driver = "PNG";
+  } else if (format == "jpeg" || format == "jpg") {
+    driver = "JPEG";
+    alpha = false;
+  } else if (format == "webp") {
+    driver = "WEBP";
+  } else {
+    Nan::ThrowError("format must be one of png, jpeg or webp");
+    return;
+  }
+
+  std::vector<int> bands;
+  if (!bands_arr.IsEmpty()) {
+    for (unsigned i = 0; i < bands_arr->Length(); i++) {
+      Local<Value> val = Nan::Get(bands_arr, i).ToLocalChecked();
+      int band = val->IsNumber() ? Nan::To<int32_t>(val).ToChecked() : 0;
+      if (band < 1 || band > raw->GetRasterCount()) {
+        Nan::ThrowRangeError("bands must contain valid band numbers");
+        return;
+      }
+      bands.push_back(band);
+    }
+  } else {
+    int count = raw->GetRasterCount() <= 4 ? raw->GetRasterCount() : 3;
+    for (int i = 1; i <= count; i++) bands.push_back(i);
+  }
+  if (bands.empty() || bands.size() > 4) {
+    Nan::ThrowRangeError("A tile must have between 1 and 4 bands");
+    return;
+  }
+
+  std::vector<TileScale> scales;
+  Local<String> scale_sym = Nan::New("scale").ToLocalChecked();
+  if (Nan::HasOwnProperty(obj, scale_sym).FromMaybe(false)) {
+    Local<Value> val = Nan::Get(obj, scale_sym).ToLocalChecked();
+    TileScale scale;
+    if (parseTileScale(val, scale)) {
+      scales.assign(bands.size(), scale);
+    } else if (val->IsArray() && val.As<Array>()->Length() == bands.size()) {
+      for (unsigned i = 0; i < bands.size(); i++) {
+        if (!parseTileScale(Nan::Get(val.As<Array>(), i).ToLocalChecked(), scale)) {
+          Nan::ThrowTypeError("scale must be a [min, max] array or an array of [min, max] arrays, one per band");
+          return;
+        }
+        scales.push_back(scale);
+      }
+    } else if (!val->IsUndefined() && !val->IsNull()) {
+      Nan::ThrowTypeError("scale must be a [min, max] array or an array of [min, max] arrays, one per band");
+      return;
+    }
+  }
+
+  std::vector<GDALColorEntry> colors;
+  if (!color_arr.IsEmpty()) {
+    if (bands.size() != 1) {
+      Nan::ThrowError("colorTable can be applied only to a single band");
+      return;
+    }
+    for (unsigned i = 0; i < color_arr->Length(); i++) {
+      Local<Value> val = Nan::Get(color_arr, i).ToLocalChecked();
+      if (!val->IsArray() || val.As<Array>()->Length() < 3) {
+        Nan::ThrowTypeError("colorTable must contain [r, g, b, a?] arrays");
+        return;
+      }
+      short c[4] = {0, 0, 0, 255};
+      for (unsigned j = 0; j < 4 && j < val.As<Array>()->Length(); j++)
+        c[j] = static_cast<short>(Nan::To<int32_t>(Nan::Get(val.As<Array>(), j).ToLocalChecked()).FromMaybe(0));
+      colors.push_back({c[0], c[1], c[2], c[3]});
+    }
+    // The transparency comes from the color table
+    alpha = false;
+  }
+
+  auto creation_options = std::make_shared<StringList>();
+  Local<String> co_sym = Nan::New("creationOptions").ToLocalChecked();
+  if (Nan::HasOwnProperty(obj, co_sym).FromMaybe(false)) {
+    if (creation_options->parse(Nan::Get(obj, co_sym).ToLocalChecked())) return;
+  }
+
+  // The band selection and the scaling are a lazy VRT
+  std::vector<std::string> translate_args = {"-of", "VRT", "-ot", "Byte"};
+  for (size_t i = 0; i < bands.size(); i++) {
+    translate_args.push_back("-b");
+    translate_args.push_back(std::to_string(bands[i]));
+  }
+  for (size_t i = 0; i < scales.size(); i++) {
+    translate_args.push_back("-scale_" + std::to_string(i + 1));
+    translate_args.push_back(CPLSPrintf("%.17g", scales[i].min));
+    translate_args.push_back(CPLSPrintf("%.17g", scales[i].max));
+    translate_args.push_back("0");
+    translate_args.push_back("255");
+  }
+
+  // gdalwarp picks the overview level closest to the target resolution
+  double res = 2 * WEB_MERCATOR_EXTENT / (static_cast<double>(tileSize) * static_cast<double>(1 << z));
+  double minX = -WEB_MERCATOR_EXTENT + static_cast<double>(x) * tileSize * res;
+  double maxY = WEB_MERCATOR_EXTENT - static_cast<double>(y) * tileSize * res;
+  std::vector<std::string> warp_args = {
+    "-of",
+    "MEM",
+    "-t_srs",
+    "EPSG:3857",
+    "-te",
+    CPLSPrintf("%.17g", minX),
+    CPLSPrintf("%.17g", maxY - tileSize * res),
+    CPLSPrintf("%.17g", minX + tileSize * res),
+    CPLSPrintf("%.17g", maxY),
+    "-ts",
+    std::to_string(tileSize),
+    std::to_string(tileSize),
+    "-r",
+    alg,
+    "-ovr",
+    "AUTO"};
+  // A tile has at most 4 bands
+  if (alpha && bands.size() < 4) warp_args.push_back("-dstalpha");
+
+  GDALAsyncableJob<RenderedTile> job(ds->uid);
+  job.main = [raw, translate_args, warp_args, colors, driver, creation_options](const GDALExecutionProgress &) {
+    CPLErrorReset();
+    char **args = argList(translate_args);
+    GDALTranslateOptions *translate_opts = GDALTranslateOptionsNew(args, nullptr);
+    CSLDestroy(args);
+    GDALDatasetH vrt = GDALTranslate("", raw, translate_opts, nullptr);
+    GDALTranslateOptionsFree(translate_opts);
+    if (vrt == nullptr) throw CPLGetLastErrorMsg();
+
+    args = argList(warp_args);
+    GDALWarpAppOptions *warp_opts = GDALWarpAppOptionsNew(args, nullptr);
+    CSLDestroy(args);
+    GDALDatasetH tile = GDALWarp("", nullptr, 1, &vrt, warp_opts, nullptr);
+    GDALWarpAppOptionsFree(warp_opts);
+    GDALClose(vrt);
+    if (tile == nullptr) throw CPLGetLastErrorMsg();
+
+    if (!colors.empty()) {
+      GDALColorTable ct;
+      for (size_t i = 0; i < colors.size(); i++) ct.SetColorEntry(static_cast<int>(i), &colors[i]);
+      GDALDataset::FromHandle(tile)->GetRasterBand(1)->SetColorTable(&ct);
+    }
+
+    GDALDriver *drv = GetGDALDriverManager()->GetDriverByName(driver.c_str());
+    if (drv == nullptr) {
+      GDALClose(tile);
+      CPLErrorSetState(CE_Failure, CPLE_NotSupported, (driver + " driver is not available").c_str());
+      throw CPLGetLastErrorMsg();
+    }
+
+    // The address of the tile can be reused by another job as soon as it is closed,
+    // the name must be unique for the lifetime of the process
+    std::ostringstream name;
+    name << "/vsimem/tile_" << std::this_thread::get_id() << "_" << tile_counter++;
+    std::string filename = name.str();
+    GDALDataset *out =
+      drv->CreateCopy(filename.c_str(), GDALDataset::FromHandle(tile), FALSE, creation_options->get(), nullptr, nullptr);
+    GDALClose(tile);
+    if (out == nullptr) {
+      VSIUnlink(filename.c_str());
+      throw CPLGetLastErrorMsg();
+    }
+    GDALClose(out);
+
+    RenderedTile r;
+    r.data = VSIGetMemFileBuffer(filename.c_str(), &r.len, TRUE);
+    // Some drivers leave an .aux.xml behind
+    VSIUnlink((filename + ".aux.xml").c_str());
+    if (r.data == nullptr) throw "Failed encoding the tile";
+    return r;
+  };
+  job.rval = [](RenderedTile r, GetFromPersistentFunc) {
+    return Nan::NewBuffer(static_cast<char *>(r.data), static_cast<size_t>(r.len), Memfile::freeGDALBuffer, nullptr)
+      .ToLocalChecked();
+  };
+  job.run(info, async, 2);
+}
+
 } // namespace node_gdal
@@ -30,6 +30,7 @@ void Initialize(Local<Object> target);
 
 GDAL_ASYNCABLE_GLOBAL(reprojectImage);
 GDAL_ASYNCABLE_GLOBAL(suggestedWarpOutput);
+GDAL_ASYNCABLE_GLOBAL(renderTile);
 
 } // namespace Warper
 } // namespace node_gdal
@@ -13,16 +13,44 @@
 #include "gdal_multipolygon.hpp"
 #include "gdal_point.hpp"
 #include "gdal_polygon.hpp"
+#include "gdal_prepared_geometry.hpp"
 #include "../gdal_spatial_reference.hpp"
+#include "../gdal_srs_cache.hpp"
+#include "../utils/flat_coordinates.hpp"
+#include "../utils/typed_array.hpp"
 
 #include <node_buffer.h>
 #include <ogr_core.h>
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <stdlib.h>
+#include <thread>
 
 namespace node_gdal {
 
+// Same as NODE_WRAPPED_ASYNC_METHOD but copies a geometry borrowed from a Feature before modifying it
+#define NODE_WRAPPED_ASYNC_GEOMETRY_MUTATOR(method, wrapped_method)                                                    \
+  GDAL_ASYNCABLE_DEFINE(Geometry::method) {                                                                            \
+    Nan::HandleScope scope;                                                                                            \
+    Geometry *obj = Nan::ObjectWrap::Unwrap<Geometry>(info.This());                                                    \
+    if (!obj->isAlive()) {                                                                                             \
+      Nan::ThrowError("Geometry object has already been destroyed");                                                   \
+      return;                                                                                                          \
+    }                                                                                                                  \
+    obj->promote();                                                                                                    \
+    auto *gdal_obj = obj->this_;                                                                                       \
+    GDALAsyncableJob<int> job(0);                                                                                      \
+    job.main = [gdal_obj](const GDALExecutionProgress &) {                                                             \
+      gdal_obj->wrapped_method();                                                                                      \
+      return 0;                                                                                                        \
+    };                                                                                                                 \
+    job.rval = [](int, GetFromPersistentFunc) { return Nan::Undefined().As<Value>(); };                                \
+    job.run(info, async, 0);                                                                                           \
+  }
+
+
 Nan::Persistent<FunctionTemplate> Geometry::constructor;
 
 void Geometry::Initialize(Local<Object> target) {
@@ -37,6 +65,8 @@ void Geometry::Initialize(Local<Object> target) {
   Nan__SetAsyncableMethod(lcons, "fromWKB", Geometry::createFromWkb);
   Nan__SetAsyncableMethod(lcons, "fromGeoJson", Geometry::createFromGeoJson);
   Nan__SetAsyncableMethod(lcons, "fromGeoJsonBuffer", Geometry::createFromGeoJsonBuffer);
+  Nan::SetMethod(lcons, "fromFlat", Geometry::fromFlat);
+  Nan__SetAsyncableMethod(lcons, "batch", Geometry::batch);
   Nan::SetMethod(lcons, "getName", Geometry::getName);
   Nan::SetMethod(lcons, "getConstructor", Geometry::getConstructor);
 
@@ -51,6 +81,7 @@ void Geometry::Initialize(Local<Object> target) {
   Nan__SetPrototypeAsyncableMethod(lcons, "isSimple", isSimple);
   Nan__SetPrototypeAsyncableMethod(lcons, "isRing", isRing);
   Nan::SetPrototypeMethod(lcons, "clone", clone);
+  Nan::SetPrototypeMethod(lcons, "prepare", prepare);
   Nan__SetPrototypeAsyncableMethod(lcons, "empty", empty);
   Nan__SetPrototypeAsyncableMethod(lcons, "closeRings", closeRings);
   Nan__SetPrototypeAsyncableMethod(lcons, "intersects", intersects);
@@ -73,6 +104,7 @@ void Geometry::Initialize(Local<Object> target) {
   Nan__SetPrototypeAsyncableMethod(lcons, "simplify", simplify);
   Nan__SetPrototypeAsyncableMethod(lcons, "simplifyPreserveTopology", simplifyPreserveTopology);
   Nan::SetPrototypeMethod(lcons, "segmentize", segmentize);
+  Nan::SetPrototypeMethod(lcons, "toFlat", toFlat);
   Nan__SetPrototypeAsyncableMethod(lcons, "swapXY", swapXY);
   Nan__SetPrototypeAsyncableMethod(lcons, "getEnvelope", getEnvelope);
   Nan__SetPrototypeAsyncableMethod(lcons, "getEnvelope3D", getEnvelope3D);
@@ -128,31 +160,43 @@ NAN_METHOD(Geometry::New) {
   info.GetReturnValue().Set(info.This());
 }
 
-Local<Value> Geometry::New(OGRGeometry *geom, bool owned) {
+// Instantiates the class matching the geometry type,
+// arg is either the ownership flag or the GeometryBorrow of a view
+template <typename A> static Local<Value> NewOfType(OGRGeometry *geom, A arg) {
   Nan::EscapableHandleScope scope;
 
   if (!geom) { return scope.Escape(Nan::Null()); }
 
-  OGRwkbGeometryType type = getGeometryType_fixed(geom);
+  OGRwkbGeometryType type = Geometry::getGeometryType_fixed(geom);
   type = wkbFlatten(type);
 
   switch (type) {
-    case wkbPoint: return scope.Escape(Point::New(static_cast<OGRPoint *>(geom), owned));
-    case wkbLineString: return scope.Escape(LineString::New(static_cast<OGRLineString *>(geom), owned));
-    case wkbLinearRing: return scope.Escape(LinearRing::New(static_cast<OGRLinearRing *>(geom), owned));
-    case wkbPolygon: return scope.Escape(Polygon::New(static_cast<OGRPolygon *>(geom), owned));
+    case wkbPoint: return scope.Escape(Point::New(static_cast<OGRPoint *>(geom), arg));
+    case wkbLineString: return scope.Escape(LineString::New(static_cast<OGRLineString *>(geom), arg));
+    case wkbLinearRing: return scope.Escape(LinearRing::New(static_cast<OGRLinearRing *>(geom), arg));
+    case wkbPolygon: return scope.Escape(Polygon::New(static_cast<OGRPolygon *>(geom), arg));
     case wkbGeometryCollection:
-      return scope.Escape(GeometryCollection::New(static_cast<OGRGeometryCollection *>(geom), owned));
-    case wkbMultiPoint: return scope.Escape(MultiPoint::New(static_cast<OGRMultiPoint *>(geom), owned));
-    case wkbMultiLineString: return scope.Escape(MultiLineString::New(static_cast<OGRMultiLineString *>(geom), owned));
-    case wkbMultiPolygon: return scope.Escape(MultiPolygon::New(static_cast<OGRMultiPolygon *>(geom), owned));
-    case wkbCompoundCurve: return scope.Escape(CompoundCurve::New(static_cast<OGRCompoundCurve *>(geom), owned));
-    case wkbCircularString: return scope.Escape(CircularString::New(static_cast<OGRCircularString *>(geom), owned));
-    case wkbMultiCurve: return scope.Escape(MultiCurve::New(static_cast<OGRMultiCurve *>(geom), owned));
+      return scope.Escape(GeometryCollection::New(static_cast<OGRGeometryCollection *>(geom), arg));
+    case wkbMultiPoint: return scope.Escape(MultiPoint::New(static_cast<OGRMultiPoint *>(geom), arg));
+    case wkbMultiLineString: return scope.Escape(MultiLineString::New(static_cast<OGRMultiLineString *>(geom), arg));
+    case wkbMultiPolygon: return scope.Escape(MultiPolygon::New(static_cast<OGRMultiPolygon *>(geom), arg));
+    case wkbCompoundCurve: return scope.Escape(CompoundCurve::New(static_cast<OGRCompoundCurve *>(geom), arg));
+    case wkbCircularString: return scope.Escape(CircularString::New(static_cast<OGRCircularString *>(geom), arg));
+    case wkbMultiCurve: return scope.Escape(MultiCurve::New(static_cast<OGRMultiCurve *>(geom), arg));
     default: Nan::ThrowError("Tried to create unsupported geometry type"); return scope.Escape(Nan::Undefined());
   }
 }
 
+Local<Value> Geometry::New(OGRGeometry *geom, bool owned) {
+  Nan::EscapableHandleScope scope;
+  return scope.Escape(NewOfType(geom, owned));
+}
+
+Local<Value> Geometry::New(OGRGeometry *geom, const std::shared_ptr<GeometryBorrow> &borrow) {
+  Nan::EscapableHandleScope scope;
+  return scope.Escape(NewOfType(geom, borrow));
+}
+
 OGRwkbGeometryType Geometry::getGeometryType_fixed(OGRGeometry *geom) {
   // For some reason OGRLinearRing::getGeometryType uses OGRLineString's
   // method... meaning OGRLinearRing::getGeometryType returns wkbLineString
@@ -191,7 +235,7 @@ NAN_METHOD(Geometry::toString) {
  * @return {Promise<void>}
  */
 
-NODE_WRAPPED_ASYNC_METHOD(Geometry, closeRings, closeRings);
+NODE_WRAPPED_ASYNC_GEOMETRY_MUTATOR(closeRings, closeRings);
 
 /**
  * Clears the geometry.
@@ -208,7 +252,7 @@ NODE_WRAPPED_ASYNC_METHOD(Geometry, closeRings, closeRings);
  * @return {Promise<void>}
  */
 
-NODE_WRAPPED_ASYNC_METHOD(Geometry, empty, empty);
+NODE_WRAPPED_ASYNC_GEOMETRY_MUTATOR(empty, empty);
 
 /**
  * Swaps x, y coordinates.
@@ -225,7 +269,7 @@ NODE_WRAPPED_ASYNC_METHOD(Geometry, empty, empty);
  * @return {Promise<void>}
  */
 
-NODE_WRAPPED_ASYNC_METHOD(Geometry, swapXY, swapXY);
+NODE_WRAPPED_ASYNC_GEOMETRY_MUTATOR(swapXY, swapXY);
 
 /**
  * Determines if the geometry is empty.
@@ -495,7 +539,18 @@ NODE_WRAPPED_ASYNC_METHOD_WITH_RESULT_1_WRAPPED_PARAM(
  * @param {number} segment_length
  * @return {number}
  */
-NODE_WRAPPED_METHOD_WITH_1_DOUBLE_PARAM(Geometry, segmentize, segmentize, "segment length");
+NAN_METHOD(Geometry::segmentize) {
+  Nan::HandleScope scope;
+  double length;
+  NODE_ARG_DOUBLE(0, "segment length", length);
+  Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
+  if (!geom->isAlive()) {
+    Nan::ThrowError("Geometry object has already been destroyed");
+    return;
+  }
+  geom->promote();
+  geom->this_->segmentize(length);
+}
 
 /**
  * Apply arbitrary coordinate transformation to the geometry.
@@ -527,8 +582,28 @@ NODE_WRAPPED_METHOD_WITH_1_DOUBLE_PARAM(Geometry, segmentize, segmentize, "segme
  * @return {Promise<void>}
  */
 
-NODE_WRAPPED_ASYNC_METHOD_WITH_OGRERR_RESULT_1_WRAPPED_PARAM(
-  Geometry, int, transform, transform, CoordinateTransformation, "transform");
+GDAL_ASYNCABLE_DEFINE(Geometry::transform) {
+  Nan::HandleScope scope;
+  CoordinateTransformation *ct;
+  NODE_ARG_WRAPPED(0, "transform", CoordinateTransformation, ct);
+  Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
+  if (!geom->isAlive()) {
+    Nan::ThrowError("Geometry object has already been destroyed");
+    return;
+  }
+  geom->promote();
+  OGRGeometry *gdal_geom = geom->this_;
+  OGRCoordinateTransformation *gdal_ct = ct->get();
+  GDALAsyncableJob<int> job(0);
+  job.persist(info[0].As<Object>());
+  job.main = [gdal_geom, gdal_ct](const GDALExecutionProgress &) {
+    int err = gdal_geom->transform(gdal_ct);
+    if (err) throw getOGRErrMsg(err);
+    return err;
+  };
+  job.rval = [](int, GetFromPersistentFunc) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 1);
+}
 
 /**
  * Transforms the geometry to match the provided {{#crossLink
@@ -551,8 +626,35 @@ NODE_WRAPPED_ASYNC_METHOD_WITH_OGRERR_RESULT_1_WRAPPED_PARAM(
  * @return {Promise<void>}
  */
 
-NODE_WRAPPED_ASYNC_METHOD_WITH_OGRERR_RESULT_1_WRAPPED_PARAM(
-  Geometry, int, transformTo, transformTo, SpatialReference, "spatial reference");
+// The transformation comes from the SRS cache instead of being created by OGRGeometry::transformTo()
+GDAL_ASYNCABLE_DEFINE(Geometry::transformTo) {
+  Nan::HandleScope scope;
+  SpatialReference *srs;
+  NODE_ARG_WRAPPED(0, "spatial reference", SpatialReference, srs);
+  Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
+  if (!geom->isAlive()) {
+    Nan::ThrowError("Geometry object has already been destroyed");
+    return;
+  }
+  geom->promote();
+  OGRGeometry *gdal_geom = geom->this_;
+  OGRSpatialReference *gdal_srs = srs->get();
+  GDALAsyncableJob<int> job(0);
+  job.persist(info[0].As<Object>());
+  job.main = [gdal_geom, gdal_srs](const GDALExecutionProgress &) {
+    const OGRSpatialReference *src = gdal_geom->getSpatialReference();
+    if (src == nullptr) throw getOGRErrMsg(OGRERR_FAILURE);
+    CPLErrorReset();
+    OGRCoordinateTransformation *ct = SRSCache::getCT(src, gdal_srs);
+    if (ct == nullptr) throw CPLGetLastErrorMsg();
+    OGRErr err = gdal_geom->transform(ct);
+    OGRCoordinateTransformation::DestroyCT(ct);
+    if (err) throw getOGRErrMsg(err);
+    return 0;
+  };
+  job.rval = [](int, GetFromPersistentFunc) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 1);
+}
 
 /**
  * Clones the instance.
@@ -566,6 +668,25 @@ NAN_METHOD(Geometry::clone) {
   info.GetReturnValue().Set(Geometry::New(geom->this_->clone()));
 }
 
+/**
+ * Creates a {{#crossLink "gdal.PreparedGeometry"}}PreparedGeometry{{/crossLink}}
+ * from a copy of the geometry for testing spatial predicates
+ * against a large number of geometries.
+ *
+ * @method prepare
+ * @throws Error
+ * @return {gdal.PreparedGeometry}
+ */
+NAN_METHOD(Geometry::prepare) {
+  Nan::HandleScope scope;
+  Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
+  if (!geom->isAlive()) {
+    Nan::ThrowError("Geometry object has already been destroyed");
+    return;
+  }
+  info.GetReturnValue().Set(PreparedGeometry::New(geom->this_));
+}
+
 /**
  * Compute convex hull.
  *
@@ -1378,7 +1499,7 @@ GDAL_ASYNCABLE_DEFINE(Geometry::getEnvelope3D) {
  * @return {Promise<void>}
  */
 
-NODE_WRAPPED_ASYNC_METHOD(Geometry, flattenTo2D, flattenTo2D);
+NODE_WRAPPED_ASYNC_GEOMETRY_MUTATOR(flattenTo2D, flattenTo2D);
 
 // --- JS static methods (OGRGeometryFactory) ---
 
@@ -1614,6 +1735,524 @@ GDAL_ASYNCABLE_DEFINE(Geometry::createFromGeoJsonBuffer) {
 #endif
 }
 
+/**
+ * @typedef FlatGeometry { type: number, dims: string, coordinates: Float64Array, ringOffsets?: Uint32Array, partOffsets?: Uint32Array }
+ */
+
+static void appendRings(const OGRPolygon *poly, std::vector<const OGRSimpleCurve *> &rings) {
+  if (poly->getExteriorRing() == nullptr) return;
+  rings.push_back(poly->getExteriorRing());
+  for (int i = 0; i < poly->getNumInteriorRings(); i++) rings.push_back(poly->getInteriorRing(i));
+}
+
+static Local<Value> newOffsets(const std::vector<uint32_t> &offsets) {
+  Nan::EscapableHandleScope scope;
+  Local<Value> array = TypedArray::New(GDT_UInt32, offsets.size());
+  if (array.IsEmpty() || !array->IsObject()) return scope.Escape(array);
+  Nan::TypedArrayContents<uint32_t> contents(array);
+  std::copy(offsets.begin(), offsets.end(), *contents);
+  return scope.Escape(array);
+}
+
+/**
+ * Exports the coordinates of a Point, LineString, Polygon, MultiPoint, MultiLineString
+ * or MultiPolygon to a single interleaved `Float64Array` without creating a JS object per vertex.
+ *
+ * `ringOffsets` contains the index of the first vertex of every ring (or line) and
+ * the total number of vertices as last element, it is present for Polygons,
+ * MultiLineStrings and MultiPolygons.
+ * `partOffsets` contains the index of the first ring of every polygon and the total
+ * number of rings as last element, it is present only for MultiPolygons.
+ *
+ * This is the layout used by GeoArrow and, for polygons, it can be passed to `earcut`.
+ *
+ * @example
+ * ```
+ * const flat = polygon.toFlat({ dims: 'xy' });
+ * const triangles = earcut(flat.coordinates, flat.ringOffsets.slice(1, -1), 2);```
+ *
+ * @method toFlat
+ * @param {FlatCoordinatesOptions} [options]
+ * @param {string} [options.dims] `"xy"`, `"xyz"`, `"xym"` or `"xyzm"`, defaults to the dimensions of the geometry
+ * @throws Error
+ * @return {FlatGeometry}
+ */
+NAN_METHOD(Geometry::toFlat) {
+  Nan::HandleScope scope;
+
+  Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
+  OGRGeometry *raw = geom->this_;
+
+  FlatCoordinates::Dims dims = FlatCoordinates::Of(raw);
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(0, "options", options);
+  if (!options.IsEmpty()) {
+    std::string dims_name = "";
+    NODE_STR_FROM_OBJ_OPT(options, "dims", dims_name);
+    if (!dims_name.empty() && !FlatCoordinates::Parse(dims_name, dims)) {
+      Nan::ThrowError("dims must be one of xy, xyz, xym or xyzm");
+      return;
+    }
+  }
+
+  OGRwkbGeometryType type = wkbFlatten(raw->getGeometryType());
+  std::vector<const OGRSimpleCurve *> rings;
+  std::vector<const OGRPoint *> points;
+  std::vector<uint32_t> part_offsets;
+  switch (type) {
+    case wkbPoint:
+      if (!raw->IsEmpty()) points.push_back(raw->toPoint());
+      break;
+    case wkbLineString: rings.push_back(raw->toLineString()); break;
+    case wkbPolygon: appendRings(raw->toPolygon(), rings); break;
+    case wkbMultiPoint:
+      for (const OGRPoint *pt : *raw->toMultiPoint()) points.push_back(pt);
+      break;
+    case wkbMultiLineString:
+      for (const OGRLineString *line : *raw->toMultiLineString()) rings.push_back(line);
+      break;
+    case wkbMultiPolygon:
+      for (const OGRPolygon *poly : *raw->toMultiPolygon()) {
+        part_offsets.push_back(rings.size());
+        appendRings(poly, rings);
+      }
+      part_offsets.push_back(rings.size());
+      break;
+    default: Nan::ThrowError("Unsupported geometry type for flat coordinates"); return;
+  }
+
+  std::vector<uint32_t> ring_offsets;
+  size_t vertices = points.size();
+  for (const OGRSimpleCurve *ring : rings) {
+    ring_offsets.push_back(vertices);
+    vertices += ring->getNumPoints();
+  }
+  ring_offsets.push_back(vertices);
+
+  int stride = dims.stride();
+  Local<Value> coordinates = TypedArray::New(GDT_Float64, vertices * stride);
+  if (coordinates.IsEmpty() || !coordinates->IsObject()) return; // TypedArray::New threw an error
+  Nan::TypedArrayContents<double> contents(coordinates);
+  double *dst = *contents;
+  for (const OGRPoint *pt : points) {
+    FlatCoordinates::Export(pt, dims, dst);
+    dst += stride;
+  }
+  for (const OGRSimpleCurve *ring : rings) {
+    if (ring->getNumPoints() == 0) continue;
+    FlatCoordinates::Export(ring, dims, dst);
+    dst += ring->getNumPoints() * stride;
+  }
+
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("type").ToLocalChecked(), Nan::New<Integer>(type));
+  Nan::Set(result, Nan::New("dims").ToLocalChecked(), SafeString::New(FlatCoordinates::Name(dims).c_str()));
+  Nan::Set(result, Nan::New("coordinates").ToLocalChecked(), coordinates);
+  if (type == wkbPolygon || type == wkbMultiLineString || type == wkbMultiPolygon)
+    Nan::Set(result, Nan::New("ringOffsets").ToLocalChecked(), newOffsets(ring_offsets));
+  if (type == wkbMultiPolygon) Nan::Set(result, Nan::New("partOffsets").ToLocalChecked(), newOffsets(part_offsets));
+
+  info.GetReturnValue().Set(result);
+}
+
+static bool getOffsets(Local<Object> flat, const char *key, size_t max, std::vector<uint32_t> &offsets) {
+  Local<Value> val = Nan::Get(flat, Nan::New(key).ToLocalChecked()).ToLocalChecked();
+  if (!val->IsUint32Array()) {
+    Nan::ThrowTypeError((std::string(key) + " must be an Uint32Array").c_str());
+    return false;
+  }
+  Nan::TypedArrayContents<uint32_t> contents(val);
+  if (contents.length() < 1) {
+    Nan::ThrowError((std::string(key) + " must not be empty").c_str());
+    return false;
+  }
+  offsets.assign(*contents, *contents + contents.length());
+  for (size_t i = 0; i < offsets.size(); i++) {
+    if (offsets[i] > max || (i > 0 && offsets[i] < offsets[i - 1])) {
+      Nan::ThrowRangeError((std::string(key) + " are not valid").c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+static OGRPolygon *
+importPolygon(const FlatCoordinates::Dims &dims, const double *src, const std::vector<uint32_t> &rings, size_t first, size_t last) {
+  OGRPolygon *poly = new OGRPolygon();
+  for (size_t r = first; r < last; r++) {
+    OGRLinearRing *ring = new OGRLinearRing();
+    FlatCoordinates::Import(ring, dims, src + rings[r] * dims.stride(), rings[r + 1] - rings[r]);
+    poly->addRingDirectly(ring);
+  }
+  return poly;
+}
+
+/**
+ * Creates a Point, LineString, Polygon, MultiPoint, MultiLineString or MultiPolygon
+ * from an interleaved `Float64Array` of coordinates with optional ring and part offsets
+ * in the format returned by `toFlat()`.
+ *
+ * @static
+ * @method fromFlat
+ * @param {FlatGeometry} flat
+ * @throws Error
+ * @return {gdal.Geometry}
+ */
+NAN_METHOD(Geometry::fromFlat) {
+  Nan::HandleScope scope;
+
+  Local<Object> flat;
+  NODE_ARG_OBJECT(0, "flat geometry", flat);
+
+  int type_int;
+  NODE_INT_FROM_OBJ(flat, "type", type_int);
+  OGRwkbGeometryType type = wkbFlatten(static_cast<OGRwkbGeometryType>(type_int));
+
+  FlatCoordinates::Dims dims = {false, false};
+  std::string dims_name = "";
+  NODE_STR_FROM_OBJ_OPT(flat, "dims", dims_name);
+  if (!dims_name.empty() && !FlatCoordinates::Parse(dims_name, dims)) {
+    Nan::ThrowError("dims must be one of xy, xyz, xym or xyzm");
+    return;
+  }
+
+  Local<Value> coordinates = Nan::Get(flat, Nan::New("coordinates").ToLocalChecked()).ToLocalChecked();
+  if (!coordinates->IsFloat64Array()) {
+    Nan::ThrowTypeError("coordinates must be a Float64Array");
+    return;
+  }
+  Nan::TypedArrayContents<double> contents(coordinates);
+  int stride = dims.stride();
+  if (contents.length() % stride != 0) {
+    Nan::ThrowError("coordinates length must be a multiple of the number of dimensions");
+    return;
+  }
+  const double *src = *contents;
+  size_t vertices = contents.length() / stride;
+
+  std::vector<uint32_t> rings, parts;
+  if (type == wkbPolygon || type == wkbMultiLineString || type == wkbMultiPolygon) {
+    if (!getOffsets(flat, "ringOffsets", vertices, rings)) return;
+  }
+  if (type == wkbMultiPolygon) {
+    if (!getOffsets(flat, "partOffsets", rings.size() - 1, parts)) return;
+  }
+
+  OGRGeometry *geom;
+  switch (type) {
+    case wkbPoint: {
+      OGRPoint *pt = new OGRPoint();
+      if (vertices > 0) FlatCoordinates::Import(pt, dims, src);
+      geom = pt;
+    } break;
+    case wkbLineString: {
+      OGRLineString *line = new OGRLineString();
+      FlatCoordinates::Import(line, dims, src, vertices);
+      geom = line;
+    } break;
+    case wkbPolygon: geom = importPolygon(dims, src, rings, 0, rings.size() - 1); break;
+    case wkbMultiPoint: {
+      OGRMultiPoint *multi = new OGRMultiPoint();
+      for (size_t i = 0; i < vertices; i++) {
+        OGRPoint *pt = new OGRPoint();
+        FlatCoordinates::Import(pt, dims, src + i * stride);
+        multi->addGeometryDirectly(pt);
+      }
+      geom = multi;
+    } break;
+    case wkbMultiLineString: {
+      OGRMultiLineString *multi = new OGRMultiLineString();
+      for (size_t r = 0; r + 1 < rings.size(); r++) {
+        OGRLineString *line = new OGRLineString();
+        FlatCoordinates::Import(line, dims, src + rings[r] * stride, rings[r + 1] - rings[r]);
+        multi->addGeometryDirectly(line);
+      }
+      geom = multi;
+    } break;
+    case wkbMultiPolygon: {
+      OGRMultiPolygon *multi = new OGRMultiPolygon();
+      for (size_t p = 0; p + 1 < parts.size(); p++)
+        multi->addGeometryDirectly(importPolygon(dims, src, rings, parts[p], parts[p + 1]));
+      geom = multi;
+    } break;
+    default: Nan::ThrowError("Unsupported geometry type for flat coordinates"); return;
+  }
+
+  info.GetReturnValue().Set(Geometry::New(geom, true));
+}
+
+// Operations of Geometry.batch()
+enum GeometryBatchOp {
+  BatchBuffer,
+  BatchSimplify,
+  BatchSimplifyPreserveTopology,
+  BatchMakeValid,
+  BatchConvexHull,
+  BatchCentroid,
+  BatchBoundary,
+  BatchTransform,
+  // these return a boolean
+  BatchIsValid,
+  BatchIsSimple,
+  BatchIsEmpty
+};
+
+static const std::map<std::string, GeometryBatchOp> geometryBatchOps = {
+  {"buffer", BatchBuffer},
+  {"simplify", BatchSimplify},
+  {"simplifyPreserveTopology", BatchSimplifyPreserveTopology},
+#if GDAL_VERSION_MAJOR >= 3
+  {"makeValid", BatchMakeValid},
+#endif
+  {"convexHull", BatchConvexHull},
+  {"centroid", BatchCentroid},
+  {"boundary", BatchBoundary},
+  {"transform", BatchTransform},
+  {"isValid", BatchIsValid},
+  {"isSimple", BatchIsSimple},
+  {"isEmpty", BatchIsEmpty}};
+
+struct GeometryBatchResult {
+  std::vector<OGRGeometry *> geoms;
+  std::vector<uint8_t> flags;
+};
+
+// Every OGR call creates its own GEOS context, the geometries are only read
+static OGRGeometry *
+geometryBatchApply(GeometryBatchOp op, OGRGeometry *geom, const double *params, OGRCoordinateTransformation *ct) {
+  switch (op) {
+    case BatchBuffer: return geom->Buffer(params[0], (int)params[1]);
+    case BatchSimplify: return geom->Simplify(params[0]);
+    case BatchSimplifyPreserveTopology: return geom->SimplifyPreserveTopology(params[0]);
+#if GDAL_VERSION_MAJOR >= 3
+    case BatchMakeValid: return geom->MakeValid();
+#endif
+    case BatchConvexHull: return geom->ConvexHull();
+    case BatchBoundary: return geom->Boundary();
+    case BatchCentroid: {
+      OGRPoint *point = new OGRPoint();
+      if (geom->Centroid(point) != OGRERR_NONE) {
+        delete point;
+        return nullptr;
+      }
+      return point;
+    }
+    case BatchTransform: {
+      OGRGeometry *r = geom->clone();
+      if (r->transform(ct) != OGRERR_NONE) {
+        OGRGeometryFactory::destroyGeometry(r);
+        return nullptr;
+      }
+      return r;
+    }
+    default: return nullptr;
+  }
+}
+
+static bool geometryBatchTest(GeometryBatchOp op, OGRGeometry *geom) {
+  switch (op) {
+    case BatchIsValid: return geom->IsValid();
+    case BatchIsSimple: return geom->IsSimple();
+    case BatchIsEmpty: return geom->IsEmpty();
+    default: return false;
+  }
+}
+
+/**
+ * @typedef GeometryBatchOptions { threads?: number }
+ */
+
+/**
+ * Applies the same operation to an array of geometries
+ * using a pool of threads.
+ *
+ * Supported operations and their arguments are:
+ * - `buffer` - `[ distance, segments = 30 ]`
+ * - `simplify`, `simplifyPreserveTopology` - `[ tolerance ]`
+ * - `makeValid` (requires GDAL 3.0), `convexHull`, `centroid`, `boundary`
+ * - `transform` - `[ gdal.CoordinateTransformation ]`, returns transformed copies
+ * - `isValid`, `isSimple`, `isEmpty` - return an `Uint8Array`
+ *
+ * The operations that produce geometries return an array with `null` for every
+ * geometry that could not be processed.
+ *
+ * @example
+ * ```
+ * const buffered = gdal.Geometry.batch(points, 'buffer', [ 10 ], { threads: 4 });```
+ *
+ * @static
+ * @method batch
+ * @throws Error
+ * @param {gdal.Geometry[]} geometries
+ * @param {string} operation
+ * @param {any[]} [args]
+ * @param {GeometryBatchOptions} [options] `threads` defaults to the number of CPUs
+ * @return {(gdal.Geometry|null)[]|Uint8Array}
+ */
+
+/**
+ * Applies the same operation to an array of geometries
+ * using a pool of threads.
+ * {{{async}}}
+ *
+ * @static
+ * @method batchAsync
+ * @throws Error
+ * @param {gdal.Geometry[]} geometries
+ * @param {string} operation
+ * @param {any[]} [args]
+ * @param {GeometryBatchOptions} [options] `threads` defaults to the number of CPUs
+ * @param {callback<(gdal.Geometry|null)[]|Uint8Array>} [callback=undefined] {{{cb}}}
+ * @return {Promise<(gdal.Geometry|null)[]|Uint8Array>}
+ */
+GDAL_ASYNCABLE_DEFINE(Geometry::batch) {
+  Nan::HandleScope scope;
+
+  Local<Array> array;
+  std::string op_name;
+  Local<Array> args = Nan::New<Array>(0);
+  Local<Object> options;
+  int threads = CPLGetNumCPUs();
+
+  NODE_ARG_ARRAY(0, "geometries", array);
+  NODE_ARG_STR(1, "operation", op_name);
+  NODE_ARG_ARRAY_OPT(2, "arguments", args);
+  NODE_ARG_OBJECT_OPT(3, "options", options);
+  if (!options.IsEmpty()) NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+
+  auto op_it = geometryBatchOps.find(op_name);
+  if (op_it == geometryBatchOps.end()) {
+    Nan::ThrowError(("Unsupported batch operation " + op_name).c_str());
+    return;
+  }
+  GeometryBatchOp op = op_it->second;
+
+  double params[2] = {0, 30};
+  OGRCoordinateTransformation *ct = nullptr;
+  if (op == BatchBuffer || op == BatchSimplify || op == BatchSimplifyPreserveTopology) {
+    unsigned n_params = op == BatchBuffer ? 2 : 1;
+    for (unsigned i = 0; i < n_params && i < args->Length(); i++) {
+      Local<Value> val = Nan::Get(args, i).ToLocalChecked();
+      if (!val->IsNumber()) {
+        Nan::ThrowTypeError("arguments must be numbers");
+        return;
+      }
+      params[i] = Nan::To<double>(val).ToChecked();
+    }
+    if (args->Length() < 1) {
+      Nan::ThrowError((op_name + " expects at least one argument").c_str());
+      return;
+    }
+  }
+  if (op == BatchTransform) {
+    Local<Value> val = args->Length() > 0 ? Nan::Get(args, 0).ToLocalChecked() : Nan::Undefined().As<Value>();
+    if (!IS_WRAPPED(val, CoordinateTransformation)) {
+      Nan::ThrowTypeError("transform expects a CoordinateTransformation");
+      return;
+    }
+    CoordinateTransformation *transform = Nan::ObjectWrap::Unwrap<CoordinateTransformation>(val.As<Object>());
+    if (!transform->isAlive()) {
+      Nan::ThrowError("CoordinateTransformation object has already been destroyed");
+      return;
+    }
+    ct = transform->get();
+  }
+
+  std::vector<OGRGeometry *> geoms(array->Length());
+  std::vector<uv_sem_t *> locks(array->Length());
+  for (unsigned i = 0; i < array->Length(); i++) {
+    Local<Value> element = Nan::Get(array, i).ToLocalChecked();
+    if (!IS_WRAPPED(element, Geometry)) {
+      Nan::ThrowTypeError("geometries must contain only Geometry objects");
+      return;
+    }
+    Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(element.As<Object>());
+    if (!geom->isAlive()) {
+      Nan::ThrowError("Geometry object has already been destroyed");
+      return;
+    }
+    geoms[i] = geom->get();
+    locks[i] = geom->async_lock;
+  }
+
+  // Coordinate transformations are not thread-safe, each thread gets its own copy
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
+  if (ct != nullptr && dynamic_cast<GeoTransformTransformer *>(ct) != nullptr) threads = 1;
+#else
+  if (ct != nullptr) threads = 1;
+#endif
+  threads = std::max(1, std::min(threads, (int)geoms.size()));
+
+  GDALAsyncableJob<GeometryBatchResult> job(0);
+  job.persist(array);
+  if (ct != nullptr) job.persist(args);
+  job.main = [geoms, locks, op, params, ct, threads](const GDALExecutionProgress &) {
+    GeometryBatchResult r;
+    bool test = op >= BatchIsValid;
+    if (test)
+      r.flags.resize(geoms.size());
+    else
+      r.geoms.resize(geoms.size());
+
+    auto process = [&geoms, &locks, &r, op, &params, test](
+                     size_t begin, size_t end, OGRCoordinateTransformation *thread_ct) {
+      for (size_t i = begin; i < end; i++) {
+        // Only one geometry is locked at a time, the same geometry can appear more than once
+        uv_sem_wait(locks[i]);
+        if (test)
+          r.flags[i] = geometryBatchTest(op, geoms[i]);
+        else
+          r.geoms[i] = geometryBatchApply(op, geoms[i], params, thread_ct);
+        uv_sem_post(locks[i]);
+      }
+    };
+
+    int pool_size = threads;
+    std::vector<OGRCoordinateTransformation *> cts;
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
+    for (int t = 1; ct != nullptr && t < pool_size; t++) {
+      OGRCoordinateTransformation *thread_ct = ct->Clone();
+      if (thread_ct == nullptr) {
+        // Not all transformations can be cloned, fall back to the calling thread only
+        for (auto c : cts) OGRCoordinateTransformation::DestroyCT(c);
+        cts.clear();
+        pool_size = 1;
+        break;
+      }
+      cts.push_back(thread_ct);
+    }
+#endif
+
+    size_t chunk = (geoms.size() + pool_size - 1) / pool_size;
+    std::vector<std::thread> pool;
+    for (int t = 1; t < pool_size; t++) {
+      OGRCoordinateTransformation *thread_ct = ct != nullptr ? cts[t - 1] : nullptr;
+      size_t begin = std::min(geoms.size(), t * chunk);
+      size_t end = std::min(geoms.size(), (t + 1) * chunk);
+      pool.push_back(std::thread(process, begin, end, thread_ct));
+    }
+    // The calling thread processes the first chunk
+    process(0, std::min(geoms.size(), chunk), ct);
+    for (auto &thread : pool) thread.join();
+    for (auto thread_ct : cts) OGRCoordinateTransformation::DestroyCT(thread_ct);
+    return r;
+  };
+  job.rval = [op](GeometryBatchResult r, GetFromPersistentFunc) -> Local<Value> {
+    Nan::EscapableHandleScope scope;
+    if (op >= BatchIsValid) {
+      Local<Value> flags = TypedArray::New(GDT_Byte, r.flags.size());
+      if (flags.IsEmpty() || !flags->IsObject()) return scope.Escape(flags);
+      Nan::TypedArrayContents<uint8_t> contents(flags);
+      std::copy(r.flags.begin(), r.flags.end(), *contents);
+      return scope.Escape(flags);
+    }
+    Local<Array> results = Nan::New<Array>(r.geoms.size());
+    for (size_t i = 0; i < r.geoms.size(); i++) Nan::Set(results, i, Geometry::New(r.geoms[i], true));
+    return scope.Escape(results);
+  };
+  job.run(info, async, 4);
+}
+
 /**
  * Creates an empty Geometry from a WKB type.
  *
@@ -1655,6 +2294,7 @@ NAN_SETTER(Geometry::srsSetter) {
     return;
   }
 
+  geom->promote();
   geom->this_->assignSpatialReference(srs);
 }
 
@@ -1728,6 +2368,7 @@ NAN_SETTER(Geometry::coordinateDimensionSetter) {
     return;
   }
 
+  geom->promote();
   geom->this_->setCoordinateDimension(dim);
 }
 
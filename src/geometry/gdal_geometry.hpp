@@ -28,12 +28,14 @@ class Geometry : public GeometryBase<Geometry, OGRGeometry> {
   static NAN_METHOD(New);
   using GeometryBase<Geometry, OGRGeometry>::New;
   static Local<Value> New(OGRGeometry *geom, bool owned);
+  static Local<Value> New(OGRGeometry *geom, const std::shared_ptr<GeometryBorrow> &borrow);
   static NAN_METHOD(toString);
   GDAL_ASYNCABLE_DECLARE(isEmpty);
   GDAL_ASYNCABLE_DECLARE(isValid);
   GDAL_ASYNCABLE_DECLARE(isSimple);
   GDAL_ASYNCABLE_DECLARE(isRing);
   static NAN_METHOD(clone);
+  static NAN_METHOD(prepare);
   GDAL_ASYNCABLE_DECLARE(empty);
   GDAL_ASYNCABLE_DECLARE(exportToKML);
   GDAL_ASYNCABLE_DECLARE(exportToGML);
@@ -64,6 +66,7 @@ class Geometry : public GeometryBase<Geometry, OGRGeometry> {
   GDAL_ASYNCABLE_DECLARE(polygonize);
   GDAL_ASYNCABLE_DECLARE(swapXY);
   static NAN_METHOD(getNumGeometries);
+  static NAN_METHOD(toFlat);
   GDAL_ASYNCABLE_DECLARE(getEnvelope);
   GDAL_ASYNCABLE_DECLARE(getEnvelope3D);
   GDAL_ASYNCABLE_DECLARE(flattenTo2D);
@@ -79,6 +82,8 @@ class Geometry : public GeometryBase<Geometry, OGRGeometry> {
   GDAL_ASYNCABLE_DECLARE(createFromWkb);
   GDAL_ASYNCABLE_DECLARE(createFromGeoJson);
   GDAL_ASYNCABLE_DECLARE(createFromGeoJsonBuffer);
+  static NAN_METHOD(fromFlat);
+  GDAL_ASYNCABLE_DECLARE(batch);
   static NAN_METHOD(getName);
   static NAN_METHOD(getConstructor);
 
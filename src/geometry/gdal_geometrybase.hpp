@@ -10,6 +10,8 @@
 
 #include "../gdal_common.hpp"
 
+#include <memory>
+
 using namespace v8;
 using namespace node;
 
@@ -65,10 +67,28 @@ namespace node_gdal {
     geom->size_ = new_size;                                                                                            \
   }
 
+/*
+ * State shared between a Feature and the geometry views borrowed from it
+ * (Feature.borrowGeometry())
+ *
+ * The views point directly at the geometry of the feature without owning it.
+ * When the feature lets go of its geometry (destroyed, garbage-collected,
+ * new geometry set, cursor advanced) while views are still alive, the
+ * geometry is detached from the feature and is kept here - without copying it -
+ * until the last view is gone
+ */
+struct GeometryBorrow {
+  OGRGeometry *detached = nullptr;
+  ~GeometryBorrow() {
+    if (detached) OGRGeometryFactory::destroyGeometry(detached);
+  }
+};
+
 template <class T, class OGRT> class GeometryBase : public Nan::ObjectWrap {
     public:
   static Local<Value> New(OGRT *geom);
   static Local<Value> New(OGRT *geom, bool owned);
+  static Local<Value> New(OGRT *geom, const std::shared_ptr<GeometryBorrow> &borrow);
 
   GeometryBase();
   GeometryBase(OGRT *geom);
@@ -78,6 +98,21 @@ template <class T, class OGRT> class GeometryBase : public Nan::ObjectWrap {
   inline bool isAlive() {
     return this_;
   }
+  // Must be held by the jobs that access the geometry outside of the main thread
+  inline uv_sem_t *getAsyncLock() {
+    return async_lock;
+  }
+  // Copy-on-write for the views borrowed from a Feature, must be called before modifying the geometry
+  // The view keeps its GeometryBorrow so that the original remains valid for the async readers
+  inline void promote() {
+    if (owned_ || !borrow_) return;
+    LOG("Copying borrowed Geometry [%p] before modification", this_);
+    this_ = static_cast<OGRT *>(this_->clone());
+    owned_ = true;
+    // OGRLinearRing hides WkbSize()
+    size_ = static_cast<OGRGeometry *>(this_)->WkbSize();
+    Nan::AdjustExternalMemory(size_);
+  }
 
     protected:
   ~GeometryBase();
@@ -85,6 +120,7 @@ template <class T, class OGRT> class GeometryBase : public Nan::ObjectWrap {
   bool owned_;
   int size_;
   uv_sem_t *async_lock;
+  std::shared_ptr<GeometryBorrow> borrow_;
 };
 
 template <class T, class OGRT> Local<Value> GeometryBase<T, OGRT>::New(OGRT *geom) {
@@ -117,6 +153,24 @@ template <class T, class OGRT> Local<Value> GeometryBase<T, OGRT>::New(OGRT *geo
   return scope.Escape(obj);
 }
 
+// Creates a view of a geometry owned by a Feature, see GeometryBorrow
+template <class T, class OGRT>
+Local<Value> GeometryBase<T, OGRT>::New(OGRT *geom, const std::shared_ptr<GeometryBorrow> &borrow) {
+  Nan::EscapableHandleScope scope;
+
+  if (!geom) { return scope.Escape(Nan::Null()); }
+
+  T *wrapped = new T(geom);
+  wrapped->owned_ = false;
+  wrapped->borrow_ = borrow;
+
+  Local<Value> ext = Nan::New<External>(wrapped);
+  Local<Object> obj =
+    Nan::NewInstance(Nan::GetFunction(Nan::New(T::constructor)).ToLocalChecked(), 1, &ext).ToLocalChecked();
+
+  return scope.Escape(obj);
+}
+
 template <class T, class OGRT>
 GeometryBase<T, OGRT>::GeometryBase(OGRT *geom) : Nan::ObjectWrap(), this_(geom), owned_(true), size_(0) {
   LOG("Created Geometry %s [%p]", typeid(T).name(), geom);
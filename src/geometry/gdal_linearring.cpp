@@ -91,6 +91,7 @@ NAN_METHOD(LinearRing::addSubLineString) {
     return;
   }
 
+  geom->promote();
   geom->this_->addSubLineString(other->get(), start, end);
 
   return;
@@ -102,6 +102,7 @@ NAN_SETTER(Point::xSetter) {
   }
   double x = Nan::To<double>(value).ToChecked();
 
+  geom->promote();
   ((OGRPoint *)geom->this_)->setX(x);
 }
 
@@ -125,6 +126,7 @@ NAN_SETTER(Point::ySetter) {
   }
   double y = Nan::To<double>(value).ToChecked();
 
+  geom->promote();
   ((OGRPoint *)geom->this_)->setY(y);
 }
 
@@ -147,6 +149,7 @@ NAN_SETTER(Point::zSetter) {
   }
   double z = Nan::To<double>(value).ToChecked();
 
+  geom->promote();
   ((OGRPoint *)geom->this_)->setZ(z);
 }
 
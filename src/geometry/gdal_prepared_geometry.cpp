@@ -0,0 +1,466 @@
+#include "gdal_prepared_geometry.hpp"
+#include "../gdal_common.hpp"
+#include "gdal_geometry.hpp"
+#include "../utils/flat_coordinates.hpp"
+#include "../utils/typed_array.hpp"
+
+#include <memory>
+
+namespace node_gdal {
+
+Nan::Persistent<FunctionTemplate> PreparedGeometry::constructor;
+
+void PreparedGeometry::Initialize(Local<Object> target) {
+  Nan::HandleScope scope;
+
+  Local<FunctionTemplate> lcons = Nan::New<FunctionTemplate>(PreparedGeometry::New);
+  lcons->InstanceTemplate()->SetInternalFieldCount(1);
+  lcons->SetClassName(Nan::New("PreparedGeometry").ToLocalChecked());
+
+  Nan::SetPrototypeMethod(lcons, "toString", toString);
+  Nan::SetPrototypeMethod(lcons, "intersects", intersects);
+  Nan::SetPrototypeMethod(lcons, "contains", contains);
+  Nan::SetPrototypeMethod(lcons, "containsProperly", containsProperly);
+  Nan::SetPrototypeMethod(lcons, "covers", covers);
+  Nan::SetPrototypeMethod(lcons, "within", within);
+  Nan__SetPrototypeAsyncableMethod(lcons, "intersectsMany", intersectsMany);
+  Nan__SetPrototypeAsyncableMethod(lcons, "containsMany", containsMany);
+  Nan__SetPrototypeAsyncableMethod(lcons, "containsProperlyMany", containsProperlyMany);
+  Nan__SetPrototypeAsyncableMethod(lcons, "coversMany", coversMany);
+  Nan__SetPrototypeAsyncableMethod(lcons, "withinMany", withinMany);
+
+  Nan::Set(target, Nan::New("PreparedGeometry").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
+
+  constructor.Reset(lcons);
+}
+
+PreparedGeometry::PreparedGeometry(OGRGeometry *geom, OGRPreparedGeometryH prepared)
+  : Nan::ObjectWrap(), this_(geom), prepared_(prepared), boundary_(nullptr), boundary_geom_(nullptr) {
+  LOG("Created PreparedGeometry [%p]", prepared);
+  async_lock = new uv_sem_t;
+  uv_sem_init(async_lock, 1);
+}
+
+PreparedGeometry::~PreparedGeometry() {
+  if (this_) {
+    LOG("Disposing PreparedGeometry [%p]", prepared_);
+    OGRDestroyPreparedGeometry(prepared_);
+    if (boundary_) OGRDestroyPreparedGeometry(boundary_);
+    if (boundary_geom_) OGRGeometryFactory::destroyGeometry(boundary_geom_);
+    OGRGeometryFactory::destroyGeometry(this_);
+    LOG("Disposed PreparedGeometry [%p]", prepared_);
+    this_ = nullptr;
+  }
+  uv_sem_destroy(async_lock);
+  delete async_lock;
+}
+
+/**
+ * A geometry prepared for evaluating spatial predicates against
+ * a large number of other geometries.
+ *
+ * Preparing a geometry builds a spatial index of its segments once,
+ * after which each test is much faster than the equivalent
+ * {{#crossLink "gdal.Geometry"}}Geometry{{/crossLink}} method.
+ *
+ * Requires GDAL with GEOS support.
+ *
+ * @example
+ * ```
+ * const zone = polygon.prepare();
+ * const inside = zone.containsMany(new Float64Array([ 1, 1, 2, 2, 3, 3 ]));```
+ *
+ * @class gdal.PreparedGeometry
+ */
+NAN_METHOD(PreparedGeometry::New) {
+  Nan::HandleScope scope;
+
+  if (!info.IsConstructCall()) {
+    Nan::ThrowError("Cannot call constructor as function, you need to use 'new' keyword");
+    return;
+  }
+  if (info[0]->IsExternal()) {
+    Local<External> ext = info[0].As<External>();
+    void *ptr = ext->Value();
+    PreparedGeometry *f = static_cast<PreparedGeometry *>(ptr);
+    f->Wrap(info.This());
+    info.GetReturnValue().Set(info.This());
+    return;
+  } else {
+    Nan::ThrowError("Cannot create PreparedGeometry directly, use Geometry.prepare() instead");
+    return;
+  }
+}
+
+// The geometry is copied
+Local<Value> PreparedGeometry::New(OGRGeometry *geom) {
+  Nan::EscapableHandleScope scope;
+
+  if (!OGRHasPreparedGeometrySupport()) {
+    Nan::ThrowError("Prepared geometries require GDAL with GEOS support");
+    return scope.Escape(Nan::Undefined());
+  }
+
+  OGRGeometry *copy = geom->clone();
+  OGRPreparedGeometryH prepared = OGRCreatePreparedGeometry(OGRGeometry::ToHandle(copy));
+  if (prepared == nullptr) {
+    OGRGeometryFactory::destroyGeometry(copy);
+    NODE_THROW_LAST_CPLERR;
+    return scope.Escape(Nan::Undefined());
+  }
+
+  PreparedGeometry *wrapped = new PreparedGeometry(copy, prepared);
+  Local<Value> ext = Nan::New<External>(wrapped);
+  Local<Object> obj =
+    Nan::NewInstance(Nan::GetFunction(Nan::New(PreparedGeometry::constructor)).ToLocalChecked(), 1, &ext)
+      .ToLocalChecked();
+
+  return scope.Escape(obj);
+}
+
+NAN_METHOD(PreparedGeometry::toString) {
+  Nan::HandleScope scope;
+  info.GetReturnValue().Set(Nan::New("PreparedGeometry").ToLocalChecked());
+}
+
+// GDAL exposes only intersects and contains on prepared geometries,
+// the other predicates are derived from them
+bool PreparedGeometry::evaluate(Predicate predicate, OGRGeometry *other) {
+  OGRGeometryH h = OGRGeometry::ToHandle(other);
+  switch (predicate) {
+    case Intersects: return OGRPreparedGeometryIntersects(prepared_, h);
+    case Contains: return OGRPreparedGeometryContains(prepared_, h);
+    case ContainsProperly:
+      // contained without touching the boundary
+      if (!OGRPreparedGeometryContains(prepared_, h)) return false;
+      if (boundary_geom_ == nullptr) {
+        boundary_geom_ = this_->Boundary();
+        if (boundary_geom_ == nullptr) return false;
+        boundary_ = OGRCreatePreparedGeometry(OGRGeometry::ToHandle(boundary_geom_));
+      }
+      if (boundary_) return !OGRPreparedGeometryIntersects(boundary_, h);
+      return !boundary_geom_->Intersects(other);
+    case Covers: {
+      if (!OGRPreparedGeometryIntersects(prepared_, h)) return false;
+      if (OGRPreparedGeometryContains(prepared_, h)) return true;
+      // a point that intersects without being contained lies on the boundary
+      if (wkbFlatten(other->getGeometryType()) == wkbPoint) return true;
+      std::unique_ptr<OGRGeometry> outside(other->Difference(this_));
+      return outside && outside->IsEmpty();
+    }
+    case Within: {
+      // this one cannot use the preparation
+      OGREnvelope env, other_env;
+      this_->getEnvelope(&env);
+      other->getEnvelope(&other_env);
+      if (!other_env.Contains(env)) return false;
+      return this_->Within(other);
+    }
+  }
+  return false;
+}
+
+void PreparedGeometry::evaluateOne(const Nan::FunctionCallbackInfo<v8::Value> &info, Predicate predicate) {
+  Nan::HandleScope scope;
+
+  Geometry *other;
+  NODE_ARG_WRAPPED(0, "geometry", Geometry, other);
+
+  PreparedGeometry *prepared = Nan::ObjectWrap::Unwrap<PreparedGeometry>(info.This());
+  if (!prepared->isAlive()) {
+    Nan::ThrowError("PreparedGeometry object has already been destroyed");
+    return;
+  }
+
+  uv_sem_wait(prepared->async_lock);
+  bool r = prepared->evaluate(predicate, other->get());
+  uv_sem_post(prepared->async_lock);
+
+  info.GetReturnValue().Set(Nan::New<Boolean>(r));
+}
+
+void PreparedGeometry::evaluateMany(
+  const Nan::FunctionCallbackInfo<v8::Value> &info, bool async, Predicate predicate) {
+  Nan::HandleScope scope;
+
+  PreparedGeometry *prepared = Nan::ObjectWrap::Unwrap<PreparedGeometry>(info.This());
+  if (!prepared->isAlive()) {
+    Nan::ThrowError("PreparedGeometry object has already been destroyed");
+    return;
+  }
+
+  std::vector<OGRGeometry *> geoms;
+  std::vector<uv_sem_t *> locks;
+  std::vector<Local<Object>> elements;
+  const double *coords = nullptr;
+  size_t count = 0;
+  FlatCoordinates::Dims dims = {false, false};
+
+  if (info.Length() > 0 && info[0]->IsArray()) {
+    Local<Array> array = info[0].As<Array>();
+    count = array->Length();
+    geoms.reserve(count);
+    locks.reserve(count);
+    elements.reserve(count);
+    for (unsigned i = 0; i < count; i++) {
+      Local<Value> element = Nan::Get(array, i).ToLocalChecked();
+      if (!IS_WRAPPED(element, Geometry)) {
+        Nan::ThrowTypeError("geometries must contain only Geometry objects");
+        return;
+      }
+      Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(element.As<Object>());
+      if (!geom->isAlive()) {
+        Nan::ThrowError("Geometry object has already been destroyed");
+        return;
+      }
+      geoms.push_back(geom->get());
+      locks.push_back(geom->getAsyncLock());
+      elements.push_back(element.As<Object>());
+    }
+  } else if (info.Length() > 0 && info[0]->IsFloat64Array()) {
+    Local<Object> options;
+    NODE_ARG_OBJECT_OPT(1, "options", options);
+    if (!options.IsEmpty()) {
+      std::string dims_name = "";
+      NODE_STR_FROM_OBJ_OPT(options, "dims", dims_name);
+      if (!dims_name.empty() && !FlatCoordinates::Parse(dims_name, dims)) {
+        Nan::ThrowError("dims must be one of xy, xyz, xym or xyzm");
+        return;
+      }
+    }
+    Nan::TypedArrayContents<double> contents(info[0]);
+    if (contents.length() % dims.stride() != 0) {
+      Nan::ThrowError("coordinates length must be a multiple of the number of dimensions");
+      return;
+    }
+    coords = *contents;
+    count = contents.length() / dims.stride();
+  } else {
+    Nan::ThrowTypeError("geometries must be an array of Geometry objects or a Float64Array");
+    return;
+  }
+
+  GDALAsyncableJob<std::vector<uint8_t>> job(0);
+  job.persist(info[0].As<Object>());
+  // The array can be modified while the job is running
+  if (!elements.empty()) job.persist(elements);
+  job.main = [prepared, predicate, geoms, locks, coords, count, dims](const GDALExecutionProgress &) {
+    std::vector<uint8_t> r(count);
+    uv_sem_wait(prepared->async_lock);
+    if (coords) {
+      OGRPoint point;
+      int stride = dims.stride();
+      for (size_t i = 0; i < count; i++) {
+        FlatCoordinates::Import(&point, dims, coords + i * stride);
+        r[i] = prepared->evaluate(predicate, &point);
+      }
+    } else {
+      // Only one geometry is locked at a time, the same geometry can appear more than once
+      for (size_t i = 0; i < count; i++) {
+        uv_sem_wait(locks[i]);
+        r[i] = prepared->evaluate(predicate, geoms[i]);
+        uv_sem_post(locks[i]);
+      }
+    }
+    uv_sem_post(prepared->async_lock);
+    return r;
+  };
+  job.rval = [](std::vector<uint8_t> r, GetFromPersistentFunc) {
+    Nan::EscapableHandleScope scope;
+    Local<Value> array = TypedArray::New(GDT_Byte, r.size());
+    if (array.IsEmpty() || !array->IsObject()) return scope.Escape(array);
+    Nan::TypedArrayContents<uint8_t> contents(array);
+    std::copy(r.begin(), r.end(), *contents);
+    return scope.Escape(array);
+  };
+  job.run(info, async, 2);
+}
+
+/**
+ * Tests if the geometries intersect.
+ *
+ * @method intersects
+ * @param {gdal.Geometry} geometry
+ * @return {boolean}
+ */
+NAN_METHOD(PreparedGeometry::intersects) {
+  evaluateOne(info, Intersects);
+}
+
+/**
+ * Tests if this geometry contains the other geometry.
+ *
+ * @method contains
+ * @param {gdal.Geometry} geometry
+ * @return {boolean}
+ */
+NAN_METHOD(PreparedGeometry::contains) {
+  evaluateOne(info, Contains);
+}
+
+/**
+ * Tests if the other geometry lies in the interior of this geometry
+ * without touching its boundary.
+ *
+ * @method containsProperly
+ * @param {gdal.Geometry} geometry
+ * @return {boolean}
+ */
+NAN_METHOD(PreparedGeometry::containsProperly) {
+  evaluateOne(info, ContainsProperly);
+}
+
+/**
+ * Tests if no point of the other geometry lies outside of this geometry.
+ *
+ * @method covers
+ * @param {gdal.Geometry} geometry
+ * @return {boolean}
+ */
+NAN_METHOD(PreparedGeometry::covers) {
+  evaluateOne(info, Covers);
+}
+
+/**
+ * Tests if this geometry is within the other geometry.
+ *
+ * This predicate does not benefit from the preparation.
+ *
+ * @method within
+ * @param {gdal.Geometry} geometry
+ * @return {boolean}
+ */
+NAN_METHOD(PreparedGeometry::within) {
+  evaluateOne(info, Within);
+}
+
+/**
+ * @typedef PreparedGeometryBatchOptions { dims?: string }
+ */
+
+/**
+ * Tests if the geometries intersect for every element of an array
+ * of geometries or of an interleaved `Float64Array` of points.
+ *
+ * @method intersectsMany
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryBatchOptions} [options] `dims` is one of `xy`, `xyz`, `xym` or `xyzm`
+ * when passing points, `xy` by default
+ * @return {Uint8Array} `1` for every geometry that intersects, `0` otherwise
+ */
+
+/**
+ * Tests if the geometries intersect for every element of an array
+ * of geometries or of an interleaved `Float64Array` of points.
+ * {{{async}}}
+ *
+ * @method intersectsManyAsync
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryBatchOptions} [options] `dims` is one of `xy`, `xyz`, `xym` or `xyzm`
+ * when passing points, `xy` by default
+ * @param {callback<Uint8Array>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Uint8Array>}
+ */
+GDAL_ASYNCABLE_DEFINE(PreparedGeometry::intersectsMany) {
+  evaluateMany(info, async, Intersects);
+}
+
+/**
+ * Tests if this geometry contains every element of an array
+ * of geometries or of an interleaved `Float64Array` of points.
+ *
+ * @method containsMany
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryBatchOptions} [options]
+ * @return {Uint8Array}
+ */
+
+/**
+ * Tests if this geometry contains every element of an array
+ * of geometries or of an interleaved `Float64Array` of points.
+ * {{{async}}}
+ *
+ * @method containsManyAsync
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryBatchOptions} [options]
+ * @param {callback<Uint8Array>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Uint8Array>}
+ */
+GDAL_ASYNCABLE_DEFINE(PreparedGeometry::containsMany) {
+  evaluateMany(info, async, Contains);
+}
+
+/**
+ * Tests if every element of an array of geometries or of an interleaved
+ * `Float64Array` of points lies in the interior of this geometry.
+ *
+ * @method containsProperlyMany
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryBatchOptions} [options]
+ * @return {Uint8Array}
+ */
+
+/**
+ * Tests if every element of an array of geometries or of an interleaved
+ * `Float64Array` of points lies in the interior of this geometry.
+ * {{{async}}}
+ *
+ * @method containsProperlyManyAsync
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryBatchOptions} [options]
+ * @param {callback<Uint8Array>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Uint8Array>}
+ */
+GDAL_ASYNCABLE_DEFINE(PreparedGeometry::containsProperlyMany) {
+  evaluateMany(info, async, ContainsProperly);
+}
+
+/**
+ * Tests if this geometry covers every element of an array
+ * of geometries or of an interleaved `Float64Array` of points.
+ *
+ * @method coversMany
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryBatchOptions} [options]
+ * @return {Uint8Array}
+ */
+
+/**
+ * Tests if this geometry covers every element of an array
+ * of geometries or of an interleaved `Float64Array` of points.
+ * {{{async}}}
+ *
+ * @method coversManyAsync
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryBatchOptions} [options]
+ * @param {callback<Uint8Array>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Uint8Array>}
+ */
+GDAL_ASYNCABLE_DEFINE(PreparedGeometry::coversMany) {
+  evaluateMany(info, async, Covers);
+}
+
+/**
+ * Tests if this geometry is within every element of an array of geometries.
+ *
+ * @method withinMany
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryBatchOptions} [options]
+ * @return {Uint8Array}
+ */
+
+/**
+ * Tests if this geometry is within every element of an array of geometries.
+ * {{{async}}}
+ *
+ * @method withinManyAsync
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryBatchOptions} [options]
+ * @param {callback<Uint8Array>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Uint8Array>}
+ */
+GDAL_ASYNCABLE_DEFINE(PreparedGeometry::withinMany) {
+  evaluateMany(info, async, Within);
+}
+
+} // namespace node_gdal
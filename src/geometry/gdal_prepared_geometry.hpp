@@ -0,0 +1,69 @@
+#ifndef __NODE_OGR_PREPARED_GEOMETRY_H__
+#define __NODE_OGR_PREPARED_GEOMETRY_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogr_api.h>
+#include <ogrsf_frmts.h>
+
+#include "../async.hpp"
+
+using namespace v8;
+using namespace node;
+
+namespace node_gdal {
+
+// A geometry converted once to a GEOS prepared geometry
+// for evaluating the same spatial predicate against many other geometries
+class PreparedGeometry : public Nan::ObjectWrap {
+    public:
+  enum Predicate { Intersects, Contains, ContainsProperly, Covers, Within };
+
+  static Nan::Persistent<FunctionTemplate> constructor;
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(New);
+  static Local<Value> New(OGRGeometry *geom);
+  static NAN_METHOD(toString);
+
+  static NAN_METHOD(intersects);
+  static NAN_METHOD(contains);
+  static NAN_METHOD(containsProperly);
+  static NAN_METHOD(covers);
+  static NAN_METHOD(within);
+  GDAL_ASYNCABLE_DECLARE(intersectsMany);
+  GDAL_ASYNCABLE_DECLARE(containsMany);
+  GDAL_ASYNCABLE_DECLARE(containsProperlyMany);
+  GDAL_ASYNCABLE_DECLARE(coversMany);
+  GDAL_ASYNCABLE_DECLARE(withinMany);
+
+  PreparedGeometry(OGRGeometry *geom, OGRPreparedGeometryH prepared);
+  inline bool isAlive() {
+    return this_;
+  }
+  // The caller must hold async_lock
+  bool evaluate(Predicate predicate, OGRGeometry *other);
+
+    private:
+  ~PreparedGeometry();
+  static void evaluateOne(const Nan::FunctionCallbackInfo<v8::Value> &info, Predicate predicate);
+  static void evaluateMany(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async, Predicate predicate);
+
+  // A private copy of the source geometry
+  OGRGeometry *this_;
+  OGRPreparedGeometryH prepared_;
+  // Prepared boundary, created on first use by containsProperly
+  OGRPreparedGeometryH boundary_;
+  OGRGeometry *boundary_geom_;
+  // GEOS prepared geometries build their index lazily and cannot be
+  // queried concurrently
+  uv_sem_t *async_lock;
+};
+
+} // namespace node_gdal
+#endif
@@ -124,6 +124,7 @@ NAN_METHOD(SimpleCurve::addSubLineString) {
     return;
   }
 
+  geom->promote();
   geom->this_->addSubLineString(other->get(), start, end);
 
   UPDATE_AMOUNT_OF_GEOMETRY_MEMORY(geom);
@@ -60,9 +60,12 @@
 #include "gdal_dimension.hpp"
 #include "gdal_attribute.hpp"
 #include "gdal_warper.hpp"
+#include "gdal_utils.hpp"
 
 #include "gdal_coordinate_transformation.hpp"
+#include "gdal_spatial_index.hpp"
 #include "gdal_feature.hpp"
+#include "gdal_feature_cursor.hpp"
 #include "gdal_feature_defn.hpp"
 #include "gdal_field_defn.hpp"
 #include "geometry/gdal_geometry.hpp"
@@ -79,8 +82,14 @@
 #include "geometry/gdal_multipolygon.hpp"
 #include "geometry/gdal_point.hpp"
 #include "geometry/gdal_polygon.hpp"
+#include "geometry/gdal_prepared_geometry.hpp"
 #include "gdal_spatial_reference.hpp"
 #include "gdal_memfile.hpp"
+#include "gdal_srs_cache.hpp"
+#include "gdal_vsinode.hpp"
+#include "gdal_vsistats.hpp"
+#include "gdal_dataset_cache.hpp"
+#include "gdal_block_cache.hpp"
 
 #include "utils/field_types.hpp"
 
@@ -367,6 +376,60 @@ static NAN_METHOD(setPROJSearchPath) {
 #endif
 }
 
+static Local<Object> memoryUsageEntry(size_t objects, int64_t bytes) {
+  Nan::EscapableHandleScope scope;
+  Local<Object> entry = Nan::New<Object>();
+  Nan::Set(entry, Nan::New("objects").ToLocalChecked(), Nan::New<Number>(static_cast<double>(objects)));
+  Nan::Set(entry, Nan::New("bytes").ToLocalChecked(), Nan::New<Number>(static_cast<double>(bytes)));
+  return scope.Escape(entry);
+}
+
+/**
+ * @typedef MemoryUsage { Dataset: { objects: number, bytes: number }, Layer: { objects: number, bytes: number }, MDArray: { objects: number, bytes: number }, Feature: { objects: number, bytes: number } }
+ */
+
+/**
+ * Returns the number of live objects of each type and the estimated size of
+ * their native memory, as it is reported to the V8 garbage collector.
+ *
+ * The datasets, the layers and the multidimensional arrays are counted by the object store,
+ * the features by their wrappers. The estimations include the pixels of the `MEM` datasets
+ * and arrays, the FID indexes of the layers and the fields and geometries of the features,
+ * the blocks in the GDAL block cache are not included (see `gdal.cache`).
+ *
+ * @example
+ * ```
+ * const { Dataset, Feature } = gdal.memoryUsage();
+ * console.log(`${Dataset.objects} datasets, ${Feature.bytes} bytes in features`);
+ * ```
+ *
+ * @for gdal
+ * @static
+ * @method memoryUsage
+ * @return {MemoryUsage}
+ */
+static NAN_METHOD(memoryUsage) {
+  Nan::HandleScope scope;
+  Local<Object> result = Nan::New<Object>();
+  size_t objects;
+  int64_t bytes;
+
+  object_store.usage<GDALDataset *>(objects, bytes);
+  Nan::Set(result, Nan::New("Dataset").ToLocalChecked(), memoryUsageEntry(objects, bytes));
+  object_store.usage<OGRLayer *>(objects, bytes);
+  Nan::Set(result, Nan::New("Layer").ToLocalChecked(), memoryUsageEntry(objects, bytes));
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
+  object_store.usage<std::shared_ptr<GDALMDArray>>(objects, bytes);
+#else
+  objects = 0;
+  bytes = 0;
+#endif
+  Nan::Set(result, Nan::New("MDArray").ToLocalChecked(), memoryUsageEntry(objects, bytes));
+  Nan::Set(result, Nan::New("Feature").ToLocalChecked(), memoryUsageEntry(Feature::live_count, Feature::live_size));
+
+  info.GetReturnValue().Set(result);
+}
+
 static NAN_METHOD(ThrowDummyCPLError) {
   CPLError(CE_Failure, CPLE_AppDefined, "Mock error");
   return;
@@ -388,10 +451,12 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
   Nan::SetMethod(target, "getConfigOption", getConfigOption);
   Nan::SetMethod(target, "decToDMS", decToDMS);
   Nan::SetMethod(target, "setPROJSearchPath", setPROJSearchPath);
+  Nan::SetMethod(target, "memoryUsage", memoryUsage);
   Nan::SetMethod(target, "_triggerCPLError", ThrowDummyCPLError); // for tests
   Nan::SetMethod(target, "_isAlive", isAlive);                    // for tests
 
   Warper::Initialize(target);
+  Utils::Initialize(target);
   Algorithms::Initialize(target);
 
   Driver::Initialize(target);
@@ -406,6 +471,7 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
 
   Layer::Initialize(target);
   Feature::Initialize(target);
+  FeatureCursor::Initialize(target);
   FeatureDefn::Initialize(target);
   FieldDefn::Initialize(target);
   Geometry::Initialize(target);
@@ -421,9 +487,11 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
   CircularString::Initialize(target);
   CompoundCurve::Initialize(target);
   MultiCurve::Initialize(target);
+  PreparedGeometry::Initialize(target);
 
   SpatialReference::Initialize(target);
   CoordinateTransformation::Initialize(target);
+  SpatialIndex::Initialize(target);
 
   DatasetBands::Initialize(target);
   DatasetLayers::Initialize(target);
@@ -446,6 +514,11 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
   RasterBandOverviews::Initialize(target);
   RasterBandPixels::Initialize(target);
   Memfile::Initialize(target);
+  SRSCache::Initialize(target);
+  VSINode::Initialize(target);
+  VSIStats::Initialize(target);
+  DatasetCache::Initialize(target);
+  BlockCache::Initialize(target);
 
   /**
    * The collection of all drivers registered with GDAL
@@ -0,0 +1,62 @@
+#include "flat_coordinates.hpp"
+
+#include <vector>
+
+namespace node_gdal {
+
+bool FlatCoordinates::Parse(const std::string &name, Dims &dims) {
+  if (name == "xy")
+    dims = {false, false};
+  else if (name == "xyz")
+    dims = {true, false};
+  else if (name == "xym")
+    dims = {false, true};
+  else if (name == "xyzm")
+    dims = {true, true};
+  else
+    return false;
+  return true;
+}
+
+std::string FlatCoordinates::Name(const Dims &dims) {
+  return std::string("xy") + (dims.z ? "z" : "") + (dims.m ? "m" : "");
+}
+
+FlatCoordinates::Dims FlatCoordinates::Of(const OGRGeometry *geom) {
+  return {geom->Is3D() != FALSE, geom->IsMeasured() != FALSE};
+}
+
+void FlatCoordinates::Export(const OGRSimpleCurve *curve, const Dims &dims, double *dst) {
+  int stride = dims.stride() * sizeof(double);
+  curve->getPoints(
+    dst, stride, dst + 1, stride, dims.z ? dst + 2 : nullptr, stride, dims.m ? dst + (dims.z ? 3 : 2) : nullptr, stride);
+}
+
+void FlatCoordinates::Export(const OGRPoint *point, const Dims &dims, double *dst) {
+  *dst++ = point->getX();
+  *dst++ = point->getY();
+  if (dims.z) *dst++ = point->getZ();
+  if (dims.m) *dst++ = point->getM();
+}
+
+void FlatCoordinates::Import(OGRSimpleCurve *curve, const Dims &dims, const double *src, int count) {
+  int stride = dims.stride();
+  std::vector<double> x(count), y(count), z(dims.z ? count : 0), m(dims.m ? count : 0);
+  for (int i = 0; i < count; i++) {
+    const double *v = src + i * stride;
+    x[i] = v[0];
+    y[i] = v[1];
+    if (dims.z) z[i] = v[2];
+    if (dims.m) m[i] = v[dims.z ? 3 : 2];
+  }
+  curve->setPoints(count, x.data(), y.data(), dims.z ? z.data() : nullptr, dims.m ? m.data() : nullptr);
+}
+
+void FlatCoordinates::Import(OGRPoint *point, const Dims &dims, const double *src) {
+  point->setX(src[0]);
+  point->setY(src[1]);
+  if (dims.z) point->setZ(src[2]);
+  if (dims.m) point->setM(src[dims.z ? 3 : 2]);
+}
+
+} // namespace node_gdal
@@ -0,0 +1,48 @@
+#ifndef __NODE_FLAT_COORDINATES_H__
+#define __NODE_FLAT_COORDINATES_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include <string>
+
+using namespace v8;
+
+namespace node_gdal {
+
+// Interleaved coordinate buffers - x,y[,z][,m] for every vertex
+// Used for exchanging geometries with WebGL / WASM libraries without
+// creating a JS object per vertex
+
+namespace FlatCoordinates {
+
+struct Dims {
+  bool z;
+  bool m;
+  inline int stride() const {
+    return 2 + (z ? 1 : 0) + (m ? 1 : 0);
+  }
+};
+
+// 'xy', 'xyz', 'xym' or 'xyzm'
+bool Parse(const std::string &name, Dims &dims);
+std::string Name(const Dims &dims);
+Dims Of(const OGRGeometry *geom);
+
+// Writes curve->getNumPoints() vertices to dst
+void Export(const OGRSimpleCurve *curve, const Dims &dims, double *dst);
+void Export(const OGRPoint *point, const Dims &dims, double *dst);
+// Replaces all the vertices of the curve
+void Import(OGRSimpleCurve *curve, const Dims &dims, const double *src, int count);
+void Import(OGRPoint *point, const Dims &dims, const double *src);
+
+} // namespace FlatCoordinates
+
+} // namespace node_gdal
+#endif
@@ -0,0 +1,92 @@
+#ifndef __NODE_GDAL_LRU_CACHE_H__
+#define __NODE_GDAL_LRU_CACHE_H__
+
+#include <functional>
+#include <list>
+#include <map>
+#include <utility>
+
+namespace node_gdal {
+
+// A least recently used cache
+// It is not thread-safe, the caller must provide the locking
+// The deleter is called for every evicted value
+template <typename K, typename V> class LRUCache {
+    public:
+  typedef std::function<void(V &)> Deleter;
+
+  LRUCache(size_t max, const Deleter &deleter) : max(max), deleter(deleter), items(), index() {
+  }
+  ~LRUCache() {
+    clear();
+  }
+
+  // Returns nullptr if the key is not in the cache
+  V *get(const K &key) {
+    auto it = index.find(key);
+    if (it == index.end()) return nullptr;
+    items.splice(items.begin(), items, it->second);
+    return &it->second->second;
+  }
+
+  void put(const K &key, const V &value) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+      deleter(it->second->second);
+      items.erase(it->second);
+      index.erase(it);
+    }
+    items.emplace_front(key, value);
+    index[key] = items.begin();
+    trim();
+  }
+
+  void erase(const K &key) {
+    auto it = index.find(key);
+    if (it == index.end()) return;
+    deleter(it->second->second);
+    items.erase(it->second);
+    index.erase(it);
+  }
+
+  void clear() {
+    for (auto &item : items) deleter(item.second);
+    items.clear();
+    index.clear();
+  }
+
+  inline size_t size() const {
+    return items.size();
+  }
+
+  inline size_t getMax() const {
+    return max;
+  }
+
+  void setMax(size_t size) {
+    max = size;
+    trim();
+  }
+
+  // From the most recently used to the least recently used
+  inline std::list<std::pair<K, V>> &list() {
+    return items;
+  }
+
+    private:
+  void trim() {
+    while (items.size() > max) {
+      deleter(items.back().second);
+      index.erase(items.back().first);
+      items.pop_back();
+    }
+  }
+
+  size_t max;
+  Deleter deleter;
+  std::list<std::pair<K, V>> items;
+  std::map<K, typename std::list<std::pair<K, V>>::iterator> index;
+};
+
+} // namespace node_gdal
+#endif
@@ -6,7 +6,9 @@
 #include "../gdal_attribute.hpp"
 #include "../gdal_layer.hpp"
 #include "../gdal_rasterband.hpp"
+#include "../gdal_vsinode.hpp"
 
+#include <climits>
 #include <sstream>
 #include <thread>
 
@@ -85,7 +87,7 @@ class uv_scoped_mutex {
   uv_mutex_t *lock;
 };
 
-ObjectStore::ObjectStore() : uid(1) {
+ObjectStore::ObjectStore() : uid(1), released(0) {
 #ifdef PTHREAD_MUTEX_DEBUG
   pthread_mutexattr_t attr;
   pthread_mutexattr_init(&attr);
@@ -121,10 +123,14 @@ static inline void sortUnique(vector<long> &uids) {
   if (uids.front() == 0) uids.erase(uids.begin());
 }
 
+static const char vsinodeDeadlock[] =
+  "Dataset is in use by an asynchronous operation waiting for a /vsinode/ callback, a synchronous call would deadlock";
+
 /*
  * Lock a Dataset by uid, throws when the Dataset has been destroyed
  * There is a single global condition which allows to avoid active spinning
  * Every time a Dataset releases a lock it must broadcast the condition
+ * The main thread never waits while it has to run /vsinode/ callbacks
  */
 AsyncLock ObjectStore::lockDataset(long uid) {
   if (uid == 0) return nullptr;
@@ -134,6 +140,7 @@ AsyncLock ObjectStore::lockDataset(long uid) {
     if (parent == uidMap<GDALDataset *>.end()) { throw "Parent Dataset object has already been destroyed"; }
     int r = uv_sem_trywait(parent->second->async_lock.get());
     if (r == 0) { return parent->second->async_lock; }
+    if (VSINode::mustNotBlock()) throw vsinodeDeadlock;
     uv_cond_wait(&master_sleep, &master_lock);
   }
 }
@@ -151,6 +158,7 @@ vector<AsyncLock> ObjectStore::lockDatasets(vector<long> uids) {
       vector<AsyncLock> locks = _tryLockDatasets(uids);
       if (locks.size() > 0) { return locks; }
     } catch (const char *msg) { throw msg; }
+    if (VSINode::mustNotBlock()) throw vsinodeDeadlock;
     uv_cond_wait(&master_sleep, &master_lock);
   }
 }
@@ -213,11 +221,12 @@ vector<AsyncLock> ObjectStore::tryLockDatasets(vector<long> uids) {
 // This is a Weak Persistent and Nan::ObjectWrap will call the C++ destructor
 // when the GC calls the Weak Callback which will trigger the dispose functions below
 
-template <typename GDALPTR> ObjectStoreItem<GDALPTR>::ObjectStoreItem(Nan::Persistent<Object> &obj) : obj(obj) {
+template <typename GDALPTR>
+ObjectStoreItem<GDALPTR>::ObjectStoreItem(Nan::Persistent<Object> &obj) : obj(obj), size(0) {
 }
-ObjectStoreItem<GDALDataset *>::ObjectStoreItem(Nan::Persistent<Object> &obj) : obj(obj) {
+ObjectStoreItem<GDALDataset *>::ObjectStoreItem(Nan::Persistent<Object> &obj) : obj(obj), size(0) {
 }
-ObjectStoreItem<OGRLayer *>::ObjectStoreItem(Nan::Persistent<Object> &obj) : obj(obj) {
+ObjectStoreItem<OGRLayer *>::ObjectStoreItem(Nan::Persistent<Object> &obj) : obj(obj), size(0) {
 }
 
 template <typename GDALPTR> long ObjectStore::add(GDALPTR ptr, Nan::Persistent<Object> &obj, long parent_uid) {
@@ -331,6 +340,7 @@ template <> void ObjectStore::dispose(shared_ptr<ObjectStoreItem<GDALDataset *>>
   uidMap<GDALDataset *>.erase(item->uid);
   ptrMap<GDALDataset *>.erase(item->ptr);
   if (item->parent != nullptr) item->parent->children.remove(item->uid);
+  released += item->size;
 
   uv_sem_post(item->async_lock.get());
   uv_cond_broadcast(&master_sleep);
@@ -358,6 +368,7 @@ template <> void ObjectStore::dispose(shared_ptr<ObjectStoreItem<OGRLayer *>> it
   ptrMap<OGRLayer *>.erase(item->ptr);
   uidMap<OGRLayer *>.erase(item->uid);
   if (item->parent != nullptr) { item->parent->children.remove(item->uid); }
+  released += item->size;
   if (item->is_result_set) {
     LOG("Closing OGRLayer with SQL results [%ld] [%p]", uid, ptr);
     if (item->parent) {
@@ -370,20 +381,147 @@ template <> void ObjectStore::dispose(shared_ptr<ObjectStoreItem<OGRLayer *>> it
   }
 }
 
+// Remove an SQL results layer from the store without releasing it
+// Called from the main thread, the caller becomes responsible for calling
+// ReleaseResultSet() with the parent Dataset locked - this allows to release
+// a result set from an aux thread without ever waiting in the GC
+bool ObjectStore::detachResultSet(long uid) {
+  LOG("ObjectStore: Detach result set [%ld]", uid);
+  {
+    uv_scoped_mutex lock(&master_lock);
+    if (!uidMap<OGRLayer *>.count(uid)) return false;
+    shared_ptr<ObjectStoreItem<OGRLayer *>> item = uidMap<OGRLayer *>[uid];
+    if (!item->is_result_set) return false;
+    ptrMap<OGRLayer *>.erase(item->ptr);
+    uidMap<OGRLayer *>.erase(item->uid);
+    if (item->parent != nullptr) { item->parent->children.remove(item->uid); }
+    released += item->size;
+  }
+  reportReleased();
+  return true;
+}
+
+// Remove a Dataset and its children from the store without closing it
+// Called from the main thread, the caller becomes responsible for closing it
+// and releasing its SQL results layers with its lock held - this allows
+// to close a Dataset from an aux thread without waiting for its running operations
+// The child Datasets are detached in the same way and come before their parents in the list
+bool ObjectStore::detachDataset(long uid, vector<DetachedDataset> &detached) {
+  LOG("ObjectStore: Detach Dataset [%ld]", uid);
+  {
+    uv_scoped_mutex lock(&master_lock);
+    if (!uidMap<GDALDataset *>.count(uid)) return false;
+    do_detach(uidMap<GDALDataset *>[uid], detached);
+    // The operations waiting for these Datasets will fail
+    uv_cond_broadcast(&master_sleep);
+  }
+  reportReleased();
+  return true;
+}
+
+// Called with the master lock held
+void ObjectStore::do_detach(shared_ptr<ObjectStoreItem<GDALDataset *>> item, vector<DetachedDataset> &detached) {
+  uidMap<GDALDataset *>.erase(item->uid);
+  ptrMap<GDALDataset *>.erase(item->ptr);
+  if (item->parent != nullptr) item->parent->children.remove(item->uid);
+  released += item->size;
+
+  vector<OGRLayer *> result_sets;
+  while (!item->children.empty()) {
+    long child = item->children.back();
+    if (uidMap<GDALDataset *>.count(child)) {
+      // Closing a child Dataset can block, it is detached in turn
+      do_detach(uidMap<GDALDataset *>[child], detached);
+    } else if (uidMap<OGRLayer *>.count(child) && uidMap<OGRLayer *>[child]->is_result_set) {
+      shared_ptr<ObjectStoreItem<OGRLayer *>> layer = uidMap<OGRLayer *>[child];
+      result_sets.push_back(layer->ptr);
+      ptrMap<OGRLayer *>.erase(layer->ptr);
+      uidMap<OGRLayer *>.erase(child);
+      released += layer->size;
+    } else {
+      do_dispose(child);
+    }
+    item->children.remove(child);
+  }
+  detached.push_back({item->ptr, item->async_lock, result_sets});
+  item->ptr = nullptr;
+}
+
 // Generic disposal (called with the master lock held)
 template <typename GDALPTR> void ObjectStore::dispose(shared_ptr<ObjectStoreItem<GDALPTR>> item) {
   ptrMap<GDALPTR>.erase(item->ptr);
   uidMap<GDALPTR>.erase(item->uid);
   if (item->parent != nullptr) { item->parent->children.remove(item->uid); }
+  released += item->size;
 }
 
 // Called from the C++ destructor
 void ObjectStore::dispose(long uid) {
   LOG("ObjectStore: Dispose [%ld]", uid);
+  {
+    uv_scoped_mutex lock(&master_lock);
+    do_dispose(uid);
+  }
+  reportReleased();
+}
+
+void adjustExternalMemory(int64_t delta) {
+  while (delta > INT_MAX) {
+    Nan::AdjustExternalMemory(INT_MAX);
+    delta -= INT_MAX;
+  }
+  while (delta < -INT_MAX) {
+    Nan::AdjustExternalMemory(-INT_MAX);
+    delta += INT_MAX;
+  }
+  if (delta != 0) Nan::AdjustExternalMemory(static_cast<int>(delta));
+}
+
+// V8 is never called with the master lock held as it can run the GC which can dispose objects
+void ObjectStore::reportReleased() {
+  int64_t size;
+  {
+    uv_scoped_mutex lock(&master_lock);
+    size = released;
+    released = 0;
+  }
+  adjustExternalMemory(-size);
+}
+
+/*
+ * Set the estimated native size of an object and report the difference to V8,
+ * the changes below NATIVE_SIZE_THRESHOLD are ignored to avoid calling V8 too often
+ */
+template <typename GDALPTR> void ObjectStore::setSize(long uid, int64_t size) {
+  int64_t delta;
+  {
+    uv_scoped_mutex lock(&master_lock);
+    auto item = uidMap<GDALPTR>.find(uid);
+    if (item == uidMap<GDALPTR>.end()) return;
+    delta = size - item->second->size;
+    if (item->second->size != 0 && delta > -NATIVE_SIZE_THRESHOLD && delta < NATIVE_SIZE_THRESHOLD) return;
+    item->second->size = size;
+  }
+  adjustExternalMemory(delta);
+}
+
+// Count the live objects of a type and their estimated native size
+template <typename GDALPTR> void ObjectStore::usage(size_t &objects, int64_t &bytes) {
   uv_scoped_mutex lock(&master_lock);
-  do_dispose(uid);
+  objects = uidMap<GDALPTR>.size();
+  bytes = 0;
+  for (auto const &item : uidMap<GDALPTR>) bytes += item.second->size;
 }
 
+template void ObjectStore::setSize<GDALDataset *>(long, int64_t);
+template void ObjectStore::setSize<OGRLayer *>(long, int64_t);
+template void ObjectStore::usage<GDALDataset *>(size_t &, int64_t &);
+template void ObjectStore::usage<OGRLayer *>(size_t &, int64_t &);
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
+template void ObjectStore::setSize<shared_ptr<GDALMDArray>>(long, int64_t);
+template void ObjectStore::usage<shared_ptr<GDALMDArray>>(size_t &, int64_t &);
+#endif
+
 // The locked section of the above function
 void ObjectStore::do_dispose(long uid) {
   if (uidMap<GDALDataset *>.count(uid))
@@ -24,11 +24,19 @@ namespace node_gdal {
 
 typedef shared_ptr<uv_sem_t> AsyncLock;
 
+// Changes of the estimated native size smaller than this are not reported to V8
+#define NATIVE_SIZE_THRESHOLD 4096
+
+// Nan::AdjustExternalMemory() accepts only an int, larger changes are reported in chunks
+void adjustExternalMemory(int64_t delta);
+
 template <typename GDALPTR> struct ObjectStoreItem {
   long uid;
   Nan::Persistent<v8::Object> &obj;
   GDALPTR ptr;
   shared_ptr<ObjectStoreItem<GDALDataset *>> parent;
+  // Estimated native size reported to V8, accessed only by the main thread
+  int64_t size;
   ObjectStoreItem(Nan::Persistent<Object> &obj);
 };
 
@@ -38,6 +46,7 @@ template <> struct ObjectStoreItem<OGRLayer *> {
   OGRLayer *ptr;
   shared_ptr<ObjectStoreItem<GDALDataset *>> parent;
   bool is_result_set;
+  int64_t size;
   ObjectStoreItem(Nan::Persistent<Object> &obj);
 };
 
@@ -48,9 +57,18 @@ template <> struct ObjectStoreItem<GDALDataset *> {
   shared_ptr<ObjectStoreItem<GDALDataset *>> parent;
   list<long> children;
   AsyncLock async_lock;
+  int64_t size;
   ObjectStoreItem(Nan::Persistent<Object> &obj);
 };
 
+// A Dataset removed from the store by detachDataset(), the caller becomes responsible
+// for releasing its result sets and closing it with its async_lock held
+struct DetachedDataset {
+  GDALDataset *ptr;
+  AsyncLock async_lock;
+  vector<OGRLayer *> result_sets;
+};
+
 struct uv_sem_deleter {
   void operator()(uv_sem_t *p);
 };
@@ -62,6 +80,8 @@ class ObjectStore {
   long add(GDALDataset *ptr, Nan::Persistent<Object> &obj, long parent_uid);
 
   void dispose(long uid);
+  bool detachResultSet(long uid);
+  bool detachDataset(long uid, vector<DetachedDataset> &detached);
   bool isAlive(long uid);
   inline void lockDataset(AsyncLock lock) {
     uv_sem_wait(lock.get());
@@ -79,10 +99,20 @@ class ObjectStore {
     uv_mutex_unlock(&master_lock);
   }
   AsyncLock lockDataset(long uid);
+  // Wake up the threads waiting for a Dataset so that they check again if they can wait
+  inline void wakeUp() {
+    uv_mutex_lock(&master_lock);
+    uv_cond_broadcast(&master_sleep);
+    uv_mutex_unlock(&master_lock);
+  }
   vector<AsyncLock> lockDatasets(vector<long> uids);
   AsyncLock tryLockDataset(long uid);
   vector<AsyncLock> tryLockDatasets(vector<long> uids);
 
+  // Native memory accounting, main thread only
+  template <typename GDALPTR> void setSize(long uid, int64_t size);
+  template <typename GDALPTR> void usage(size_t &objects, int64_t &bytes);
+
   template <typename GDALPTR> bool has(GDALPTR ptr);
   template <typename GDALPTR> Local<Object> get(GDALPTR ptr);
   template <typename GDALPTR> Local<Object> get(long uid);
@@ -94,8 +124,12 @@ class ObjectStore {
   long uid;
   uv_mutex_t master_lock;
   uv_cond_t master_sleep;
+  // Size of the items disposed with the master lock held, reported once it is released
+  int64_t released;
+  void reportReleased();
   vector<AsyncLock> _tryLockDatasets(vector<long> uids);
   template <typename GDALPTR> void dispose(shared_ptr<ObjectStoreItem<GDALPTR>> item);
+  void do_detach(shared_ptr<ObjectStoreItem<GDALDataset *>> item, vector<DetachedDataset> &detached);
   void do_dispose(long uid);
 };
 
@@ -0,0 +1,131 @@
+#include "strtree.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+namespace node_gdal {
+
+STRtree::STRtree(uint32_t capacity) : capacity(capacity < 2 ? 2 : capacity), levels() {
+}
+
+static inline double centerX(const OGREnvelope &env) {
+  return (env.MinX + env.MaxX) / 2;
+}
+
+static inline double centerY(const OGREnvelope &env) {
+  return (env.MinY + env.MaxY) / 2;
+}
+
+// Orders the entries in vertical slices sorted by X, each slice sorted by Y
+// so that every group of capacity consecutive entries forms a compact node
+void STRtree::sort(std::vector<Entry> &entries) const {
+  size_t nodes = (entries.size() + capacity - 1) / capacity;
+  size_t slices = (size_t)std::ceil(std::sqrt((double)nodes));
+  size_t slice_size = slices * capacity;
+
+  std::sort(
+    entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return centerX(a.env) < centerX(b.env); });
+  for (size_t start = 0; start < entries.size(); start += slice_size) {
+    auto end = entries.begin() + std::min(entries.size(), start + slice_size);
+    std::sort(entries.begin() + start, end, [](const Entry &a, const Entry &b) {
+      return centerY(a.env) < centerY(b.env);
+    });
+  }
+}
+
+void STRtree::build(const std::vector<OGREnvelope> &envs) {
+  levels.clear();
+  if (envs.empty()) return;
+
+  std::vector<Entry> level(envs.size());
+  for (size_t i = 0; i < envs.size(); i++) level[i] = {envs[i], (uint32_t)i};
+
+  while (true) {
+    sort(level);
+    levels.push_back(level);
+    if (level.size() <= capacity) break;
+
+    std::vector<Entry> parents;
+    parents.reserve((level.size() + capacity - 1) / capacity);
+    for (size_t first = 0; first < level.size(); first += capacity) {
+      Entry parent = {level[first].env, (uint32_t)first};
+      size_t end = std::min(level.size(), first + capacity);
+      for (size_t i = first + 1; i < end; i++) parent.env.Merge(level[i].env);
+      parents.push_back(parent);
+    }
+    level = std::move(parents);
+  }
+}
+
+void STRtree::query(const OGREnvelope &env, const std::function<void(uint32_t)> &visit) const {
+  if (levels.empty()) return;
+
+  // (level, index)
+  std::vector<std::pair<size_t, size_t>> stack;
+  size_t top = levels.size() - 1;
+  for (size_t i = 0; i < levels[top].size(); i++)
+    if (levels[top][i].env.Intersects(env)) stack.push_back({top, i});
+
+  while (!stack.empty()) {
+    auto node = stack.back();
+    stack.pop_back();
+    const Entry &entry = levels[node.first][node.second];
+    if (node.first == 0) {
+      visit(entry.ref);
+      continue;
+    }
+    size_t end = childrenEnd(node.first, entry.ref);
+    for (size_t i = entry.ref; i < end; i++)
+      if (levels[node.first - 1][i].env.Intersects(env)) stack.push_back({node.first - 1, i});
+  }
+}
+
+double STRtree::envDistance(const OGREnvelope &a, const OGREnvelope &b) {
+  double dx = std::max(0.0, std::max(a.MinX - b.MaxX, b.MinX - a.MaxX));
+  double dy = std::max(0.0, std::max(a.MinY - b.MaxY, b.MinY - a.MaxY));
+  return std::sqrt(dx * dx + dy * dy);
+}
+
+// Best-first search, the leaves are pushed back once with their exact distance
+// which is always greater or equal to the envelope distance
+std::vector<uint32_t>
+STRtree::nearest(const OGREnvelope &env, size_t k, const std::function<double(uint32_t)> &distance) const {
+  std::vector<uint32_t> r;
+  if (levels.empty() || k == 0) return r;
+
+  struct Candidate {
+    double dist;
+    size_t level;
+    size_t index;
+    bool exact;
+    bool operator<(const Candidate &other) const {
+      return dist > other.dist;
+    }
+  };
+  std::priority_queue<Candidate> queue;
+
+  size_t top = levels.size() - 1;
+  for (size_t i = 0; i < levels[top].size(); i++)
+    queue.push({envDistance(levels[top][i].env, env), top, i, false});
+
+  while (!queue.empty() && r.size() < k) {
+    Candidate c = queue.top();
+    queue.pop();
+    const Entry &entry = levels[c.level][c.index];
+    if (c.level == 0) {
+      if (c.exact)
+        r.push_back(entry.ref);
+      else
+        queue.push({distance(entry.ref), 0, c.index, true});
+      continue;
+    }
+    size_t end = childrenEnd(c.level, entry.ref);
+    for (size_t i = entry.ref; i < end; i++)
+      queue.push({envDistance(levels[c.level - 1][i].env, env), c.level - 1, i, false});
+  }
+
+  return r;
+}
+
+} // namespace node_gdal
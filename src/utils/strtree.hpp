@@ -0,0 +1,56 @@
+#ifndef __NODE_GDAL_STRTREE_H__
+#define __NODE_GDAL_STRTREE_H__
+
+// ogr
+#include <ogr_core.h>
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+namespace node_gdal {
+
+// A packed (static) R-tree built with the Sort-Tile-Recursive algorithm
+// https://apps.dtic.mil/sti/pdfs/ADA324493.pdf
+//
+// Every level is stored as a flat array of envelopes, the children
+// of a node are contiguous in the level below it
+class STRtree {
+    public:
+  STRtree(uint32_t capacity = 16);
+
+  // Items are identified by their position in envs
+  void build(const std::vector<OGREnvelope> &envs);
+
+  // Calls visit for every item whose envelope intersects env
+  void query(const OGREnvelope &env, const std::function<void(uint32_t)> &visit) const;
+
+  // Returns up to k items ordered by distance
+  // distance must never be smaller than the distance between the envelopes
+  std::vector<uint32_t> nearest(
+    const OGREnvelope &env, size_t k, const std::function<double(uint32_t)> &distance) const;
+
+  inline size_t size() const {
+    return levels.empty() ? 0 : levels[0].size();
+  }
+
+  static double envDistance(const OGREnvelope &a, const OGREnvelope &b);
+
+    private:
+  struct Entry {
+    OGREnvelope env;
+    // item at the leaf level, first child otherwise
+    uint32_t ref;
+  };
+  void sort(std::vector<Entry> &entries) const;
+  inline size_t childrenEnd(size_t level, uint32_t first) const {
+    size_t end = (size_t)first + capacity;
+    return end < levels[level - 1].size() ? end : levels[level - 1].size();
+  }
+
+  uint32_t capacity;
+  std::vector<std::vector<Entry>> levels;
+};
+
+} // namespace node_gdal
+#endif
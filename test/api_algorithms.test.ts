@@ -2,6 +2,7 @@ import * as gdal from '..'
 import * as chai from 'chai'
 const assert = chai.assert
 import * as chaiAsPromised from 'chai-as-promised'
+import { square } from './utils/geometry.js'
 chai.use(chaiAsPromised)
 
 describe('gdal', () => {
@@ -431,4 +432,163 @@ describe('gdal', () => {
       assert.isAbove(calls, 0)
     })
   })
+
+  describe('rasterize()', () => {
+    let ds: gdal.Dataset, band: gdal.RasterBand, vector: gdal.Dataset, lyr: gdal.Layer
+
+    beforeEach(() => {
+      ds = gdal.open('temp', 'w', 'MEM', 64, 64, 1, gdal.GDT_Byte)
+      ds.geoTransform = [ 0, 1, 0, 0, 0, 1 ]
+      band = ds.bands.get(1)
+      vector = gdal.open('temp', 'w', 'Memory')
+      lyr = vector.layers.create('temp', null, gdal.Polygon)
+      lyr.fields.add(new gdal.FieldDefn('val', gdal.OFTInteger))
+      for (const [ x, val ] of [ [ 8, 5 ], [ 40, 7 ] ]) {
+        const feature = new gdal.Feature(lyr)
+        feature.fields.set('val', val)
+        feature.setGeometry(square(x, 8, 16))
+        lyr.features.add(feature)
+      }
+    })
+    afterEach(() => {
+      ds.close()
+      vector.close()
+    })
+    it('should burn an array of geometries', () => {
+      gdal.rasterize({ src: [ square(8, 8, 16), square(40, 40, 16) ], dst: band, burnValues: 1 })
+      assert.equal(band.pixels.get(10, 10), 1)
+      assert.equal(band.pixels.get(50, 50), 1)
+      assert.equal(band.pixels.get(30, 30), 0)
+    })
+    it('should burn one value per geometry', () => {
+      gdal.rasterize({ src: [ square(8, 8, 16), square(40, 40, 16) ], dst: band, burnValues: [ 3, 4 ] })
+      assert.equal(band.pixels.get(10, 10), 3)
+      assert.equal(band.pixels.get(50, 50), 4)
+    })
+    it('should burn the values of an attribute of a layer', () => {
+      gdal.rasterize({ src: lyr, dst: band, attribute: 'val' })
+      assert.equal(band.pixels.get(10, 10), 5)
+      assert.equal(band.pixels.get(42, 10), 7)
+      assert.equal(band.pixels.get(30, 10), 0)
+    })
+    it('should support "mergeAlg" and "allTouched"', () => {
+      const geom = gdal.Geometry.fromWKT('POLYGON((8.6 8.6,8.9 8.6,8.9 8.9,8.6 8.9,8.6 8.6))')
+      gdal.rasterize({ src: [ geom ], dst: band, burnValues: 1 })
+      assert.equal(band.pixels.get(8, 8), 0)
+      gdal.rasterize({ src: [ geom ], dst: band, burnValues: 2, allTouched: true, mergeAlg: 'add' })
+      gdal.rasterize({ src: [ geom ], dst: band, burnValues: 2, allTouched: true, mergeAlg: 'add' })
+      assert.equal(band.pixels.get(8, 8), 4)
+    })
+    it('should accept a "progress_cb"', () => {
+      let calls = 0
+      gdal.rasterize({
+        src: lyr,
+        dst: band,
+        burnValues: 1,
+        progress_cb: () => {
+          calls++
+        }
+      })
+      assert.isAbove(calls, 0)
+    })
+    it('should throw on invalid options', () => {
+      assert.throws(() => gdal.rasterize({ src: lyr, dst: band }), /burnValues or attribute/)
+      assert.throws(() => gdal.rasterize({ src: [ square(0, 0, 1) ], dst: band, attribute: 'val' }), /requires a Layer/)
+      assert.throws(() => gdal.rasterize({ src: [ square(0, 0, 1) ], dst: band, burnValues: [ 1, 2 ] }), /one value/)
+      assert.throws(() => gdal.rasterize({ src: lyr, dst: band, burnValues: 1, mergeAlg: 'max' }), /mergeAlg/)
+    })
+  })
+
+  describe('rasterizeAsync()', () => {
+    it('should burn the geometries of a layer', () => {
+      const ds = gdal.open('temp', 'w', 'MEM', 64, 64, 1, gdal.GDT_Byte)
+      ds.geoTransform = [ 0, 1, 0, 0, 0, 1 ]
+      const vector = gdal.open('temp', 'w', 'Memory')
+      const lyr = vector.layers.create('temp', null, gdal.Polygon)
+      const feature = new gdal.Feature(lyr)
+      feature.setGeometry(gdal.Geometry.fromWKT('POLYGON((8 8,24 8,24 24,8 24,8 8))'))
+      lyr.features.add(feature)
+
+      const band = ds.bands.get(1)
+      return assert.isFulfilled(gdal.rasterizeAsync({ src: lyr, dst: band, burnValues: 9 }).then(() => {
+        assert.equal(band.pixels.get(10, 10), 9)
+        assert.equal(band.pixels.get(30, 30), 0)
+        ds.close()
+        vector.close()
+      }))
+    })
+    it('should reject on invalid options', () => {
+      const ds = gdal.open('temp', 'w', 'MEM', 4, 4, 1)
+      return assert.isRejected(gdal.rasterizeAsync({ src: [], dst: ds.bands.get(1) }), /burnValues or attribute/)
+    })
+  })
+
+  describe('spatialJoin()', () => {
+    let ds: gdal.Dataset, districts: gdal.Layer, incidents: gdal.Layer
+
+    // two districts and three incidents, the last one outside of both
+    before(() => {
+      ds = gdal.open('join', 'w', 'Memory')
+      districts = ds.layers.create('districts', null, gdal.Polygon)
+      districts.fields.add(new gdal.FieldDefn('district', gdal.OFTString))
+      incidents = ds.layers.create('incidents', null, gdal.Point)
+      incidents.fields.add(new gdal.FieldDefn('kind', gdal.OFTString))
+      const add = (layer: gdal.Layer, wkt: string, field: string, value: string) => {
+        const f = new gdal.Feature(layer)
+        f.setGeometry(gdal.Geometry.fromWKT(wkt))
+        f.fields.set(field, value)
+        layer.features.add(f)
+      }
+      add(districts, 'POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))', 'district', 'north')
+      add(districts, 'POLYGON ((10 0, 20 0, 20 10, 10 10, 10 0))', 'district', 'south')
+      add(incidents, 'POINT (5 5)', 'kind', 'fire')
+      add(incidents, 'POINT (15 5)', 'kind', 'flood')
+      add(incidents, 'POINT (25 5)', 'kind', 'fire')
+    })
+
+    it('should return the matching pairs of FIDs', () => {
+      const pairs = gdal.spatialJoin(incidents, districts, { predicate: 'within', threads: 2 }) as gdal.SpatialJoinResult
+      assert.instanceOf(pairs.left, Float64Array)
+      assert.deepEqual(Array.from(pairs.left), [ 0, 1 ])
+      assert.deepEqual(Array.from(pairs.right), [ 0, 1 ])
+    })
+    it('should support indexing the left layer', () => {
+      const pairs = gdal.spatialJoin(districts, incidents, { predicate: 'contains' }) as gdal.SpatialJoinResult
+      assert.deepEqual(Array.from(pairs.left), [ 0, 1 ])
+      assert.deepEqual(Array.from(pairs.right), [ 0, 1 ])
+    })
+    it('should write the joined features to the output layer', () => {
+      const output = ds.layers.create('output', null, gdal.Point)
+      gdal.spatialJoin(incidents, districts, { predicate: 'intersects', output, fields: [ 'district' ] })
+      assert.equal(output.features.count(), 2)
+      const f = output.features.get(0)
+      assert.deepEqual(f.fields.toObject(), { kind: 'fire', district: 'north' })
+      assert.equal((f.getGeometry() as gdal.Point).x, 5)
+    })
+    it('should throw on invalid predicates', () => {
+      assert.throws(() => {
+        gdal.spatialJoin(incidents, districts, { predicate: 'near' })
+      }, /predicate must be one of/)
+    })
+    it('should throw if the output is one of the input layers', () => {
+      assert.throws(() => {
+        gdal.spatialJoin(incidents, districts, { output: incidents })
+      }, /output must be different/)
+    })
+    it('should be interrupted when the progress callback returns false', () => {
+      assert.throws(() => {
+        gdal.spatialJoin(incidents, districts, { progress_cb: () => false })
+      }, /terminated/)
+    })
+  })
+
+  describe('spatialJoinAsync()', () => {
+    it('should return the matching pairs of FIDs', () => {
+      const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+      const layer = ds.layers.get(0)
+      const pairs = gdal.spatialJoinAsync(layer, layer, { predicate: 'intersects' }) as Promise<gdal.SpatialJoinResult>
+      // every feature intersects at least itself
+      return assert.eventually.isAtLeast(pairs.then((p) => p.left.length), layer.features.count())
+    })
+  })
 })
@@ -0,0 +1,115 @@
+import * as gdal from '..'
+import * as path from 'path'
+import * as chai from 'chai'
+import * as chaiAsPromised from 'chai-as-promised'
+const assert = chai.assert
+chai.use(chaiAsPromised)
+
+describe('gdal.cache', () => {
+  afterEach(global.gc)
+
+  const sample = path.join(__dirname, 'data', 'sample.tif')
+  let max: number
+
+  before(() => {
+    max = gdal.cache.getMax()
+  })
+  after(() => {
+    gdal.cache.setMax(max)
+  })
+
+  it('should set and get the maximum size', () => {
+    gdal.cache.setMax(64 * 1024 * 1024)
+    assert.equal(gdal.cache.getMax(), 64 * 1024 * 1024)
+    gdal.cache.setMax(max)
+    assert.equal(gdal.cache.getMax(), max)
+  })
+
+  it('should throw on a negative size', () => {
+    assert.throws(() => gdal.cache.setMax(-1), /positive/)
+  })
+
+  it('should count the hits and the misses', () => {
+    const ds = gdal.open(sample)
+    const band = ds.bands.get(1)
+    ds.dropCache()
+    gdal.cache.resetStats()
+
+    band.pixels.read(0, 0, band.size.x, band.size.y)
+    const first = gdal.cache.stats()
+    assert.isAbove(first.misses, 0)
+    assert.equal(first.hits, 0)
+    assert.isAbove(first.used, 0)
+    assert.isAtMost(first.used, first.max)
+    assert.equal(gdal.cache.used(), first.used)
+
+    band.pixels.read(0, 0, band.size.x, band.size.y)
+    const second = gdal.cache.stats()
+    assert.equal(second.misses, first.misses)
+    assert.equal(second.hits, first.misses)
+
+    gdal.cache.resetStats()
+    assert.include(gdal.cache.stats(), { hits: 0, misses: 0 })
+    ds.close()
+  })
+
+  it('should not count the decimated reads', () => {
+    const ds = gdal.open(sample)
+    const band = ds.bands.get(1)
+    gdal.cache.resetStats()
+    band.pixels.read(0, 0, band.size.x, band.size.y, undefined, { buffer_width: 10, buffer_height: 10 })
+    assert.include(gdal.cache.stats(), { hits: 0, misses: 0 })
+    ds.close()
+  })
+
+  describe('gdal.Dataset.dropCache()', () => {
+    it('should release the blocks of the dataset', () => {
+      const ds = gdal.open(sample)
+      const band = ds.bands.get(1)
+      band.pixels.read(0, 0, band.size.x, band.size.y)
+      const used = gdal.cache.used()
+      ds.dropCache()
+      assert.isBelow(gdal.cache.used(), used)
+
+      gdal.cache.resetStats()
+      band.pixels.read(0, 0, band.size.x, band.size.y)
+      assert.equal(gdal.cache.stats().hits, 0)
+      ds.close()
+    })
+
+    it('should write the modified blocks', () => {
+      const file = `/vsimem/block_cache_${String(Math.random()).substring(2)}.tif`
+      const ds = gdal.open(file, 'w', 'GTiff', 16, 16, 1, gdal.GDT_Byte)
+      ds.bands.get(1).pixels.set(5, 5, 42)
+      ds.dropCache()
+      assert.equal(ds.bands.get(1).pixels.get(5, 5), 42)
+      ds.close()
+      gdal.vsimem.take(file)
+    })
+
+    it('should throw if the dataset is closed', () => {
+      const ds = gdal.open(sample)
+      ds.close()
+      assert.throws(() => ds.dropCache())
+    })
+  })
+
+  describe('gdal.Dataset.dropCacheAsync()', () => {
+    it('should release the blocks of the dataset', () => {
+      const ds = gdal.open(sample)
+      const band = ds.bands.get(1)
+      band.pixels.read(0, 0, band.size.x, band.size.y)
+      const used = gdal.cache.used()
+      return assert.isFulfilled(ds.dropCacheAsync().then(() => {
+        assert.isBelow(gdal.cache.used(), used)
+        ds.close()
+      }))
+    })
+
+    it('should reject if the dataset is closed', () => {
+      const ds = gdal.open(sample)
+      ds.close()
+      return assert.isRejected(ds.dropCacheAsync())
+    })
+  })
+})
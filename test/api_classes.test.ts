@@ -40,6 +40,7 @@ const create = {
   RasterBandOverviews: () => gdal.open('temp', 'w', 'MEM', 32, 32, 1, gdal.GDT_Byte).bands.get(1).overviews,
   RasterBandPixels: () => gdal.open('temp', 'w', 'MEM', 32, 32, 1, gdal.GDT_Byte).bands.get(1).pixels,
   SimpleCurve: () => new gdal.LineString(),
+  SpatialIndex: () => gdal.SpatialIndex.fromGeometries([ new gdal.Point(0, 0) ]),
   SpatialReference: []
 }
 
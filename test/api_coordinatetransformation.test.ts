@@ -1,5 +1,8 @@
 import * as gdal from '..'
-import { assert } from 'chai'
+import * as chai from 'chai'
+import * as chaiAsPromised from 'chai-as-promised'
+const assert = chai.assert
+chai.use(chaiAsPromised)
 
 describe('gdal.CoordinateTransformation', () => {
   afterEach(global.gc)
@@ -31,4 +34,108 @@ describe('gdal.CoordinateTransformation', () => {
     assert.closeTo(pt.x, 1564201.4044502454, 0.1)
     assert.closeTo(pt.y, 3370263.469590679, 0.1)
   })
+  describe('transformPoints()', () => {
+    const ct = new gdal.CoordinateTransformation(
+      gdal.SpatialReference.fromProj4('+init=epsg:4326'),
+      gdal.SpatialReference.fromProj4('+init=epsg:32632'))
+    const xs = () => new Float64Array([ 20, 9, 12 ])
+    const ys = () => new Float64Array([ 30, 45, 95 ])
+
+    it('should transform all the points', () => {
+      const r = ct.transformPoints(xs(), ys())
+      assert.instanceOf(r.xs, Float64Array)
+      assert.instanceOf(r.ys, Float64Array)
+      assert.isUndefined(r.zs)
+      assert.deepEqual(Array.from(r.success), [ 1, 1, 0 ])
+      for (let i = 0; i < 2; i++) {
+        const pt = ct.transformPoint(xs()[i], ys()[i])
+        assert.closeTo(r.xs[i], pt.x, 1e-6)
+        assert.closeTo(r.ys[i], pt.y, 1e-6)
+      }
+    })
+    it('should not modify the input unless inPlace is set', () => {
+      const x = xs(), y = ys()
+      const r = ct.transformPoints(x, y)
+      assert.deepEqual(Array.from(x), Array.from(xs()))
+      assert.notStrictEqual(r.xs, x)
+      const r2 = ct.transformPoints(x, y, null, { inPlace: true })
+      assert.strictEqual(r2.xs, x)
+      assert.strictEqual(r2.ys, y)
+      assert.closeTo(x[0], 1564201.4044502454, 0.1)
+    })
+    it('should transform the z coordinates', () => {
+      const r = ct.transformPoints(xs(), ys(), new Float64Array([ 1, 2, 3 ]))
+      assert.instanceOf(r.zs, Float64Array)
+      assert.closeTo(r.zs[0], 1, 1e-6)
+    })
+    it('should throw on arrays of different lengths', () => {
+      assert.throws(() => {
+        ct.transformPoints(xs(), new Float64Array(2))
+      }, /same length/)
+    })
+    it('should throw on regular arrays', () => {
+      assert.throws(() => {
+        ct.transformPoints([ 1 ] as unknown as Float64Array, [ 2 ] as unknown as Float64Array)
+      }, /Float64Array/)
+    })
+    it('should support multiple threads', () => {
+      const n = 200000
+      const x = new Float64Array(n).fill(20)
+      const y = new Float64Array(n).fill(30)
+      const r = ct.transformPoints(x, y, null, { threads: 4 })
+      assert.closeTo(r.xs[0], 1564201.4044502454, 0.1)
+      assert.closeTo(r.xs[n - 1], 1564201.4044502454, 0.1)
+      assert.equal(r.success.reduce((a, x) => a + x, 0), n)
+    })
+  })
+  describe('transformPointsAsync()', () => {
+    it('should transform all the points', () => {
+      const ct = new gdal.CoordinateTransformation(
+        gdal.SpatialReference.fromProj4('+init=epsg:4326'),
+        gdal.SpatialReference.fromProj4('+init=epsg:32632'))
+      const q = ct.transformPointsAsync(new Float64Array([ 20 ]), new Float64Array([ 30 ]))
+      return assert.isFulfilled(q.then((r) => {
+        assert.closeTo(r.xs[0], 1564201.4044502454, 0.1)
+        assert.closeTo(r.ys[0], 3370263.469590679, 0.1)
+        assert.deepEqual(Array.from(r.success), [ 1 ])
+      }))
+    })
+  })
+  describe('transformPointsInterleaved()', () => {
+    const ct = new gdal.CoordinateTransformation(
+      gdal.SpatialReference.fromProj4('+init=epsg:4326'),
+      gdal.SpatialReference.fromProj4('+init=epsg:32632'))
+
+    it('should transform all the points', () => {
+      const coords = new Float64Array([ 20, 30, 20, 30 ])
+      const r = ct.transformPointsInterleaved(coords)
+      assert.closeTo(r.coords[2], 1564201.4044502454, 0.1)
+      assert.closeTo(r.coords[3], 3370263.469590679, 0.1)
+      assert.deepEqual(Array.from(r.success), [ 1, 1 ])
+      assert.equal(coords[0], 20)
+    })
+    it('should leave m unchanged', () => {
+      const coords = new Float64Array([ 20, 30, 0, 42 ])
+      const r = ct.transformPointsInterleaved(coords, { dims: 'xyzm', inPlace: true })
+      assert.strictEqual(r.coords, coords)
+      assert.closeTo(coords[0], 1564201.4044502454, 0.1)
+      assert.equal(coords[3], 42)
+    })
+    it('should throw if the length is not a multiple of the dimensions', () => {
+      assert.throws(() => {
+        ct.transformPointsInterleaved(new Float64Array(4), { dims: 'xyz' })
+      }, /multiple/)
+    })
+  })
+  describe('transformPointsInterleavedAsync()', () => {
+    it('should transform all the points', () => {
+      const ct = new gdal.CoordinateTransformation(
+        gdal.SpatialReference.fromProj4('+init=epsg:4326'),
+        gdal.SpatialReference.fromProj4('+init=epsg:32632'))
+      const q = ct.transformPointsInterleavedAsync(new Float64Array([ 20, 30 ]))
+      return assert.isFulfilled(q.then((r) => {
+        assert.closeTo(r.coords[0], 1564201.4044502454, 0.1)
+      }))
+    })
+  })
 })
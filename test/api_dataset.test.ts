@@ -6,6 +6,7 @@ import * as fileUtils from './utils/file.js'
 import * as chai from 'chai'
 import * as chaiAsPromised from 'chai-as-promised'
 import * as semver from 'semver'
+import { Readable } from 'stream'
 chai.use(chaiAsPromised)
 
 const NAD83_WKT =
@@ -110,6 +111,59 @@ describe('gdal.Dataset', () => {
           return assert.isRejected(ds.bands.getAsync(1))
         })
       })
+      describe('adviseRead()', () => {
+        it('should accept a list of windows', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          ds.bands.adviseRead([
+            { x: 0, y: 0, width: 20, height: 20 },
+            { x: 20, y: 0, width: 20, height: 20, buffer_width: 10, buffer_height: 10, bands: [ 1 ] },
+            { x: 0, y: 20, width: 20, height: 20, type: gdal.GDT_Float64 }
+          ])
+        })
+        it('should accept a subset of the bands of a multi-band dataset', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 64, 64, 3, gdal.GDT_Byte)
+          assert.isUndefined(ds.bands.adviseRead([
+            { x: 0, y: 0, width: 64, height: 64 },
+            { x: 16, y: 16, width: 32, height: 32, bands: [ 1, 3 ] },
+            { x: 0, y: 32, width: 64, height: 32, bands: [ 2 ], type: gdal.GDT_Int16 }
+          ]))
+          assert.throws(() => {
+            ds.bands.adviseRead([ { x: 0, y: 0, width: 10, height: 10, bands: [ 1, 4 ] } ])
+          }, /Invalid band id/)
+        })
+        it('should throw if a window is out of bounds', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          assert.throws(() => {
+            ds.bands.adviseRead([ { x: 0, y: 0, width: ds.rasterSize.x, height: ds.rasterSize.y + 1 } ])
+          }, /outside of the raster/)
+        })
+        it('should throw if a band id is out of range', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          assert.throws(() => {
+            ds.bands.adviseRead([ { x: 0, y: 0, width: 10, height: 10, bands: [ 2 ] } ])
+          }, /Invalid band id/)
+        })
+        it('should throw for vector datasets', () => {
+          const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+          assert.throws(() => {
+            ds.bands.adviseRead([ { x: 0, y: 0, width: 10, height: 10 } ])
+          })
+        })
+      })
+      describe('adviseReadAsync()', () => {
+        it('should resolve for a list of windows', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          return assert.isFulfilled(ds.bands.adviseReadAsync([
+            { x: 0, y: 0, width: 20, height: 20 },
+            { x: 20, y: 20, width: 20, height: 20, bands: [ 1 ] }
+          ]))
+        })
+        it('should reject if dataset is closed', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          ds.close()
+          return assert.isRejected(ds.bands.adviseReadAsync([ { x: 0, y: 0, width: 10, height: 10 } ]))
+        })
+      })
       describe('forEach()', () => {
         it('should call callback for each RasterBand', () => {
           const ds = gdal.open(`${__dirname}/data/sample.tif`)
@@ -834,6 +888,69 @@ describe('gdal.Dataset', () => {
         return assert.isRejected(ds.executeSQLAsync('SELECT name FROM sample'))
       })
     })
+    describe('releaseResultSet()', () => {
+      it('should release the result set', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const result_set = ds.executeSQL('SELECT name FROM sample')
+        ds.releaseResultSet(result_set)
+        assert.throws(() => {
+          result_set.fields.getNames()
+        }, /already been destroyed/)
+      })
+      it('should throw if the layer is not a result set', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        assert.throws(() => {
+          ds.releaseResultSet(ds.layers.get(0))
+        }, /not an SQL result set/)
+      })
+    })
+    describe('releaseResultSetAsync()', () => {
+      it('should release the result set', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const result_set = ds.executeSQL('SELECT name FROM sample')
+        return assert.isFulfilled(ds.releaseResultSetAsync(result_set).then(() => {
+          assert.throws(() => {
+            result_set.fields.getNames()
+          }, /already been destroyed/)
+        }))
+      })
+    })
+    describe('executeSQLStream()', () => {
+      it('should stream all the features', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const stream = ds.executeSQLStream('SELECT name FROM sample', { batchSize: 5 })
+        let count = 0
+        return assert.isFulfilled(new Promise<void>((resolve, reject) => {
+          stream.on('data', (feature) => {
+            assert.instanceOf(feature, gdal.Feature)
+            assert.isString(feature.fields.get('name'))
+            count++
+          })
+          stream.on('error', reject)
+          stream.on('close', () => {
+            assert.equal(count, 23)
+            resolve()
+          })
+        }))
+      })
+      it('should release the result set when destroyed', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const stream = ds.executeSQLStream('SELECT name FROM sample', { batchSize: 5 }) as unknown as Readable
+        return assert.isFulfilled(new Promise<void>((resolve) => {
+          stream.once('data', () => stream.destroy())
+          stream.on('close', () => resolve())
+        }))
+      })
+      it('should emit an error if the statement is invalid', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const stream = ds.executeSQLStream('SELECT invalid FROM sample')
+        return assert.isRejected(new Promise((resolve, reject) => {
+          stream.on('error', reject)
+          stream.on('end', resolve)
+          stream.resume()
+        }))
+      })
+    })
     describe('getFileList()', () => {
       it('should return list of filenames', () => {
         const ds = gdal.open(path.join(__dirname, 'data', 'sample.vrt'))
@@ -875,6 +992,79 @@ describe('gdal.Dataset', () => {
         return assert.isRejected(ds.flushAsync())
       })
     })
+    describe('closeAsync()', () => {
+      it('should make the dataset unusable immediately', () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        const band = ds.bands.get(1)
+        const p = ds.closeAsync()
+        assert.throws(() => ds.bands.count(), /already been destroyed/)
+        assert.throws(() => band.pixels.get(0, 0), /already been destroyed/)
+        return assert.isFulfilled(p)
+      })
+      it('should write the data before closing', () => {
+        const file = `/vsimem/close_async_${String(Math.random()).substring(2)}.tif`
+        const ds = gdal.open(file, 'w', 'GTiff', 16, 16, 1, gdal.GDT_Byte)
+        ds.bands.get(1).fill(42)
+        return assert.isFulfilled(ds.closeAsync().then(() => {
+          const ds2 = gdal.open(file)
+          assert.equal(ds2.bands.get(1).pixels.get(8, 8), 42)
+          ds2.close()
+          gdal.vsimem.take(file)
+        }))
+      })
+      it('should release the SQL results layers', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const layer = ds.executeSQL('SELECT * FROM sample')
+        return assert.isFulfilled(ds.closeAsync().then(() => {
+          assert.throws(() => layer.features.count())
+        }))
+      })
+      it('should wait for the running operations', () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        const band = ds.bands.get(1)
+        const read = band.pixels.readAsync(0, 0, 10, 10).then(() => true, () => true)
+        return assert.isFulfilled(Promise.all([ read, ds.closeAsync() ]))
+      })
+      it('should reject if dataset already closed', () => {
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        ds.close()
+        return assert.isRejected(ds.closeAsync(), /already been destroyed/)
+      })
+    })
+    describe('Symbol.dispose', () => {
+      // Explicit resource management is unknown to the TypeScript version used by the project
+      /* eslint-disable-next-line @typescript-eslint/no-explicit-any */
+      const symbols = Symbol as any
+      it('should close the dataset', function () {
+        if (!symbols.dispose) this.skip()
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        ds[symbols.dispose]()
+        assert.throws(() => ds.bands.count())
+      })
+      it('should do nothing if the dataset is already closed', function () {
+        if (!symbols.dispose) this.skip()
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        ds.close()
+        ds[symbols.dispose]()
+      })
+    })
+    describe('Symbol.asyncDispose', () => {
+      /* eslint-disable-next-line @typescript-eslint/no-explicit-any */
+      const symbols = Symbol as any
+      it('should close the dataset', function () {
+        if (!symbols.asyncDispose) this.skip()
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        return assert.isFulfilled(ds[symbols.asyncDispose]().then(() => {
+          assert.throws(() => ds.bands.count())
+        }))
+      })
+      it('should do nothing if the dataset is already closed', function () {
+        if (!symbols.asyncDispose) this.skip()
+        const ds = gdal.open(`${__dirname}/data/sample.tif`)
+        ds.close()
+        return assert.isFulfilled(ds[symbols.asyncDispose]())
+      })
+    })
     describe('getMetadata()', () => {
       it('should return object', () => {
         const ds = gdal.open(`${__dirname}/data/sample.tif`)
@@ -0,0 +1,87 @@
+import * as gdal from '..'
+import * as path from 'path'
+import * as chai from 'chai'
+import * as chaiAsPromised from 'chai-as-promised'
+const assert = chai.assert
+chai.use(chaiAsPromised)
+
+describe('gdal.openCached()', () => {
+  afterEach(global.gc)
+
+  const sample = path.join(__dirname, 'data', 'sample.tif')
+  const park = path.join(__dirname, 'data', 'park.geo.json')
+
+  beforeEach(() => {
+    gdal.datasetCache.clear()
+  })
+  after(() => {
+    gdal.datasetCache.clear()
+    gdal.openCached(sample, 'r', { maxOpen: 64, ttl: 0 })
+    gdal.datasetCache.clear()
+  })
+
+  it('should return the same Dataset for the same path and mode', () => {
+    const before = gdal.datasetCache.stats()
+    const ds1 = gdal.openCached(sample)
+    const ds2 = gdal.openCached(sample, 'r')
+    assert.instanceOf(ds1, gdal.Dataset)
+    assert.strictEqual(ds1, ds2)
+    const stats = gdal.datasetCache.stats()
+    assert.equal(stats.hits - before.hits, 1)
+    assert.equal(stats.misses - before.misses, 1)
+    assert.equal(stats.size, 1)
+  })
+
+  it('should work asynchronously', async () => {
+    const ds1 = await gdal.openCachedAsync(sample)
+    const ds2 = await gdal.openCachedAsync(sample)
+    assert.strictEqual(ds1, ds2)
+    assert.deepEqual(ds1.rasterSize, gdal.open(sample).rasterSize)
+  })
+
+  it('should release the least recently used datasets', () => {
+    const before = gdal.datasetCache.stats()
+    const ds1 = gdal.openCached(sample, 'r', { maxOpen: 1 })
+    const ds2 = gdal.openCached(park)
+    assert.notStrictEqual(ds1, ds2)
+    assert.equal(ds2.layers.count(), 1)
+    const stats = gdal.datasetCache.stats()
+    assert.equal(stats.evictions - before.evictions, 1)
+    assert.equal(stats.size, 1)
+    assert.equal(stats.maxOpen, 1)
+    // still open for its holders, but not cached anymore
+    assert.deepEqual(ds1.rasterSize, gdal.open(sample).rasterSize)
+    assert.notStrictEqual(gdal.openCached(sample), ds1)
+  })
+
+  it('should not close an evicted dataset used by an async operation', async () => {
+    const ds1 = gdal.openCached(sample, 'r', { maxOpen: 1 })
+    const band = ds1.bands.get(1)
+    const read = band.pixels.readAsync(0, 0, 64, 64)
+    gdal.openCached(park)
+    const data = await read
+    assert.equal(data.length, 64 * 64)
+    assert.equal(band.pixels.get(0, 0), data[0])
+  })
+
+  it('should expire the datasets after ttl', async () => {
+    const ds1 = gdal.openCached(sample, 'r', { maxOpen: 64, ttl: 10 })
+    await new Promise((resolve) => setTimeout(resolve, 50))
+    const ds2 = gdal.openCached(sample, 'r', { ttl: 0 })
+    assert.notStrictEqual(ds1, ds2)
+  })
+
+  it('should reopen a dataset closed by the user', () => {
+    const ds1 = gdal.openCached(sample)
+    ds1.close()
+    const ds2 = gdal.openCached(sample)
+    assert.notStrictEqual(ds1, ds2)
+    assert.instanceOf(ds2, gdal.Dataset)
+  })
+
+  it('should throw on invalid arguments', () => {
+    assert.throws(() => gdal.openCached(sample, 'w'), /mode/)
+    assert.throws(() => gdal.openCached(sample, 'r', { maxOpen: 0 }), /maxOpen/)
+    assert.throws(() => gdal.openCached(path.join(__dirname, 'data', 'nonexistent.tif')))
+  })
+})
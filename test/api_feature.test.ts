@@ -551,6 +551,92 @@ describe('gdal.Feature', () => {
         }, /destroyed/)
       })
     })
+    describe('borrowGeometry()', () => {
+      it('should return a view of the geometry', () => {
+        const feature = new gdal.Feature(defn)
+        feature.setGeometry(new gdal.Point(5, 10))
+        const pt = feature.borrowGeometry() as gdal.Point
+        assert.instanceOf(pt, gdal.Point)
+        assert.equal(pt.x, 5)
+      })
+      it('should copy the view instead of modifying the feature', () => {
+        const feature = new gdal.Feature(defn)
+        feature.setGeometry(new gdal.Point(5, 10))
+        const pt = feature.borrowGeometry() as gdal.Point
+        pt.x = 6
+        assert.equal(pt.x, 6)
+        assert.equal((feature.getGeometry() as gdal.Point).x, 5)
+        feature.destroy()
+        assert.equal(pt.x, 6)
+      })
+      it('should copy the view before modifying it through a collection', () => {
+        const feature = new gdal.Feature(defn)
+        feature.setGeometry(new gdal.LineString())
+        const line = feature.borrowGeometry() as gdal.LineString
+        line.points.add(1, 2)
+        assert.equal(line.points.count(), 1)
+        assert.equal((feature.getGeometry() as gdal.LineString).points.count(), 0)
+      })
+      it('should copy the view before transforming it', () => {
+        const feature = new gdal.Feature(defn)
+        const pt = new gdal.Point(5, 10)
+        pt.srs = gdal.SpatialReference.fromEPSG(4326)
+        feature.setGeometry(pt)
+        const view = feature.borrowGeometry() as gdal.Point
+        view.transformTo(gdal.SpatialReference.fromEPSG(3857))
+        assert.notEqual(view.x, 5)
+        assert.equal((feature.getGeometry() as gdal.Point).x, 5)
+      })
+      it('should return null if geometry is not set', () => {
+        const feature = new gdal.Feature(defn)
+        assert.isNull(feature.borrowGeometry())
+      })
+      it('should keep the geometry after the feature is destroyed', () => {
+        const feature = new gdal.Feature(defn)
+        feature.setGeometry(new gdal.Point(5, 10))
+        const pt = feature.borrowGeometry() as gdal.Point
+        feature.destroy()
+        assert.equal(pt.x, 5)
+        assert.equal(pt.y, 10)
+      })
+      it('should keep the previous geometry when a new one is set', () => {
+        const feature = new gdal.Feature(defn)
+        feature.setGeometry(new gdal.Point(5, 10))
+        const pt = feature.borrowGeometry() as gdal.Point
+        feature.setGeometry(new gdal.Point(1, 2))
+        assert.equal(pt.x, 5)
+        assert.equal((feature.borrowGeometry() as gdal.Point).x, 1)
+      })
+      it('should throw on destroyed feature', () => {
+        const feature = new gdal.Feature(defn)
+        feature.destroy()
+        assert.throws(() => {
+          feature.borrowGeometry()
+        }, /destroyed/)
+      })
+    })
+    describe('stealGeometry()', () => {
+      it('should remove the geometry from the feature', () => {
+        const feature = new gdal.Feature(defn)
+        feature.setGeometry(new gdal.Point(5, 10))
+        const pt = feature.stealGeometry() as gdal.Point
+        assert.equal(pt.x, 5)
+        assert.isNull(feature.getGeometry())
+      })
+      it('should return null if geometry is not set', () => {
+        const feature = new gdal.Feature(defn)
+        assert.isNull(feature.stealGeometry())
+      })
+      it('should leave the borrowed views intact', () => {
+        const feature = new gdal.Feature(defn)
+        feature.setGeometry(new gdal.Point(5, 10))
+        const view = feature.borrowGeometry() as gdal.Point
+        const pt = feature.stealGeometry() as gdal.Point
+        pt.x = 6
+        assert.equal(view.x, 5)
+        assert.isNull(feature.getGeometry())
+      })
+    })
     describe('setFrom()', () => {
       it('should set fields and geometry from other feature', () => {
         const feature1 = new gdal.Feature(defn)
@@ -237,6 +237,103 @@ describe('gdal.Geometry', () => {
       })
     })
   }
+  describe('toFlat()', () => {
+    it('should export a Polygon with ring offsets', () => {
+      const polygon = gdal.Geometry.fromWKT('POLYGON ((0 0,10 0,10 10,0 0),(1 1,2 1,2 2,1 1))')
+      const flat = polygon.toFlat()
+      assert.equal(flat.type, gdal.wkbPolygon)
+      assert.equal(flat.dims, 'xy')
+      assert.instanceOf(flat.coordinates, Float64Array)
+      assert.lengthOf(flat.coordinates, 16)
+      assert.deepEqual(Array.from(flat.ringOffsets), [ 0, 4, 8 ])
+      assert.isUndefined(flat.partOffsets)
+    })
+    it('should export a MultiPolygon with part offsets', () => {
+      const multi = gdal.Geometry.fromWKT(
+        'MULTIPOLYGON (((0 0,10 0,10 10,0 0),(1 1,2 1,2 2,1 1)),((20 20,30 20,30 30,20 20)))')
+      const flat = multi.toFlat({ dims: 'xyz' })
+      assert.equal(flat.dims, 'xyz')
+      assert.lengthOf(flat.coordinates, 36)
+      assert.deepEqual(Array.from(flat.ringOffsets), [ 0, 4, 8, 12 ])
+      assert.deepEqual(Array.from(flat.partOffsets), [ 0, 2, 3 ])
+    })
+    it('should throw on unsupported geometries', () => {
+      const collection = gdal.Geometry.fromWKT('GEOMETRYCOLLECTION (POINT (1 2))')
+      assert.throws(() => {
+        collection.toFlat()
+      }, /Unsupported/)
+    })
+  })
+  describe('fromFlat()', () => {
+    it('should round-trip all supported types', () => {
+      for (const wkt of [
+        'POINT (1 2)',
+        'LINESTRING (1 2,3 4)',
+        'POLYGON ((0 0,10 0,10 10,0 0),(1 1,2 1,2 2,1 1))',
+        'MULTIPOINT (1 2,3 4)',
+        'MULTILINESTRING ((1 2,3 4),(5 6,7 8,9 10))',
+        'MULTIPOLYGON (((0 0,10 0,10 10,0 0),(1 1,2 1,2 2,1 1)),((20 20,30 20,30 30,20 20)))',
+        'LINESTRING Z (1 2 3,4 5 6)'
+      ]) {
+        const geom = gdal.Geometry.fromWKT(wkt)
+        const copy = gdal.Geometry.fromFlat(geom.toFlat())
+        assert.isTrue(copy.equals(geom), wkt)
+        assert.equal(copy.wkbType, geom.wkbType, wkt)
+      }
+    })
+    it('should throw on invalid offsets', () => {
+      assert.throws(() => {
+        gdal.Geometry.fromFlat({
+          type: gdal.wkbPolygon,
+          dims: 'xy',
+          coordinates: new Float64Array([ 0, 0, 1, 0, 1, 1, 0, 0 ]),
+          ringOffsets: new Uint32Array([ 0, 5 ])
+        })
+      }, /not valid/)
+    })
+  })
+  describe('batch()', () => {
+    const points = [ new gdal.Point(0, 0), new gdal.Point(10, 0), new gdal.Point(0, 10) ]
+    it('should apply the operation to every geometry', () => {
+      const buffered = gdal.Geometry.batch(points, 'buffer', [ 1 ], { threads: 2 }) as gdal.Geometry[]
+      assert.isArray(buffered)
+      assert.lengthOf(buffered, 3)
+      buffered.forEach((g, i) => {
+        assert.instanceOf(g, gdal.Polygon)
+        assert.closeTo((g as gdal.Polygon).getArea(), Math.PI, 0.01)
+        assert.isTrue(g.contains(points[i]))
+      })
+    })
+    it('should return an Uint8Array for boolean operations', () => {
+      const bowtie = gdal.Geometry.fromWKT('POLYGON ((0 0, 10 10, 10 0, 0 10, 0 0))')
+      const valid = gdal.Geometry.batch([ points[0], bowtie ], 'isValid')
+      assert.instanceOf(valid, Uint8Array)
+      assert.deepEqual(Array.from(valid as Uint8Array), [ 1, 0 ])
+    })
+    it('should transform copies of the geometries', () => {
+      const ct = new gdal.CoordinateTransformation(gdal.SpatialReference.fromEPSG(4326),
+        gdal.SpatialReference.fromEPSG(3857))
+      const r = gdal.Geometry.batch([ new gdal.Point(10, 0) ], 'transform', [ ct ]) as gdal.Point[]
+      assert.notEqual(r[0].x, 10)
+    })
+    it('should throw on unsupported operations', () => {
+      assert.throws(() => {
+        gdal.Geometry.batch(points, 'explode')
+      }, /Unsupported batch operation/)
+    })
+    it('should throw on invalid geometries', () => {
+      assert.throws(() => {
+        gdal.Geometry.batch([ 1 ] as unknown as gdal.Geometry[], 'centroid')
+      }, /Geometry objects/)
+    })
+  })
+  describe('batchAsync()', () => {
+    it('should apply the operation to every geometry', () => {
+      const lines = [ gdal.Geometry.fromWKT('LINESTRING (0 0, 5 0.01, 10 0)'), gdal.Geometry.fromWKT('LINESTRING (0 0, 10 0)') ]
+      const r = gdal.Geometry.batchAsync(lines, 'simplify', [ 1 ], { threads: 2 }) as Promise<gdal.LineString[]>
+      return assert.eventually.deepEqual(r.then((a) => a.map((l) => l.points.count())), [ 2, 2 ])
+    })
+  })
   describe('getConstructor()', () => {
     //  wkbUnknown = 0, wkbPoint = 1, wkbLineString = 2, wkbPolygon = 3,
     //  wkbMultiPoint = 4, wkbMultiLineString = 5, wkbMultiPolygon = 6, wkbGeometryCollection = 7,
@@ -934,6 +1031,59 @@ describe('gdal.Geometry', () => {
         ]))
       })
     })
+    describe('prepare()', () => {
+      const square = gdal.Geometry.fromWKT('POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))')
+      it('should return a PreparedGeometry', () => {
+        assert.instanceOf(square.prepare(), gdal.PreparedGeometry)
+      })
+      it('should evaluate the spatial predicates', () => {
+        const prepared = square.prepare()
+        const inside = new gdal.Point(5, 5)
+        const edge = new gdal.Point(10, 5)
+        const outside = new gdal.Point(15, 5)
+        assert.isTrue(prepared.intersects(edge))
+        assert.isFalse(prepared.intersects(outside))
+        assert.isTrue(prepared.contains(inside))
+        assert.isFalse(prepared.contains(edge))
+        assert.isTrue(prepared.containsProperly(inside))
+        assert.isTrue(prepared.covers(edge))
+        assert.isFalse(prepared.covers(gdal.Geometry.fromWKT('LINESTRING (5 5, 15 5)')))
+        assert.isTrue(prepared.within(gdal.Geometry.fromWKT('POLYGON ((-1 -1, 11 -1, 11 11, -1 11, -1 -1))')))
+      })
+      it('should not be affected by modifying the original geometry', () => {
+        const polygon = square.clone() as gdal.Polygon
+        const prepared = polygon.prepare()
+        polygon.empty()
+        assert.isTrue(prepared.contains(new gdal.Point(5, 5)))
+      })
+      it('should evaluate an array of geometries', () => {
+        const r = square.prepare().containsMany([ new gdal.Point(5, 5), new gdal.Point(15, 5) ])
+        assert.instanceOf(r, Uint8Array)
+        assert.deepEqual(Array.from(r), [ 1, 0 ])
+      })
+      it('should evaluate a flat buffer of points', () => {
+        const r = square.prepare().intersectsMany(new Float64Array([ 5, 5, 0, 10, 15, 5, 20, 20 ]))
+        assert.deepEqual(Array.from(r), [ 1, 1, 0, 0 ])
+        const z = square.prepare().containsMany(new Float64Array([ 5, 5, 100, 15, 5, 100 ]), { dims: 'xyz' })
+        assert.deepEqual(Array.from(z), [ 1, 0 ])
+      })
+      it('should throw on invalid arguments', () => {
+        const prepared = square.prepare()
+        assert.throws(() => {
+          prepared.containsMany([ 1, 2 ] as unknown as gdal.Geometry[])
+        }, /Geometry objects/)
+        assert.throws(() => {
+          prepared.containsMany(new Float64Array([ 1, 2, 3 ]))
+        }, /multiple of the number of dimensions/)
+      })
+    })
+    describe('prepare().containsManyAsync()', () => {
+      it('should evaluate a flat buffer of points', () => {
+        const square = gdal.Geometry.fromWKT('POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))')
+        const r = square.prepare().containsManyAsync(new Float64Array([ 5, 5, 15, 5 ]))
+        return assert.eventually.deepEqual(r.then((a) => Array.from(a)), [ 1, 0 ])
+      })
+    })
     if (gdal.bundled) {
       it('makeValid', () => {
         const json = JSON.parse(fs.readFileSync(path.join(__dirname, 'data', 'makeValid.json'), 'utf-8'))
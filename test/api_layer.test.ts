@@ -1,6 +1,7 @@
 import * as gdal from '..'
 import { assert } from 'chai'
 import * as fileUtils from './utils/file.js'
+import { square } from './utils/geometry.js'
 
 describe('gdal.Layer', () => {
   afterEach(global.gc)
@@ -245,6 +246,161 @@ describe('gdal.Layer', () => {
       })
     })
 
+    describe('layer algebra', () => {
+      const prepare_algebra_test = (callback: (input: gdal.Layer, method: gdal.Layer, result: gdal.Layer) => void) => {
+        const ds = gdal.open('algebra', 'w', 'Memory')
+        const input = ds.layers.create('input', null, gdal.Polygon)
+        input.fields.add(new gdal.FieldDefn('name', gdal.OFTString))
+        for (const [ name, x ] of [ [ 'a', 0 ], [ 'b', 10 ] ] as [string, number][]) {
+          const f = new gdal.Feature(input)
+          f.fields.set('name', name)
+          f.setGeometry(square(x, x, 2))
+          input.features.add(f)
+        }
+        const method = ds.layers.create('method', null, gdal.Polygon)
+        const f = new gdal.Feature(method)
+        f.setGeometry(square(1, 1, 2))
+        method.features.add(f)
+        const result = ds.layers.create('result', null, gdal.Polygon)
+        try {
+          callback(input, method, result)
+        } finally {
+          ds.close()
+        }
+      }
+      const areas = (layer: gdal.Layer) =>
+        layer.features.map((f) => (f.getGeometry() as gdal.Polygon).getArea()).sort((a, b) => a - b)
+
+      describe('clip()', () => {
+        it('should keep only the areas covered by the method layer', () => {
+          prepare_algebra_test((input, method, result) => {
+            input.clip(method, result)
+            assert.deepEqual(areas(result), [ 1 ])
+            assert.equal(result.features.first().fields.get('name'), 'a')
+          })
+        })
+        it('should call the progress callback', () => {
+          prepare_algebra_test((input, method, result) => {
+            let calls = 0
+            input.clip(method, result, null, { progress_cb: () => {
+              calls++
+            } })
+            assert.isAbove(calls, 0)
+          })
+        })
+        it('should be interrupted when the progress callback returns false', () => {
+          prepare_algebra_test((input, method, result) => {
+            assert.throws(() => {
+              input.clip(method, result, null, { progress_cb: () => false })
+            }, /terminated/)
+          })
+        })
+        it('should throw if the method layer is not a layer', () => {
+          prepare_algebra_test((input, method, result) => {
+            assert.throws(() => {
+              input.clip({} as gdal.Layer, result)
+            }, /method layer must be an instance of Layer/)
+          })
+        })
+      })
+      describe('erase()', () => {
+        it('should remove the areas covered by the method layer', () => {
+          prepare_algebra_test((input, method, result) => {
+            input.erase(method, result)
+            assert.deepEqual(areas(result), [ 3, 4 ])
+          })
+        })
+      })
+      describe('intersection()', () => {
+        it('should produce the common areas with the fields of both layers', () => {
+          prepare_algebra_test((input, method, result) => {
+            input.intersection(method, result, [ 'INPUT_PREFIX=in_' ])
+            assert.deepEqual(areas(result), [ 1 ])
+            assert.include(result.fields.getNames(), 'in_name')
+          })
+        })
+      })
+      describe('union()', () => {
+        it('should produce all the areas of both layers', () => {
+          prepare_algebra_test((input, method, result) => {
+            input.union(method, result)
+            assert.closeTo(areas(result).reduce((a, x) => a + x, 0), 11, 1e-9)
+          })
+        })
+      })
+      describe('symDifference()', () => {
+        it('should produce the areas that are not common', () => {
+          prepare_algebra_test((input, method, result) => {
+            input.symDifference(method, result)
+            assert.deepEqual(areas(result), [ 3, 3, 4 ])
+          })
+        })
+      })
+      describe('identity()', () => {
+        it('should split the input features by the method layer', () => {
+          prepare_algebra_test((input, method, result) => {
+            input.identity(method, result)
+            assert.deepEqual(areas(result), [ 1, 3, 4 ])
+          })
+        })
+      })
+      describe('update()', () => {
+        it('should replace the areas covered by the method layer', () => {
+          prepare_algebra_test((input, method, result) => {
+            input.update(method, result)
+            assert.deepEqual(areas(result), [ 3, 4, 4 ])
+          })
+        })
+      })
+      describe('dissolve()', () => {
+        const prepare_dissolve_test = (callback: (input: gdal.Layer, result: gdal.Layer) => void) =>
+          prepare_algebra_test((input, method, result) => {
+            const f = new gdal.Feature(input)
+            f.fields.set('name', 'a')
+            f.setGeometry(square(1, 1, 2))
+            input.features.add(f)
+            callback(input, result)
+          })
+        it('should merge the features with the same values', () => {
+          prepare_dissolve_test((input, result) => {
+            input.dissolve({ by: [ 'name' ], output: result })
+            assert.deepEqual(result.fields.getNames(), [ 'name' ])
+            const dissolved = result.features.map((f) =>
+              [ f.fields.get('name'), (f.getGeometry() as gdal.Polygon).getArea() ])
+            assert.sameDeepMembers(dissolved, [ [ 'a', 7 ], [ 'b', 4 ] ])
+          })
+        })
+        it('should merge all the features without fields', () => {
+          prepare_dissolve_test((input, result) => {
+            input.dissolve({ output: result, threads: 1 })
+            assert.equal(result.features.count(), 1)
+            assert.closeTo((result.features.first().getGeometry() as gdal.MultiPolygon).getArea(), 11, 1e-9)
+          })
+        })
+        it('should be interrupted when the progress callback returns false', () => {
+          prepare_dissolve_test((input, result) => {
+            assert.throws(() => {
+              input.dissolve({ by: [ 'name' ], output: result, threads: 1, progress_cb: () => false })
+            }, /terminated/)
+          })
+        })
+        it('should throw on non-existent fields', () => {
+          prepare_dissolve_test((input, result) => {
+            assert.throws(() => {
+              input.dissolve({ by: [ 'region' ], output: result })
+            }, /non-existent field/)
+          })
+        })
+        it('should throw without an output layer', () => {
+          prepare_dissolve_test((input) => {
+            assert.throws(() => {
+              input.dissolve({ by: [ 'name' ] } as gdal.DissolveOptions)
+            }, /output/)
+          })
+        })
+      })
+    })
+
     describe('getExtent()', () => {
       it('should return Envelope', () => {
         prepare_dataset_layer_test('r', (dataset, layer) => {
@@ -448,6 +604,80 @@ describe('gdal.Layer', () => {
           })
         })
       })
+      describe('getMany()', () => {
+        it('should return the Features in the requested order', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const features = layer.features.getMany([ 5, 1, 3, 1 ])
+            assert.isArray(features)
+            assert.lengthOf(features, 4)
+            assert.deepEqual(features.map((f) => f.fid), [ 5, 1, 3, 1 ])
+            assert.instanceOf(features[0], gdal.Feature)
+            assert.notEqual(features[1], features[3])
+          })
+        })
+        it('should accept a Float64Array', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const features = layer.features.getMany(new Float64Array([ 2, 0 ]))
+            assert.deepEqual(features.map((f) => f.fid), [ 2, 0 ])
+          })
+        })
+        it("should return null if index doesn't exist", () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const features = layer.features.getMany([ 0, 99 ])
+            assert.instanceOf(features[0], gdal.Feature)
+            assert.isNull(features[1])
+          })
+        })
+        it('should throw on ids that are not integers', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            assert.throws(() => layer.features.getMany([ 1.5 ]), TypeError, /integers/)
+            assert.throws(() => layer.features.getMany(new Float64Array([ 0, NaN ])), TypeError, /integers/)
+            assert.throws(() => layer.features.getMany(new Float64Array([ Infinity ])), TypeError, /integers/)
+            assert.throws(() => layer.features.getMany([ 1e20 ]), TypeError, /integers/)
+          })
+        })
+        it('should throw error if dataset is destroyed', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            dataset.close()
+            assert.throws(() => {
+              layer.features.getMany([ 0 ])
+            }, /already destroyed/)
+          })
+        })
+      })
+      describe('page()', () => {
+        it('should return a page of Features', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const features = layer.features.page(10, 5)
+            assert.isArray(features)
+            assert.deepEqual(features.map((f) => f.fid), [ 10, 11, 12, 13, 14 ])
+          })
+        })
+        it('should return a short page at the end of the layer', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            assert.lengthOf(layer.features.page(20, 5), 3)
+            assert.lengthOf(layer.features.page(30, 5), 0)
+          })
+        })
+        it('should honor the filters', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            layer.setAttributeFilter('fips_num > 10')
+            const all = layer.features.map((f) => f.fid)
+            const features = layer.features.page(2, 3)
+            assert.deepEqual(features.map((f) => f.fid), all.slice(2, 5))
+            layer.setAttributeFilter(null)
+            assert.lengthOf(layer.features.page(0, 100), 23)
+          })
+        })
+        it('should throw error if dataset is destroyed', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            dataset.close()
+            assert.throws(() => {
+              layer.features.page(0, 10)
+            }, /already destroyed/)
+          })
+        })
+      })
       describe('next()', () => {
         it('should return a Feature and increment the iterator', () => {
           prepare_dataset_layer_test('r', (dataset, layer) => {
@@ -494,6 +724,66 @@ describe('gdal.Layer', () => {
           })
         })
       })
+      describe('cursor()', () => {
+        it('should return a FeatureCursor that iterates over all features', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const cursor = layer.features.cursor()
+            assert.instanceOf(cursor, gdal.FeatureCursor)
+            assert.instanceOf(cursor, gdal.Feature)
+            let count = 0
+            while (cursor.advance()) {
+              assert.equal(cursor.fid, count)
+              assert.isString(cursor.fields.get('name'))
+              count++
+            }
+            assert.equal(count, layer.features.count())
+          })
+        })
+        it('should reuse the same object', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const cursor = layer.features.cursor()
+            cursor.advance()
+            const f0 = cursor.clone()
+            cursor.advance()
+            assert.equal(f0.fid, 0)
+            assert.equal(cursor.fid, 1)
+            assert.equal(cursor.layer, layer)
+          })
+        })
+        it('should keep the borrowed geometries after advancing', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const cursor = layer.features.cursor()
+            cursor.advance()
+            const g0 = cursor.borrowGeometry()
+            const wkt = g0.toWKT()
+            cursor.advance()
+            assert.equal(g0.toWKT(), wkt)
+            assert.notEqual(cursor.borrowGeometry().toWKT(), wkt)
+          })
+        })
+        it('should be empty before advance() and after the last feature', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const cursor = layer.features.cursor()
+            assert.throws(() => {
+              cursor.fid
+            }, /already destroyed/)
+            while (cursor.advance());
+            assert.isFalse(cursor.advance())
+            assert.throws(() => {
+              cursor.fid
+            }, /already destroyed/)
+          })
+        })
+        it('should throw error if dataset is destroyed', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const cursor = layer.features.cursor()
+            dataset.close()
+            assert.throws(() => {
+              cursor.advance()
+            }, /already destroyed/)
+          })
+        })
+      })
       describe('forEach()', () => {
         it('should pass each feature to the callback', () => {
           prepare_dataset_layer_test('r', (dataset, layer) => {
@@ -3,6 +3,7 @@ import * as chai from 'chai'
 const assert = chai.assert
 import * as gdal from '..'
 import * as fileUtils from './utils/file.js'
+import { square } from './utils/geometry.js'
 
 chai.use(chaiAsPromised)
 
@@ -257,6 +258,46 @@ describe('gdal.LayerAsync', () => {
       )
     })
 
+    describe('clipAsync()', () => {
+      it('should clip a layer/Async', () => {
+        const ds = gdal.open('algebra', 'w', 'Memory')
+        const input = ds.layers.create('input', null, gdal.Polygon)
+        const method = ds.layers.create('method', null, gdal.Polygon)
+        const result = ds.layers.create('result', null, gdal.Polygon)
+        for (const [ layer, x ] of [ [ input, 0 ], [ input, 10 ], [ method, 1 ] ] as [gdal.Layer, number][]) {
+          const f = new gdal.Feature(layer)
+          f.setGeometry(square(x, x, 2))
+          layer.features.add(f)
+        }
+        const q = input.clipAsync(method, result)
+        return assert.isFulfilled(q.then(() => {
+          assert.equal(result.features.count(), 1)
+          assert.closeTo((result.features.first().getGeometry() as gdal.Polygon).getArea(), 1, 1e-9)
+          ds.close()
+        }))
+      })
+      it('should reject if the method layer is not a layer/Async', () =>
+        prepare_dataset_layer_test('r', (dataset, layer) =>
+          assert.isRejected(layer.clipAsync({} as gdal.Layer, layer), /method layer must be an instance of Layer/)
+        )
+      )
+    })
+
+    describe('dissolveAsync()', () => {
+      it('should dissolve a layer/Async', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer) => {
+          const ds = gdal.open('dissolve', 'w', 'Memory')
+          const result = ds.layers.create('result', null, gdal.MultiPolygon)
+          return assert.isFulfilled(layer.dissolveAsync({ output: result }).then(() => {
+            assert.equal(result.features.count(), 1)
+            assert.equal(result.fields.count(), 0)
+            ds.close()
+            dataset.close()
+          }))
+        })
+      )
+    })
+
     describe('removeAsync()', () => {
       it('should remove a layer/Async', () =>
         prepare_dataset_layer_test('w', { autoclose: false }, (dataset) => {
@@ -486,6 +527,40 @@ describe('gdal.LayerAsync', () => {
           })
         )
       })
+      describe('getManyAsync()', () => {
+        it('should return the Features in the requested order', () =>
+          prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer) => {
+            const features = layer.features.getManyAsync([ 5, 99, 1 ])
+            return assert.isFulfilled(features.then((r) => {
+              assert.lengthOf(r, 3)
+              assert.equal(r[0].fid, 5)
+              assert.isNull(r[1])
+              assert.equal(r[2].fid, 1)
+            }))
+          })
+        )
+        it('should throw error if dataset is destroyed', () =>
+          prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer) => {
+            dataset.close()
+            return assert.isRejected(layer.features.getManyAsync([ 0 ]), /already destroyed/)
+          })
+        )
+      })
+      describe('pageAsync()', () => {
+        it('should return a page of Features', () =>
+          prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer) =>
+            assert.isFulfilled(layer.features.pageAsync(20, 5).then((r) => {
+              assert.deepEqual(r.map((f) => f.fid), [ 20, 21, 22 ])
+            }))
+          )
+        )
+        it('should throw error if dataset is destroyed', () =>
+          prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer) => {
+            dataset.close()
+            return assert.isRejected(layer.features.pageAsync(0, 10), /already destroyed/)
+          })
+        )
+      })
       describe('nextAsync()', () => {
         it('should return a Feature and increment the iterator', () =>
           prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer) => {
@@ -530,6 +605,27 @@ describe('gdal.LayerAsync', () => {
           })
         )
       })
+      describe('cursor().advanceAsync()', () => {
+        it('should iterate over all features', () =>
+          prepare_dataset_layer_test('r', { autoclose: false }, async (dataset, layer) => {
+            const cursor = layer.features.cursor()
+            let count = 0
+            while (await cursor.advanceAsync()) {
+              assert.instanceOf(cursor, gdal.Feature)
+              assert.equal(cursor.fid, count)
+              count++
+            }
+            assert.equal(count, 23)
+          })
+        )
+        it('should throw error if dataset is destroyed', () =>
+          prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer) => {
+            const cursor = layer.features.cursor()
+            dataset.close()
+            return assert.isRejected(cursor.advanceAsync(), /already destroyed/)
+          })
+        )
+      })
       describe('forEach()', () => {
         it('should pass each feature to the callback', () => {
           prepare_dataset_layer_test('r', (dataset, layer) => {
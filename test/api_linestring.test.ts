@@ -220,6 +220,39 @@ describe('gdal.LineString', () => {
           assert.equal(p3.x, 1)
         })
       })
+      describe('toTypedArray()', () => {
+        it('should return the interleaved coordinates', () => {
+          const line = new gdal.LineString()
+          line.points.add(1, 2, 3)
+          line.points.add(2, 3, 4)
+          const xyz = line.points.toTypedArray()
+          assert.instanceOf(xyz, Float64Array)
+          assert.deepEqual(Array.from(xyz), [ 1, 2, 3, 2, 3, 4 ])
+          assert.deepEqual(Array.from(line.points.toTypedArray({ dims: 'xy' })), [ 1, 2, 2, 3 ])
+        })
+        it('should throw on invalid dims', () => {
+          const line = new gdal.LineString()
+          assert.throws(() => {
+            line.points.toTypedArray({ dims: 'xz' })
+          }, /dims must be/)
+        })
+      })
+      describe('setTypedArray()', () => {
+        it('should replace all the points', () => {
+          const line = new gdal.LineString()
+          line.points.add(5, 5)
+          line.points.setTypedArray(new Float64Array([ 0, 0, 10, 0, 10, 10 ]), { dims: 'xy' })
+          assert.equal(line.points.count(), 3)
+          assert.equal(line.points.get(2).x, 10)
+          assert.equal(line.points.get(2).y, 10)
+        })
+        it('should throw if the length is not a multiple of the dimensions', () => {
+          const line = new gdal.LineString()
+          assert.throws(() => {
+            line.points.setTypedArray(new Float64Array([ 0, 0, 10 ]), { dims: 'xy' })
+          }, /multiple/)
+        })
+      })
       describe('forEach()', () => {
         it('should stop if callback returns false', () => {
           const line = new gdal.LineString()
@@ -0,0 +1,89 @@
+import * as gdal from '..'
+import * as path from 'path'
+import * as chai from 'chai'
+const assert = chai.assert
+
+describe('gdal.memoryUsage()', () => {
+  afterEach(global.gc)
+
+  it('should return a breakdown by type', () => {
+    const usage = gdal.memoryUsage()
+    for (const type of [ 'Dataset', 'Layer', 'MDArray', 'Feature' ] as const) {
+      assert.isNumber(usage[type].objects)
+      assert.isNumber(usage[type].bytes)
+    }
+  })
+
+  it('should include the pixels of the MEM datasets', () => {
+    const before = gdal.memoryUsage().Dataset
+    const ds = gdal.open('temp', 'w', 'MEM', 256, 256, 1, gdal.GDT_Float64)
+    const during = gdal.memoryUsage().Dataset
+    assert.equal(during.objects, before.objects + 1)
+    assert.isAtLeast(during.bytes - before.bytes, 256 * 256 * 8)
+
+    ds.bands.create(gdal.GDT_Float64)
+    assert.isAtLeast(gdal.memoryUsage().Dataset.bytes - during.bytes, 256 * 256 * 8)
+
+    ds.close()
+    assert.deepEqual(gdal.memoryUsage().Dataset, before)
+  })
+
+  it('should count the layers of a dataset', () => {
+    const ds = gdal.open(path.join(__dirname, 'data', 'park.geo.json'))
+    const before = gdal.memoryUsage().Layer
+    const layer = ds.layers.get(0)
+    const during = gdal.memoryUsage().Layer
+    assert.equal(during.objects, before.objects + 1)
+    assert.isAbove(during.bytes, before.bytes)
+    assert.equal(layer.features.count(), 1)
+    ds.close()
+    assert.deepEqual(gdal.memoryUsage().Layer, before)
+  })
+
+  it('should follow the size of the features', () => {
+    const ds = gdal.open('temp', 'w', 'Memory')
+    const layer = ds.layers.create('temp', null, gdal.LineString)
+    layer.fields.add(new gdal.FieldDefn('name', gdal.OFTString))
+
+    const before = gdal.memoryUsage().Feature
+    const feature = new gdal.Feature(layer)
+    const created = gdal.memoryUsage().Feature
+    assert.equal(created.objects, before.objects + 1)
+    assert.isAbove(created.bytes, before.bytes)
+
+    feature.fields.set('name', 'x'.repeat(64 * 1024))
+    const line = new gdal.LineString()
+    for (let i = 0; i < 8192; i++) line.points.add(i, i)
+    feature.setGeometry(line)
+    const filled = gdal.memoryUsage().Feature
+    assert.isAtLeast(filled.bytes - created.bytes, 64 * 1024 + 8192 * 16)
+
+    feature.destroy()
+    assert.deepEqual(gdal.memoryUsage().Feature, before)
+    ds.close()
+  })
+
+  it('should count the current row of a cursor', () => {
+    const ds = gdal.open('temp', 'w', 'Memory')
+    const layer = ds.layers.create('temp', null, gdal.Point)
+    layer.fields.add(new gdal.FieldDefn('name', gdal.OFTString))
+    for (const name of [ 'a', 'x'.repeat(64 * 1024) ]) {
+      const f = new gdal.Feature(layer)
+      f.fields.set('name', name)
+      layer.features.add(f)
+    }
+
+    const before = gdal.memoryUsage().Feature
+    const cursor = layer.features.cursor()
+    for (let i = 0; i < 2; i++) {
+      assert.isTrue(cursor.advance())
+      const during = gdal.memoryUsage().Feature
+      assert.equal(during.objects, before.objects + 1)
+      assert.isAbove(during.bytes, before.bytes)
+    }
+    assert.isAtLeast(gdal.memoryUsage().Feature.bytes - before.bytes, 64 * 1024)
+    assert.isFalse(cursor.advance())
+    assert.deepEqual(gdal.memoryUsage().Feature, before)
+    ds.close()
+  })
+})
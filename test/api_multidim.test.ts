@@ -325,6 +325,15 @@ describe('gdal', () => {
         assert.deepEqual(data1, data2)
         ds.close()
       })
+
+      it('should be closed with its parent by closeAsync()', () => {
+        const child = mdarray.asDataset(2, 1)
+        const band = child.bands.get(1)
+        const read = band.pixels.readAsync(10, 7, 5, 5).then(() => true, () => true)
+        return assert.isFulfilled(Promise.all([ read, ds.closeAsync() ]).then(() => {
+          assert.throws(() => band.pixels.get(0, 0), /already been destroyed/)
+        }))
+      })
     })
 
     describe('read', () => {
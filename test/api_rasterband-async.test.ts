@@ -504,6 +504,26 @@ describe('gdal.RasterBandAsync', () => {
             return assert.isRejected(band.pixels.writeBlockAsync(0, 0, data))
           })
         })
+        describe('adviseReadAsync()', () => {
+          it('should resolve for a window inside the raster', () => {
+            const ds = gdal.open(`${__dirname}/data/sample.tif`)
+            const band = ds.bands.get(1)
+            return assert.isFulfilled(band.pixels.adviseReadAsync(0, 0, 20, 30, { type: gdal.GDT_Float32 }))
+          })
+          it('should throw error if the window is out of bounds', () => {
+            const ds = gdal.open(`${__dirname}/data/sample.tif`)
+            const band = ds.bands.get(1)
+            assert.throws(() => {
+              band.pixels.adviseReadAsync(-1, 0, 10, 10)
+            }, /outside of the raster/)
+          })
+          it('should reject if dataset already closed', () => {
+            const ds = gdal.open(`${__dirname}/data/sample.tif`)
+            const band = ds.bands.get(1)
+            ds.close()
+            return assert.isRejected(band.pixels.adviseReadAsync(0, 0, 10, 10))
+          })
+        })
       })
     })
     describe('fillAsync()', () => {
@@ -1263,6 +1263,57 @@ describe('gdal.RasterBand', () => {
           })
         })
       })
+      describe('adviseRead()', () => {
+        it('should accept a window inside the raster', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          const expected = band.pixels.read(10, 10, 20, 30)
+          assert.isUndefined(band.pixels.adviseRead(0, 0, 20, 30))
+          assert.isUndefined(
+            band.pixels.adviseRead(10, 10, 20, 30, { buffer_width: 10, buffer_height: 15, type: gdal.GDT_Float32 }))
+          assert.deepEqual(band.pixels.read(10, 10, 20, 30), expected)
+        })
+        it('should not modify the file', () => {
+          const filename = `/vsimem/advise_${String(Math.random()).substring(2)}.tif`
+          const src = gdal.open(filename, 'w', 'GTiff', 64, 64, 3, gdal.GDT_Byte)
+          src.bands.forEach((band) => band.fill(band.id))
+          src.close()
+
+          gdal.vsistats.reset()
+          const ds = gdal.open(`/vsistats/${filename}`)
+          const band = ds.bands.get(2)
+          band.pixels.adviseRead(16, 16, 32, 32)
+          const data = band.pixels.read(16, 16, 32, 32)
+          assert.isTrue(data.every((v) => v === 2))
+          const stats = ds.ioStats()
+          assert.isAbove(stats.bytesRead, 0)
+          assert.equal(stats.writes, 0)
+          ds.close()
+          gdal.vsimem.release(filename)
+        })
+        it('should throw error if the window is out of bounds', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          assert.throws(() => {
+            band.pixels.adviseRead(0, 0, band.size.x + 1, 10)
+          }, /outside of the raster/)
+        })
+        it('should throw error on invalid data type', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          assert.throws(() => {
+            band.pixels.adviseRead(0, 0, 10, 10, { type: 'invalid' })
+          }, /Invalid data type/)
+        })
+        it('should throw error if dataset already closed', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          ds.close()
+          assert.throws(() => {
+            band.pixels.adviseRead(0, 0, 10, 10)
+          })
+        })
+      })
     })
     describe('"overviews" property', () => {
       describe('getter', () => {
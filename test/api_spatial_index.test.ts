@@ -0,0 +1,111 @@
+import * as gdal from '..'
+import * as chai from 'chai'
+import * as chaiAsPromised from 'chai-as-promised'
+const assert = chai.assert
+chai.use(chaiAsPromised)
+
+describe('gdal.SpatialIndex', () => {
+  afterEach(global.gc)
+
+  // a 10x10 grid of unit squares, square i has its lower left corner at (i % 10, floor(i / 10))
+  const squares: gdal.Geometry[] = []
+  for (let i = 0; i < 100; i++) {
+    const x = i % 10, y = Math.floor(i / 10)
+    squares.push(gdal.Geometry.fromWKT(
+      `POLYGON ((${x} ${y}, ${x + 0.5} ${y}, ${x + 0.5} ${y + 0.5}, ${x} ${y + 0.5}, ${x} ${y}))`))
+  }
+
+  describe('fromGeometries()', () => {
+    it('should index all the geometries', () => {
+      const index = gdal.SpatialIndex.fromGeometries(squares)
+      assert.instanceOf(index, gdal.SpatialIndex)
+      assert.equal(index.count, 100)
+    })
+    it('should skip empty geometries', () => {
+      const index = gdal.SpatialIndex.fromGeometries([ new gdal.Point(), squares[0] ])
+      assert.equal(index.count, 1)
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => {
+        gdal.SpatialIndex.fromGeometries([ 1 ] as unknown as gdal.Geometry[])
+      }, /Geometry objects/)
+    })
+  })
+
+  describe('fromGeometriesAsync()', () => {
+    it('should index all the geometries', () => {
+      const index = gdal.SpatialIndex.fromGeometriesAsync(squares)
+      return assert.eventually.equal(index.then((i) => i.count), 100)
+    })
+  })
+
+  describe('fromLayer()', () => {
+    it('should index the features by FID', () => {
+      const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+      const layer = ds.layers.get(0)
+      const index = gdal.SpatialIndex.fromLayer(layer)
+      assert.equal(index.count, layer.features.count())
+      const fids = index.query(layer.getExtent())
+      assert.instanceOf(fids, Float64Array)
+      assert.deepEqual(Array.from(fids), Array.from({ length: layer.features.count() }, (_, i) => i))
+    })
+  })
+
+  describe('fromLayerAsync()', () => {
+    it('should index the features', () => {
+      const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+      const layer = ds.layers.get(0)
+      const index = gdal.SpatialIndex.fromLayerAsync(layer)
+      return assert.eventually.equal(index.then((i) => i.count), layer.features.count())
+    })
+  })
+
+  describe('query()', () => {
+    it('should return the geometries with intersecting envelopes', () => {
+      const index = gdal.SpatialIndex.fromGeometries(squares)
+      const r = index.query(new gdal.Envelope({ minX: 0.75, maxX: 2.25, minY: 0.25, maxY: 0.75 }))
+      assert.deepEqual(Array.from(r), [ 1, 2 ])
+    })
+    it('should return an empty array when nothing intersects', () => {
+      const index = gdal.SpatialIndex.fromGeometries(squares)
+      assert.lengthOf(index.query({ minX: 20, maxX: 30, minY: 20, maxY: 30 }), 0)
+    })
+  })
+
+  describe('intersecting()', () => {
+    it('should refine the results with an exact test', () => {
+      const index = gdal.SpatialIndex.fromGeometries(squares)
+      // the envelope of this line intersects squares 0, 1, 10 and 11, the line only 0 and 11
+      const line = gdal.Geometry.fromWKT('LINESTRING (0.25 0.25, 1.25 1.25)')
+      assert.deepEqual(Array.from(index.intersecting(line)), [ 0, 11 ])
+    })
+  })
+
+  describe('intersectingAsync()', () => {
+    it('should refine the results with an exact test', () => {
+      const index = gdal.SpatialIndex.fromGeometries(squares)
+      const line = gdal.Geometry.fromWKT('LINESTRING (0.25 0.25, 1.25 1.25)')
+      return assert.eventually.deepEqual(index.intersectingAsync(line).then((r) => Array.from(r)), [ 0, 11 ])
+    })
+  })
+
+  describe('nearest()', () => {
+    it('should return the closest geometries ordered by distance', () => {
+      const index = gdal.SpatialIndex.fromGeometries(squares)
+      const r = index.nearest(new gdal.Point(3.6, 5.25), 2)
+      assert.deepEqual(Array.from(r), [ 53, 54 ])
+    })
+    it('should return the closest geometry by default', () => {
+      const index = gdal.SpatialIndex.fromGeometries(squares)
+      assert.deepEqual(Array.from(index.nearest(new gdal.Point(20, 20))), [ 99 ])
+    })
+  })
+
+  describe('nearestAsync()', () => {
+    it('should return the closest geometries ordered by distance', () => {
+      const index = gdal.SpatialIndex.fromGeometries(squares)
+      return assert.eventually.deepEqual(index.nearestAsync(new gdal.Point(3.6, 5.25), 2).then((r) => Array.from(r)),
+        [ 53, 54 ])
+    })
+  })
+})
@@ -0,0 +1,120 @@
+import * as gdal from '..'
+import { assert } from 'chai'
+
+describe('gdal.srsCache', () => {
+  afterEach(global.gc)
+
+  beforeEach(() => {
+    gdal.srsCache.setMaxSize(256)
+    gdal.srsCache.clear()
+  })
+  after(() => {
+    gdal.srsCache.setMaxSize(256)
+  })
+
+  it('should be exposed', () => {
+    assert.isFunction(gdal.srsCache.clear)
+    assert.isFunction(gdal.srsCache.stats)
+  })
+  it('should return independent spatial references', () => {
+    const srs1 = gdal.SpatialReference.fromEPSG(4326)
+    const srs2 = gdal.SpatialReference.fromEPSG(4326)
+    assert.notStrictEqual(srs1, srs2)
+    assert.isTrue(srs1.isSame(srs2))
+    srs1.morphToESRI()
+    assert.equal(srs2.toWKT(), gdal.SpatialReference.fromEPSG(4326).toWKT())
+    const stats = gdal.srsCache.stats()
+    assert.equal(stats.srs.misses, 1)
+    assert.equal(stats.srs.hits, 2)
+    assert.equal(stats.srs.size, 1)
+  })
+  it('should not mix fromEPSG() and fromEPSGA()', () => {
+    gdal.SpatialReference.fromEPSG(4326)
+    gdal.SpatialReference.fromEPSGA(4326)
+    assert.equal(gdal.srsCache.stats().srs.misses, 2)
+  })
+  it('should not cache the failures', () => {
+    assert.throws(() => {
+      gdal.SpatialReference.fromUserInput('EPSG:999999')
+    })
+    assert.throws(() => {
+      gdal.SpatialReference.fromUserInput('EPSG:999999')
+    })
+    const stats = gdal.srsCache.stats()
+    assert.equal(stats.srs.misses, 2)
+    assert.equal(stats.srs.size, 0)
+  })
+  it('should cache the codes and the WKT passed to fromUserInput()', () => {
+    gdal.SpatialReference.fromUserInput('EPSG:4326')
+    gdal.SpatialReference.fromUserInput('EPSG:4326')
+    const wkt = gdal.SpatialReference.fromEPSG(3857).toWKT()
+    gdal.SpatialReference.fromUserInput(wkt)
+    gdal.SpatialReference.fromUserInput(wkt)
+    const stats = gdal.srsCache.stats()
+    assert.equal(stats.srs.hits, 2)
+    assert.equal(stats.srs.size, 3)
+  })
+  it('should not cache the files passed to fromUserInput()', () => {
+    const prj = `${__dirname}/data/shp/sample.prj`
+    const srs1 = gdal.SpatialReference.fromUserInput(prj)
+    const srs2 = gdal.SpatialReference.fromUserInput(prj)
+    assert.isTrue(srs1.isSame(srs2))
+    const stats = gdal.srsCache.stats()
+    assert.equal(stats.srs.hits, 0)
+    assert.equal(stats.srs.misses, 0)
+    assert.equal(stats.srs.size, 0)
+  })
+  it('should cache the coordinate transformations', () => {
+    const src = gdal.SpatialReference.fromProj4('+init=epsg:4326')
+    const dst = gdal.SpatialReference.fromProj4('+init=epsg:32632')
+    const ct1 = new gdal.CoordinateTransformation(src, dst)
+    const ct2 = new gdal.CoordinateTransformation(src, dst)
+    assert.deepEqual(ct1.transformPoint(20, 30), ct2.transformPoint(20, 30))
+    const stats = gdal.srsCache.stats()
+    assert.equal(stats.transformations.misses, 1)
+    assert.equal(stats.transformations.hits, 1)
+  })
+  it('should be used by Geometry.transformTo()', () => {
+    const src = gdal.SpatialReference.fromProj4('+init=epsg:4326')
+    const dst = gdal.SpatialReference.fromProj4('+init=epsg:32632')
+    for (let i = 0; i < 3; i++) {
+      const pt = new gdal.Point(20, 30)
+      pt.srs = src
+      pt.transformTo(dst)
+      assert.closeTo(pt.x, 1564201.4044502454, 0.1)
+    }
+    const stats = gdal.srsCache.stats()
+    assert.equal(stats.transformations.misses, 1)
+    assert.equal(stats.transformations.hits, 2)
+  })
+  it('should be emptied by clear()', () => {
+    gdal.SpatialReference.fromEPSG(3857)
+    gdal.srsCache.clear()
+    const stats = gdal.srsCache.stats()
+    assert.equal(stats.srs.size, 0)
+    assert.equal(stats.srs.misses, 0)
+  })
+  it('should be disabled by setMaxSize(0)', () => {
+    gdal.srsCache.setMaxSize(0)
+    gdal.SpatialReference.fromEPSG(3857)
+    gdal.SpatialReference.fromEPSG(3857)
+    const stats = gdal.srsCache.stats()
+    assert.equal(stats.srs.size, 0)
+    assert.equal(stats.srs.misses, 2)
+    assert.equal(stats.srs.maxSize, 0)
+    assert.equal(stats.transformations.maxSize, 0)
+  })
+  it('should evict the least recently used entries', () => {
+    gdal.srsCache.setMaxSize(2)
+    gdal.SpatialReference.fromEPSG(3857)
+    gdal.SpatialReference.fromEPSG(4326)
+    gdal.SpatialReference.fromEPSG(3857)
+    gdal.SpatialReference.fromEPSG(32632)
+    gdal.SpatialReference.fromEPSG(3857)
+    gdal.SpatialReference.fromEPSG(4326)
+    const stats = gdal.srsCache.stats()
+    assert.equal(stats.srs.size, 2)
+    assert.equal(stats.srs.hits, 2)
+    assert.equal(stats.srs.misses, 4)
+  })
+})
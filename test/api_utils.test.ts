@@ -0,0 +1,128 @@
+import * as gdal from '..'
+import * as path from 'path'
+import * as chai from 'chai'
+import * as chaiAsPromised from 'chai-as-promised'
+const assert = chai.assert
+chai.use(chaiAsPromised)
+
+describe('gdal_utils', () => {
+  afterEach(global.gc)
+
+  const sample = path.join(__dirname, 'data', 'sample.tif')
+
+  describe('translate()', () => {
+    it('should convert a raster with command-line arguments', () => {
+      const src = gdal.open(sample)
+      const out = gdal.translate('/vsimem/translate.tif', src, [ '-outsize', '50%', '50%' ])
+      assert.instanceOf(out, gdal.Dataset)
+      assert.deepEqual(out.rasterSize, { x: Math.round(src.rasterSize.x / 2), y: Math.round(src.rasterSize.y / 2) })
+      out.close()
+      src.close()
+      gdal.vsimem.release('/vsimem/translate.tif')
+    })
+    it('should call the progress callback', async () => {
+      const src = gdal.open(sample)
+      let calls = 0
+      const out = await gdal.translateAsync('', src, [ '-of', 'MEM' ], { progress_cb: () => { calls++ } })
+      assert.instanceOf(out, gdal.Dataset)
+      assert.isAbove(calls, 0)
+      out.close()
+      src.close()
+    })
+    it('should throw on invalid arguments', () => {
+      const src = gdal.open(sample)
+      assert.throws(() => gdal.translate('', src, [ '-invalid' ]))
+      assert.throws(() => gdal.translate('', src, '-of MEM' as unknown as string[]), /array/)
+      src.close()
+    })
+  })
+
+  describe('vectorTranslate()', () => {
+    it('should convert a vector dataset into a new dataset', async () => {
+      const src = gdal.open(path.join(__dirname, 'data', 'park.geo.json'))
+      const out = await gdal.vectorTranslateAsync('/vsimem/park.gpkg', src, [ '-f', 'GPKG', '-t_srs', 'EPSG:3857' ])
+      assert.equal(out.driver.description, 'GPKG')
+      assert.equal(out.layers.get(0).features.count(), 1)
+      assert.match(out.layers.get(0).srs.toProj4(), /merc/)
+      out.close()
+      src.close()
+      gdal.vsimem.release('/vsimem/park.gpkg')
+    })
+    it('should append to an existing dataset', () => {
+      const src = gdal.open(path.join(__dirname, 'data', 'park.geo.json'))
+      const dst = gdal.open('temp', 'w', 'Memory')
+      const out = gdal.vectorTranslate(dst, src, [ '-nln', 'parks' ])
+      assert.strictEqual(out, dst)
+      assert.equal(dst.layers.get('parks').features.count(), 1)
+      src.close()
+    })
+  })
+
+  describe('warp()', () => {
+    it('should reproject into a new dataset', async () => {
+      const src = gdal.open(sample)
+      const out = await gdal.warpAsync('', null, [ src ], [ '-of', 'MEM', '-t_srs', 'EPSG:4326', '-multi', '-wo', 'NUM_THREADS=2' ])
+      assert.instanceOf(out, gdal.Dataset)
+      assert.isTrue(out.srs.isSame(gdal.SpatialReference.fromEPSG(4326)))
+      out.close()
+      src.close()
+    })
+    it('should warp into an existing dataset', () => {
+      const src = gdal.open(sample)
+      const dst = gdal.open('temp', 'w', 'MEM', 100, 100, 1, src.bands.get(1).dataType)
+      dst.srs = src.srs
+      dst.geoTransform = src.geoTransform
+      const out = gdal.warp(null, dst, [ src ])
+      assert.strictEqual(out, dst)
+      src.close()
+    })
+    it('should throw without a destination', () => {
+      const src = gdal.open(sample)
+      assert.throws(() => gdal.warp(null, null, [ src ]), /destination/)
+      src.close()
+    })
+  })
+
+  describe('buildVRT()', () => {
+    it('should build a VRT from file names', () => {
+      const vrt = gdal.buildVRT('', [ sample ])
+      assert.equal(vrt.driver.description, 'VRT')
+      const src = gdal.open(sample)
+      assert.deepEqual(vrt.rasterSize, src.rasterSize)
+      vrt.close()
+      src.close()
+    })
+    it('should build a VRT from datasets', async () => {
+      const src = gdal.open(sample)
+      const vrt = await gdal.buildVRTAsync('', [ src ], [ '-resolution', 'highest' ])
+      assert.deepEqual(vrt.rasterSize, src.rasterSize)
+      vrt.close()
+      src.close()
+    })
+    it('should keep the source datasets alive', () => {
+      let src: gdal.Dataset | null = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+      src.bands.get(1).fill(42)
+      const vrt = gdal.buildVRT('', [ src ])
+      src = null
+      global.gc()
+      assert.equal(vrt.bands.get(1).pixels.get(8, 8), 42)
+      vrt.close()
+    })
+  })
+
+  describe('demProcessing()', () => {
+    it('should compute a hillshade', async () => {
+      const src = gdal.open(path.join(__dirname, 'data', 'dem_azimuth50_pa.img'))
+      const out = await gdal.demProcessingAsync('', src, 'hillshade', [ '-of', 'MEM', '-z', '2' ])
+      assert.deepEqual(out.rasterSize, src.rasterSize)
+      assert.equal(out.bands.get(1).dataType, gdal.GDT_Byte)
+      out.close()
+      src.close()
+    })
+    it('should require a color file for color-relief', () => {
+      const src = gdal.open(path.join(__dirname, 'data', 'dem_azimuth50_pa.img'))
+      assert.throws(() => gdal.demProcessing('', src, 'color-relief', [ '-of', 'MEM' ]), /colorFile/)
+      src.close()
+    })
+  })
+})
@@ -452,4 +452,55 @@ describe('gdal', () => {
       })
     })
   })
+
+  describe('renderTile()', () => {
+    const E = 20037508.342789244
+    let src
+    before(() => {
+      // covers exactly the tile 1/0/0
+      src = gdal.open('temp', 'w', 'MEM', 256, 256, 3, gdal.GDT_Byte)
+      src.srs = gdal.SpatialReference.fromEPSG(3857)
+      src.geoTransform = [ -E, E / 256, 0, E, 0, -E / 256 ]
+      for (let i = 1; i <= 3; i++) src.bands.get(i).fill(i * 50)
+    })
+    after(() => {
+      src.close()
+    })
+    it('should render a PNG tile with an alpha band', () => {
+      const png = gdal.renderTile(src, { z: 1, x: 0, y: 0 })
+      assert.instanceOf(png, Buffer)
+      const tile = gdal.open(png)
+      assert.equal(tile.driver.description, 'PNG')
+      assert.deepEqual(tile.rasterSize, { x: 256, y: 256 })
+      assert.equal(tile.bands.count(), 4)
+      assert.deepEqual(Array.from(tile.bands.get(2).pixels.read(100, 100, 1, 1)), [ 100 ])
+      assert.deepEqual(Array.from(tile.bands.get(4).pixels.read(100, 100, 1, 1)), [ 255 ])
+      tile.close()
+    })
+    it('should render transparent pixels outside of the dataset', () => {
+      const tile = gdal.open(gdal.renderTile(src, { z: 1, x: 1, y: 1, tileSize: 64 }))
+      assert.deepEqual(tile.rasterSize, { x: 64, y: 64 })
+      assert.deepEqual(Array.from(tile.bands.get(4).pixels.read(32, 32, 1, 1)), [ 0 ])
+      tile.close()
+    })
+    it('should select and scale the bands', () => {
+      const tile = gdal.open(gdal.renderTile(src, { z: 2, x: 1, y: 1, bands: [ 3 ], scale: [ 0, 150 ], format: 'jpeg' }))
+      assert.equal(tile.driver.description, 'JPEG')
+      assert.equal(tile.bands.count(), 1)
+      assert.closeTo(tile.bands.get(1).pixels.get(10, 10), 255, 2)
+      tile.close()
+    })
+    it('should apply a color table', () => {
+      const tile = gdal.open(gdal.renderTile(src, { z: 1, x: 0, y: 0, bands: [ 1 ], colorTable: [ [ 0, 0, 0 ], [ 255, 0, 0 ] ] }))
+      assert.equal(tile.bands.count(), 1)
+      assert.equal(tile.bands.get(1).colorInterpretation, gdal.GCI_PaletteIndex)
+      tile.close()
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => gdal.renderTile(src, { z: 1, x: 2, y: 0 }), /x and y/)
+      assert.throws(() => gdal.renderTile(src, { z: 1, x: 0, y: 0, format: 'gif' }), /format/)
+      assert.throws(() => gdal.renderTile(src, { z: 1, x: 0, y: 0, bands: [ 4 ] }), /band/)
+      assert.throws(() => gdal.renderTile(src, { z: 1, x: 0, y: 0, resampling: 'Best' }), /resampling/)
+    })
+  })
 })
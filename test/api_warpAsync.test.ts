@@ -440,4 +440,29 @@ describe('gdal', () => {
       })
     })
   })
+
+  describe('renderTileAsync()', () => {
+    const E = 20037508.342789244
+    let src
+    before(() => {
+      // covers exactly the tile 1/0/0
+      src = gdal.open('temp', 'w', 'MEM', 256, 256, 3, gdal.GDT_Byte)
+      src.srs = gdal.SpatialReference.fromEPSG(3857)
+      src.geoTransform = [ -E, E / 256, 0, E, 0, -E / 256 ]
+      for (let i = 1; i <= 3; i++) src.bands.get(i).fill(i * 50)
+    })
+    after(() => {
+      src.close()
+    })
+    it('should render a PNG tile', async () => {
+      const png = await gdal.renderTileAsync(src, { z: 1, x: 0, y: 0, resampling: gdal.GRA_Bilinear })
+      const tile = gdal.open(png)
+      assert.equal(tile.bands.count(), 4)
+      assert.deepEqual(Array.from(tile.bands.get(3).pixels.read(100, 100, 1, 1)), [ 150 ])
+      tile.close()
+    })
+    it('should reject on invalid arguments', () =>
+      assert.isRejected(gdal.renderTileAsync(src, { z: -1, x: 0, y: 0 }), /z must be/)
+    )
+  })
 })
@@ -130,4 +130,40 @@ describe('Open', () => {
       })
     })
   })
+  describe('vsimem/take', () => {
+    it('should retrieve and delete a file created by GDAL', () => {
+      const src = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+      gdal.drivers.get('PNG').createCopy('/vsimem/take.png', src).close()
+      src.close()
+      const buffer = gdal.vsimem.take('/vsimem/take.png')
+      assert.instanceOf(buffer, Buffer)
+      assert.deepEqual(Array.from(buffer.subarray(1, 4)), [ 0x50, 0x4e, 0x47 ])
+      assert.throws(() => gdal.vsimem.take('/vsimem/take.png'), /No such file/)
+      const ds = gdal.open(buffer)
+      assert.equal(ds.driver.description, 'PNG')
+      ds.close()
+    })
+    it('should return the original Buffer of a file created by vsimem.set', () => {
+      const buffer_in = fs.readFileSync(path.join(__dirname, 'data/park.geo.json'))
+      gdal.vsimem.set(buffer_in, '/vsimem/take.geo.json')
+      assert.strictEqual(gdal.vsimem.take('/vsimem/take.geo.json'), buffer_in)
+    })
+  })
+
+  describe('vsimem/read', () => {
+    it('should return a copy without deleting the file', () => {
+      const buffer_in = fs.readFileSync(path.join(__dirname, 'data/park.geo.json'))
+      gdal.vsimem.set(buffer_in, '/vsimem/read.geo.json')
+      const copy = gdal.vsimem.read('/vsimem/read.geo.json')
+      assert.notStrictEqual(copy, buffer_in)
+      assert.isTrue(copy.equals(buffer_in))
+      const ds = gdal.open('/vsimem/read.geo.json')
+      assert.equal(ds.layers.count(), 1)
+      ds.close()
+      assert.strictEqual(gdal.vsimem.release('/vsimem/read.geo.json'), buffer_in)
+    })
+    it('should throw if the file does not exist', () => {
+      assert.throws(() => gdal.vsimem.read('/vsimem/nonexistent'), /No such file/)
+    })
+  })
 })
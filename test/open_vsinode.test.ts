@@ -0,0 +1,134 @@
+import * as gdal from '..'
+import * as path from 'path'
+import * as fs from 'fs'
+import * as chai from 'chai'
+import * as chaiAsPromised from 'chai-as-promised'
+const assert = chai.assert
+chai.use(chaiAsPromised)
+
+describe('Open', () => {
+  afterEach(global.gc)
+
+  describe('vsinode', () => {
+    const root = path.join(__dirname, 'data')
+    const reads: { path: string, offset: number, length: number }[] = []
+    let inflight = 0, maxInflight = 0
+    let reentrant: gdal.Dataset | null = null
+    let reentrantError: Error | null = null
+
+    before(() => {
+      gdal.vsinode.register('test', {
+        stat: (file: string) => fs.promises.stat(path.join(root, file)).then((s) => ({ size: s.size }), () => null),
+        read: async (file: string, offset: number, length: number) => {
+          reads.push({ path: file, offset, length })
+          maxInflight = Math.max(maxInflight, ++inflight)
+          const fd = await fs.promises.open(path.join(root, file), 'r')
+          try {
+            const r = await fd.read(Buffer.alloc(length), 0, length, offset)
+            return r.buffer.subarray(0, r.bytesRead)
+          } finally {
+            inflight--
+            await fd.close()
+          }
+        }
+      })
+      gdal.vsinode.register('reentrant', {
+        stat: (file: string) => fs.promises.stat(path.join(root, file)).then((s) => ({ size: s.size }), () => null),
+        read: (file: string, offset: number, length: number) => {
+          if (reentrant) {
+            try {
+              reentrant.bands.get(1).pixels.get(0, 0)
+            } catch (e) {
+              reentrantError = e
+            }
+          }
+          return fs.promises.readFile(path.join(root, file)).then((data) => data.subarray(offset, offset + length))
+        }
+      })
+      gdal.vsinode.register('failing', {
+        stat: () => Promise.resolve({ size: 1024 }),
+        read: () => Promise.reject(new Error('backend error'))
+      })
+    })
+    after(() => {
+      gdal.vsinode.unregister('test')
+      gdal.vsinode.unregister('failing')
+      gdal.vsinode.unregister('reentrant')
+    })
+
+    it('should open a raster dataset with openAsync()', async () => {
+      const ds = await gdal.openAsync('/vsinode/test/sample.tif')
+      const expected = gdal.open(path.join(root, 'sample.tif'))
+      assert.deepEqual(ds.rasterSize, expected.rasterSize)
+      const band = await ds.bands.getAsync(1)
+      const data = await band.pixels.readAsync(0, 0, 64, 64)
+      assert.deepEqual(data, expected.bands.get(1).pixels.read(0, 0, 64, 64))
+      assert.isAbove(reads.length, 0)
+      ds.close()
+      expected.close()
+    })
+
+    it('should open a vector dataset with openAsync()', async () => {
+      const ds = await gdal.openAsync('/vsinode/test/park.geo.json')
+      const layer = await ds.layers.getAsync(0)
+      assert.equal(await layer.features.countAsync(), 1)
+      ds.close()
+    })
+
+    it('should read several blocks with a single multi-range request', async () => {
+      const name = `vsinode_tiled_${String(Math.random()).substring(2)}.tif`
+      const file = path.join(root, 'temp', name)
+      gdal.translate(file, gdal.open(path.join(root, 'sample.tif')), [
+        '-b', '1', '-co', 'TILED=YES', '-co', 'BLOCKXSIZE=16', '-co', 'BLOCKYSIZE=16'
+      ]).close()
+      try {
+        const ds = await gdal.openAsync(`/vsinode/test/temp/${name}`)
+        const expected = gdal.open(file)
+        maxInflight = 0
+        // 2x2 blocks, the two rows of blocks are not contiguous in the file
+        const data = await ds.bands.get(1).pixels.readAsync(0, 0, 32, 32)
+        assert.deepEqual(data, expected.bands.get(1).pixels.read(0, 0, 32, 32))
+        assert.isAbove(maxInflight, 1)
+        ds.close()
+        expected.close()
+      } finally {
+        fs.unlinkSync(file)
+      }
+    })
+
+    it('should throw instead of deadlocking on a synchronous call from a callback', async () => {
+      const ds = await gdal.openAsync('/vsinode/reentrant/sample.tif')
+      reentrant = ds
+      reentrantError = null
+      try {
+        const band = await ds.bands.getAsync(1)
+        await band.pixels.readAsync(0, 0, 64, 64)
+        assert.match(reentrantError ? reentrantError.message : '', /would deadlock/)
+      } finally {
+        reentrant = null
+        ds.close()
+      }
+    })
+
+    it('should reject when the file does not exist', () =>
+      assert.isRejected(gdal.openAsync('/vsinode/test/nonexistent.tif'))
+    )
+
+    it('should reject when the read callback rejects', () =>
+      assert.isRejected(gdal.openAsync('/vsinode/failing/file.tif'))
+    )
+
+    it('should throw when accessed synchronously', () => {
+      assert.throws(() => gdal.open('/vsinode/test/sample.tif'))
+    })
+
+    it('should throw when registering the same name twice', () => {
+      assert.throws(() => gdal.vsinode.register('test', { stat: () => null, read: () => null }),
+        /already registered/)
+    })
+
+    it('should throw when unregistering an unknown name', () => {
+      assert.throws(() => gdal.vsinode.unregister('unknown'))
+    })
+  })
+})
@@ -0,0 +1,107 @@
+import * as gdal from '..'
+import * as path from 'path'
+import * as chai from 'chai'
+import * as chaiAsPromised from 'chai-as-promised'
+const assert = chai.assert
+chai.use(chaiAsPromised)
+
+describe('Open', () => {
+  afterEach(global.gc)
+
+  describe('vsistats', () => {
+    const file = path.join(__dirname, 'data', 'sample.tif')
+
+    beforeEach(() => {
+      gdal.vsistats.reset()
+    })
+
+    it('should count the reads of a dataset', () => {
+      const ds = gdal.open(`/vsistats/${file}`)
+      ds.bands.get(1).pixels.read(0, 0, ds.rasterSize.x, ds.rasterSize.y)
+      const stats = ds.ioStats()
+      assert.isAtLeast(stats.opens, 1)
+      assert.isAbove(stats.reads, 0)
+      assert.isAbove(stats.bytesRead, 0)
+      assert.isAtLeast(stats.reads, stats.ranges)
+      assert.isAbove(stats.ranges, 0)
+      assert.equal(stats.writes, 0)
+      ds.close()
+    })
+
+    it('should count the reads of an async operation', () =>
+      gdal.openAsync(`/vsistats/${file}`)
+        .then((ds) => ds.bands.get(1).pixels.readAsync(0, 0, 10, 10).then(() => ds))
+        .then((ds) => {
+          assert.isAbove(ds.ioStats().bytesRead, 0)
+          ds.close()
+        })
+    )
+
+    it('should aggregate the counters by prefix', () => {
+      const ds = gdal.open(`/vsistats/${file}`)
+      ds.bands.get(1).pixels.read(0, 0, 10, 10)
+      const stats = ds.ioStats()
+      const byDir = gdal.vsistats.get(path.join(__dirname, 'data'))
+      assert.isAtLeast(byDir.bytesRead, stats.bytesRead)
+      assert.deepEqual(gdal.vsistats.get(`/vsistats/${file}`), gdal.vsistats.get(file))
+      assert.equal(gdal.vsistats.get('/nonexistent/').reads, 0)
+      ds.close()
+    })
+
+    it('should count the writes', () => {
+      const filename = `/vsistats//vsimem/vsistats_${String(Math.random()).substring(2)}.tif`
+      const ds = gdal.open(filename, 'w', 'GTiff', 16, 16, 1, gdal.GDT_Byte)
+      ds.bands.get(1).fill(1)
+      ds.close()
+      const stats = gdal.vsistats.get(filename)
+      assert.isAbove(stats.writes, 0)
+      assert.isAbove(stats.bytesWritten, 16 * 16)
+      gdal.vsimem.take(filename.substring('/vsistats/'.length))
+    })
+
+    it('should reset the counters', () => {
+      const ds = gdal.open(`/vsistats/${file}`)
+      ds.bands.get(1).pixels.read(0, 0, 10, 10)
+      assert.isAbove(ds.ioStats().reads, 0)
+      gdal.vsistats.reset(file)
+      assert.deepEqual(ds.ioStats(), {
+        opens: 0,
+        reads: 0,
+        bytesRead: 0,
+        writes: 0,
+        bytesWritten: 0,
+        seeks: 0,
+        ranges: 0
+      })
+      ds.close()
+    })
+
+    it('should include the side-car files of a dataset', () => {
+      const shp = path.join(__dirname, 'data', 'shp', 'sample.shp')
+      const ds = gdal.open(`/vsistats/${shp}`)
+      ds.layers.get(0).features.first().fields.toObject()
+      const stats = ds.ioStats()
+      assert.isAbove(stats.opens, gdal.vsistats.get(shp).opens)
+      assert.deepEqual(stats, gdal.vsistats.get(path.join(__dirname, 'data', 'shp', 'sample.')))
+      ds.close()
+    })
+
+    it('should not wait for an async operation on the dataset', () => {
+      const ds = gdal.open(`/vsistats/${file}`)
+      const q = ds.bands.get(1).pixels.readAsync(0, 0, ds.rasterSize.x, ds.rasterSize.y)
+      assert.isObject(ds.ioStats())
+      return assert.isFulfilled(q.then(() => ds.close()))
+    })
+
+    it('should ignore the files not opened through /vsistats/', () => {
+      const ds = gdal.open(file)
+      ds.bands.get(1).pixels.read(0, 0, 10, 10)
+      assert.equal(ds.ioStats().reads, 0)
+      ds.close()
+    })
+
+    it('should throw on an invalid prefix', () => {
+      assert.throws(() => gdal.vsistats.get(42 as unknown as string), /must be a string/)
+    })
+  })
+})
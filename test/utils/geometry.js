@@ -0,0 +1,7 @@
+const gdal = require('../../lib/gdal.js')
+
+// An axis-aligned square polygon with its lower left corner at (x, y)
+module.exports.square = function (x, y, size) {
+  return gdal.Geometry.fromWKT(
+    `POLYGON ((${x} ${y}, ${x + size} ${y}, ${x + size} ${y + size}, ${x} ${y + size}, ${x} ${y}))`)
+}